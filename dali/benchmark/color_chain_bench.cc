@@ -0,0 +1,115 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/pipeline/pipeline.h"
+
+namespace dali {
+
+/**
+ * @brief Runs Brightness, Contrast, Hue and Saturation on a batch
+ * of 1080p images on the cpu.
+ *
+ * @param st range(0) is 1 to keep the intermediate images as outputs
+ * of the pipeline, which stops the ops from running in place, range(1)
+ * the batch size and range(2) the number of threads
+ */
+void ColorChainBench(benchmark::State& st) {//NOLINT
+  const bool keep_intermediates = st.range(0);
+  const int batch_size = st.range(1);
+  const int num_thread = st.range(2);
+  const Index H = 1080, W = 1920, C = 3;
+
+  Pipeline pipe(
+      batch_size,
+      num_thread,
+      CPU_ONLY_DEVICE_ID, -1,
+      false,  // pipelined
+      2,      // pipe length
+      false);  // async
+
+  TensorList<CPUBackend> data;
+  data.set_pinned(false);
+  data.set_type(TypeInfo::Create<uint8>());
+  data.Resize(vector<Dims>(batch_size, {H, W, C}));
+  std::mt19937 rand_gen(0);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (int i = 0; i < batch_size; ++i) {
+    uint8 *img = data.mutable_tensor<uint8>(i);
+    for (Index k = 0; k < H * W * C; ++k) {
+      img[k] = dist(rand_gen);
+    }
+  }
+  pipe.AddExternalInput("images");
+
+  const vector<std::pair<string, string>> ops = {
+    {"Brightness", "brightness"},
+    {"Contrast", "contrast"},
+    {"Hue", "hue"},
+    {"Saturation", "saturation"}};
+  string input = "images";
+  vector<std::pair<string, string>> outputs;
+  for (auto &op : ops) {
+    const string output = op.second + "_out";
+    pipe.AddOperator(
+        OpSpec(op.first)
+        .AddArg("device", "cpu")
+        .AddArg(op.second, op.first == "Hue" ? 10.f : 1.2f)
+        .AddInput(input, "cpu")
+        .AddOutput(output, "cpu"));
+    if (keep_intermediates || output == "saturation_out") {
+      outputs.emplace_back(output, "cpu");
+    }
+    input = output;
+  }
+  pipe.Build(outputs);
+
+  // Run once to allocate the memory
+  DeviceWorkspace ws;
+  pipe.SetExternalInput("images", data);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  pipe.Outputs(&ws);
+
+  while (st.KeepRunning()) {
+    pipe.SetExternalInput("images", data);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+  }
+
+  st.counters["FPS"] = benchmark::Counter(batch_size*st.iterations(),
+      benchmark::Counter::kIsRate);
+}
+
+static void ColorChainArgs(benchmark::internal::Benchmark *b) {
+  for (int keep_intermediates : {0, 1}) {
+    for (int num_thread = 1; num_thread <= 8; num_thread *= 2) {
+      b->Args({keep_intermediates, 16, num_thread});
+    }
+  }
+}
+
+BENCHMARK(ColorChainBench)->Iterations(50)
+->Unit(benchmark::kMillisecond)
+->UseRealTime()
+->Apply(ColorChainArgs);
+
+}  // namespace dali
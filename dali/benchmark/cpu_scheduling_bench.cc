@@ -0,0 +1,132 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+#include "dali/benchmark/dali_bench.h"
+#include "dali/pipeline/pipeline.h"
+#include "dali/util/image.h"
+
+namespace dali {
+
+class CPUSchedulingBench : public DALIBenchmark {
+ public:
+  // Batch of mostly the smallest image with one in `large_every`
+  // samples being the largest one, at random positions
+  inline void MakeSkewedJPEGBatch(TensorList<CPUBackend> *tl, int n, int large_every) {
+    const auto nImgs = jpegs_.nImages();
+    DALI_ENFORCE(nImgs > 0, "jpegs must be loaded to create batches");
+    vector<int> by_size(nImgs);
+    std::iota(by_size.begin(), by_size.end(), 0);
+    std::sort(by_size.begin(), by_size.end(), [this](int a, int b) {
+        return jpegs_.sizes_[a] < jpegs_.sizes_[b];
+      });
+
+    vector<int> img_idx(n, by_size.front());
+    for (int i = 0; i < n; i += large_every) {
+      img_idx[i] = by_size.back();
+    }
+    std::shuffle(img_idx.begin(), img_idx.end(), rand_gen_);
+
+    vector<Dims> shape(n);
+    for (int i = 0; i < n; ++i) {
+      shape[i] = {jpegs_.sizes_[img_idx[i]]};
+    }
+    tl->template mutable_data<uint8>();
+    tl->Resize(shape);
+    for (int i = 0; i < n; ++i) {
+      std::memcpy(tl->template mutable_tensor<uint8>(i),
+          jpegs_.data_[img_idx[i]], jpegs_.sizes_[img_idx[i]]);
+    }
+  }
+};
+
+inline double Percentile(vector<double> times, double p) {
+  std::sort(times.begin(), times.end());
+  return times[std::min<size_t>(times.size() - 1, p * times.size())];
+}
+
+BENCHMARK_DEFINE_F(CPUSchedulingBench, SkewedHostDecoder)(benchmark::State& st) { // NOLINT
+  CPUSchedulingPolicy policy = static_cast<CPUSchedulingPolicy>(st.range(0));
+  int batch_size = st.range(1);
+  int num_thread = st.range(2);
+
+  // Not pipelined, so RunCPU only times the cpu stage
+  Pipeline pipe(
+      batch_size,
+      num_thread,
+      0, -1,
+      false,  // pipelined
+      2,      // pipe length
+      false);  // async
+  pipe.SetCPUSchedulingPolicy(policy);
+
+  TensorList<CPUBackend> data;
+  this->MakeSkewedJPEGBatch(&data, batch_size, 16);
+  pipe.AddExternalInput("raw_jpegs");
+
+  pipe.AddOperator(
+      OpSpec("HostDecoder")
+      .AddArg("device", "cpu")
+      .AddArg("output_type", DALI_RGB)
+      .AddInput("raw_jpegs", "cpu")
+      .AddOutput("images", "cpu"));
+
+  vector<std::pair<string, string>> outputs = {{"images", "cpu"}};
+  pipe.Build(outputs);
+
+  // Run once to allocate the memory
+  DeviceWorkspace ws;
+  pipe.SetExternalInput("raw_jpegs", data);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  pipe.Outputs(&ws);
+
+  vector<double> times;
+  while (st.KeepRunning()) {
+    pipe.SetExternalInput("raw_jpegs", data);
+    auto start = std::chrono::steady_clock::now();
+    pipe.RunCPU();
+    std::chrono::duration<double, std::milli> time =
+        std::chrono::steady_clock::now() - start;
+    times.push_back(time.count());
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+  }
+
+  st.counters["p50_ms"] = Percentile(times, 0.5);
+  st.counters["p99_ms"] = Percentile(times, 0.99);
+  st.counters["FPS"] = benchmark::Counter(batch_size*st.iterations(),
+      benchmark::Counter::kIsRate);
+}
+
+static void SchedulingArgs(benchmark::internal::Benchmark *b) {
+  for (int policy : {DALI_CPU_SCHEDULE_IN_ORDER, DALI_CPU_SCHEDULE_LONGEST_FIRST}) {
+    for (int num_thread = 2; num_thread <= 8; num_thread *= 2) {
+      b->Args({policy, 64, num_thread});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(CPUSchedulingBench, SkewedHostDecoder)->Iterations(100)
+->Unit(benchmark::kMillisecond)
+->UseRealTime()
+->Apply(SchedulingArgs);
+
+}  // namespace dali
@@ -0,0 +1,112 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/pipeline/pipeline.h"
+
+namespace dali {
+
+/**
+ * @brief Runs a chain of Copy ops on a batch of tiny samples on the
+ * cpu, so that the time is spent in the executor and the workspaces
+ * rather than in the ops.
+ *
+ * @param st range(0) is the number of ops of the chain, range(1) the
+ * batch size and range(2) the number of threads
+ */
+void ExecutorOverheadBench(benchmark::State& st) {//NOLINT
+  const int num_op = st.range(0);
+  const int batch_size = st.range(1);
+  const int num_thread = st.range(2);
+
+  Pipeline pipe(
+      batch_size,
+      num_thread,
+      CPU_ONLY_DEVICE_ID, -1,
+      false,  // pipelined
+      2,      // pipe length
+      false);  // async
+
+  TensorList<CPUBackend> data;
+  data.set_pinned(false);
+  data.set_type(TypeInfo::Create<uint8>());
+  data.Resize(vector<Dims>(batch_size, {2, 2, 3}));
+  for (int i = 0; i < batch_size; ++i) {
+    uint8 *sample = data.mutable_tensor<uint8>(i);
+    for (int k = 0; k < 12; ++k) {
+      sample[k] = k;
+    }
+  }
+  pipe.AddExternalInput("data");
+
+  string input = "data";
+  for (int i = 0; i < num_op; ++i) {
+    const string output = "copy" + std::to_string(i);
+    pipe.AddOperator(
+        OpSpec("Copy")
+        .AddArg("device", "cpu")
+        .AddInput(input, "cpu")
+        .AddOutput(output, "cpu"));
+    input = output;
+  }
+  vector<std::pair<string, string>> outputs = {{input, "cpu"}};
+  pipe.Build(outputs);
+
+  // Run once to allocate the memory
+  DeviceWorkspace ws;
+  pipe.SetExternalInput("data", data);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  pipe.Outputs(&ws);
+
+  double total_us = 0;
+  while (st.KeepRunning()) {
+    pipe.SetExternalInput("data", data);
+    auto start = std::chrono::steady_clock::now();
+    pipe.RunCPU();
+    std::chrono::duration<double, std::micro> time =
+        std::chrono::steady_clock::now() - start;
+    total_us += time.count();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+  }
+
+  // Time the executor spends on one sample of one op
+  st.counters["us_per_sample"] = total_us / (st.iterations() * batch_size * num_op);
+  st.counters["FPS"] = benchmark::Counter(batch_size*st.iterations(),
+      benchmark::Counter::kIsRate);
+}
+
+static void ExecutorOverheadArgs(benchmark::internal::Benchmark *b) {
+  for (int num_op : {1, 8}) {
+    for (int batch_size : {32, 256}) {
+      for (int num_thread : {1, 4}) {
+        b->Args({num_op, batch_size, num_thread});
+      }
+    }
+  }
+}
+
+BENCHMARK(ExecutorOverheadBench)->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ExecutorOverheadArgs);
+
+}  // namespace dali
@@ -0,0 +1,132 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/pipeline/pipeline.h"
+
+namespace dali {
+
+/**
+ * @brief A directory of generated files, laid out as FileReader expects
+ * it: one subdirectory per class. The directory is in
+ * DALI_BENCHMARK_FILE_READER_ROOT when it is set, e.g. to test a network
+ * filesystem, and in /tmp otherwise.
+ */
+class GeneratedFiles {
+ public:
+  GeneratedFiles(int num_classes, int files_per_class, int file_bytes) {
+    const char *dir = std::getenv("DALI_BENCHMARK_FILE_READER_ROOT");
+    root_ = string(dir ? dir : "/tmp") + "/dali_file_reader_bench_XXXXXX";
+    DALI_ENFORCE(mkdtemp(&root_[0]) != nullptr, "Could not create " + root_);
+    const string data(file_bytes, 'x');
+    for (int label = 0; label < num_classes; ++label) {
+      dirs_.push_back(root_ + "/" + std::to_string(label));
+      DALI_ENFORCE(mkdir(dirs_.back().c_str(), 0700) == 0, "Could not create " + dirs_.back());
+      for (int i = 0; i < files_per_class; ++i) {
+        files_.push_back(dirs_.back() + "/" + std::to_string(i) + ".jpg");
+        std::ofstream(files_.back(), std::ios::binary) << data;
+      }
+    }
+  }
+
+  ~GeneratedFiles() {
+    for (auto &file : files_) std::remove(file.c_str());
+    for (auto &dir : dirs_) rmdir(dir.c_str());
+    rmdir(root_.c_str());
+  }
+
+  const string &root() const { return root_; }
+
+ private:
+  string root_;
+  vector<string> dirs_, files_;
+};
+
+/**
+ * @brief Reads the generated files with FileReader on the cpu, without
+ * decoding them, so that the time is spent reading the files.
+ *
+ * @param st range(0) is the number of reads in flight, range(1) the
+ * size of the files in KB and range(2) the batch size
+ */
+void FileReaderBench(benchmark::State& st) {//NOLINT
+  const int reads_in_flight = st.range(0);
+  const int file_bytes = st.range(1) << 10;
+  const int batch_size = st.range(2);
+
+  GeneratedFiles files(8, 128, file_bytes);
+
+  Pipeline pipe(
+      batch_size,
+      1,
+      CPU_ONLY_DEVICE_ID, -1,
+      false,  // pipelined
+      2,      // pipe length
+      false);  // async
+
+  pipe.AddOperator(
+      OpSpec("FileReader")
+      .AddArg("device", "cpu")
+      .AddArg("file_root", files.root())
+      .AddArg("random_shuffle", true)
+      .AddArg("initial_fill", batch_size)
+      .AddArg("reads_in_flight", reads_in_flight)
+      .AddOutput("raw", "cpu")
+      .AddOutput("labels", "cpu"));
+  vector<std::pair<string, string>> outputs = {{"raw", "cpu"}};
+  pipe.Build(outputs);
+
+  // Run once to fill the buffers of the reader
+  DeviceWorkspace ws;
+  pipe.RunCPU();
+  pipe.RunGPU();
+  pipe.Outputs(&ws);
+
+  while (st.KeepRunning()) {
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+  }
+
+  st.counters["FPS"] = benchmark::Counter(batch_size*st.iterations(),
+      benchmark::Counter::kIsRate);
+  st.counters["MB/s"] = benchmark::Counter(
+      static_cast<double>(batch_size) * st.iterations() * file_bytes / (1 << 20),
+      benchmark::Counter::kIsRate);
+}
+
+static void FileReaderArgs(benchmark::internal::Benchmark *b) {
+  for (int reads_in_flight : {1, 4, 16}) {
+    for (int file_kb : {16, 128}) {
+      b->Args({reads_in_flight, file_kb, 32});
+    }
+  }
+}
+
+BENCHMARK(FileReaderBench)->Iterations(100)
+->Unit(benchmark::kMillisecond)
+->UseRealTime()
+->Apply(FileReaderArgs);
+
+}  // namespace dali
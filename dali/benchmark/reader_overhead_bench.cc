@@ -0,0 +1,121 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/pipeline/pipeline.h"
+#include "dali/pipeline/operators/reader/reader_op.h"
+
+namespace dali {
+
+// Reads tiny samples without touching any file
+class NoOpBenchLoader : public Loader<CPUBackend> {
+ public:
+  explicit NoOpBenchLoader(const OpSpec& spec) :
+    Loader<CPUBackend>(spec) {}
+
+  void ReadSample(Tensor<CPUBackend> *t) override {
+    t->Resize({1});
+    t->mutable_data<uint8>()[0] = 0;
+  }
+
+  Index Size() override {
+    return 1 << 20;
+  }
+};
+
+// Outputs the samples as they are, i.e. without parsing them
+class NoOpBenchReader : public DataReader<CPUBackend> {
+ public:
+  explicit NoOpBenchReader(const OpSpec &spec)
+      : DataReader<CPUBackend>(spec) {
+    loader_.reset(new NoOpBenchLoader(spec));
+  }
+
+  DEFAULT_READER_DESTRUCTOR(NoOpBenchReader, CPUBackend);
+
+  void RunImpl(SampleWorkspace* ws, int idx) override {
+    ws->Output<CPUBackend>(0)->Copy(*GetSample(ws->data_idx()), 0);
+  }
+};
+
+DALI_REGISTER_OPERATOR(NoOpBenchReader, NoOpBenchReader, CPU);
+
+DALI_SCHEMA(NoOpBenchReader)
+  .DocStr("Reader of tiny samples for the benchmarks")
+  .NumInput(0)
+  .NumOutput(1)
+  .AddParent("LoaderBase");
+
+/**
+ * @brief Runs a reader whose samples need no parsing, so that the time
+ * is spent handing the samples from the prefetch thread to the workers.
+ * The samples per second should scale with the number of threads.
+ *
+ * @param st range(0) is the batch size and range(1) the number of threads
+ */
+void ReaderOverheadBench(benchmark::State& st) {//NOLINT
+  const int batch_size = st.range(0);
+  const int num_thread = st.range(1);
+
+  Pipeline pipe(
+      batch_size,
+      num_thread,
+      CPU_ONLY_DEVICE_ID, -1,
+      false,  // pipelined
+      2,      // pipe length
+      false);  // async
+
+  pipe.AddOperator(
+      OpSpec("NoOpBenchReader")
+      .AddArg("device", "cpu")
+      .AddArg("prefetch_queue_depth", 2)
+      .AddOutput("data", "cpu"));
+  vector<std::pair<string, string>> outputs = {{"data", "cpu"}};
+  pipe.Build(outputs);
+
+  // Run once to fill the buffers of the reader
+  DeviceWorkspace ws;
+  pipe.RunCPU();
+  pipe.RunGPU();
+  pipe.Outputs(&ws);
+
+  while (st.KeepRunning()) {
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+  }
+
+  st.counters["FPS"] = benchmark::Counter(batch_size*st.iterations(),
+      benchmark::Counter::kIsRate);
+}
+
+static void ReaderOverheadArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size : {32, 256}) {
+    for (int num_thread : {1, 2, 4, 8}) {
+      b->Args({batch_size, num_thread});
+    }
+  }
+}
+
+BENCHMARK(ReaderOverheadBench)->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ReaderOverheadArgs);
+
+}  // namespace dali
@@ -0,0 +1,83 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "dali/pipeline/util/thread_pool.h"
+#include "dali/pipeline/util/work_stealing_thread_pool.h"
+
+namespace dali {
+
+namespace {
+
+// Mimics the cost of a cheap per-sample CPU op (e.g. BbFlip, ColorTwist
+// on a small image) so that the pool overhead dominates
+inline void SmallWork(float *out, int iters) {
+  float acc = *out;
+  for (int i = 0; i < iters; ++i) {
+    acc = acc * 0.999f + 1.f;
+  }
+  *out = acc;
+}
+
+}  // namespace
+
+/**
+ * @brief Issues one "batch" of small work items per iteration and waits
+ * for it, the same way Executor::RunCPU uses its thread pool.
+ *
+ * @tparam Pool ThreadPool or WorkStealingThreadPool
+ * @param st range(0) is the number of threads, range(1) the batch size
+ */
+template <typename Pool>
+void ThreadPoolBench(benchmark::State& st) {//NOLINT
+  const int num_thread = st.range(0);
+  const int batch_size = st.range(1);
+  const int work_iters = 2000;
+  Pool pool(num_thread, 0, false);
+  std::vector<float> results(batch_size, 0.f);
+
+  for (auto _ : st) {
+    for (int i = 0; i < batch_size; ++i) {
+      pool.DoWorkWithID([&results, i, work_iters] (int) {
+          SmallWork(&results[i], work_iters);
+        });
+    }
+    pool.WaitForWork();
+  }
+  benchmark::DoNotOptimize(results.data());
+  st.SetItemsProcessed(st.iterations() * batch_size);
+}
+
+static void PoolArgs(benchmark::internal::Benchmark *b) {
+  for (int num_thread = 1; num_thread <= 64; num_thread *= 2) {
+    for (int batch_size : {32, 256}) {
+      b->Args({num_thread, batch_size});
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(ThreadPoolBench, ThreadPool)
+->Apply(PoolArgs)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime();
+
+BENCHMARK_TEMPLATE(ThreadPoolBench, WorkStealingThreadPool)
+->Apply(PoolArgs)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime();
+
+}  // namespace dali
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -100,6 +101,91 @@ void daliCopyTensorNTo(daliPipelineHandle* pipe_handle, void* dst, int n) {
   }
 }
 
+namespace {
+
+daliTimingStatistics ToCTimingStatistics(const dali::TimingStatistics &stats) {
+  daliTimingStatistics c_stats;
+  c_stats.count = stats.count;
+  c_stats.total_us = stats.total_us;
+  c_stats.p50_us = stats.p50_us;
+  c_stats.p90_us = stats.p90_us;
+  c_stats.p99_us = stats.p99_us;
+  c_stats.max_us = stats.max_us;
+  return c_stats;
+}
+
+char* CopyString(const std::string &str) {
+  char* c_str = new char[str.size() + 1];
+  memcpy(c_str, str.c_str(), str.size() + 1);
+  return c_str;
+}
+
+}  // namespace
+
+void daliEnableStatistics(daliPipelineHandle* pipe_handle, int enable) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  pipeline->EnableStatistics(enable != 0);
+}
+
+daliStatistics* daliGetStatistics(daliPipelineHandle* pipe_handle) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  dali::ExecutorStatistics stats = pipeline->GetStatistics();
+  daliStatistics* c_stats = new daliStatistics;
+  c_stats->iterations = stats.iterations;
+  c_stats->num_ops = stats.ops.size();
+  c_stats->ops = new daliOpStatistics[stats.ops.size()];
+  for (size_t i = 0; i < stats.ops.size(); ++i) {
+    daliOpStatistics &c_op = c_stats->ops[i];
+    c_op.name = CopyString(stats.ops[i].name);
+    c_op.device = CopyString(stats.ops[i].device);
+    c_op.run_time = ToCTimingStatistics(stats.ops[i].run_time);
+    c_op.bytes_produced = stats.ops[i].bytes_produced;
+    c_op.prefetch_wait = ToCTimingStatistics(stats.ops[i].prefetch_wait);
+  }
+  c_stats->free_queue_wait = ToCTimingStatistics(stats.free_queue_wait);
+  c_stats->ready_queue_wait = ToCTimingStatistics(stats.ready_queue_wait);
+  c_stats->planned_peak_bytes = stats.planned_peak_bytes;
+  c_stats->allocated_bytes = stats.allocated_bytes;
+  c_stats->max_sample_bytes = stats.max_sample_bytes;
+  return c_stats;
+}
+
+void daliDeleteStatistics(daliStatistics* stats) {
+  if (stats == nullptr) return;
+  for (int i = 0; i < stats->num_ops; ++i) {
+    delete[] stats->ops[i].name;
+    delete[] stats->ops[i].device;
+  }
+  delete[] stats->ops;
+  delete stats;
+}
+
+daliMemoryReport* daliGetMemoryReport(daliPipelineHandle* pipe_handle) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  std::vector<dali::MemoryUsage> usages = pipeline->GetMemoryReport();
+  daliMemoryReport* report = new daliMemoryReport;
+  report->num_tags = usages.size();
+  report->tags = new daliMemoryUsage[usages.size()];
+  for (size_t i = 0; i < usages.size(); ++i) {
+    daliMemoryUsage &c_usage = report->tags[i];
+    c_usage.tag = CopyString(usages[i].tag);
+    c_usage.host_bytes = usages[i].host_bytes;
+    c_usage.host_peak_bytes = usages[i].host_peak_bytes;
+    c_usage.gpu_bytes = usages[i].gpu_bytes;
+    c_usage.gpu_peak_bytes = usages[i].gpu_peak_bytes;
+  }
+  return report;
+}
+
+void daliDeleteMemoryReport(daliMemoryReport* report) {
+  if (report == nullptr) return;
+  for (int i = 0; i < report->num_tags; ++i) {
+    delete[] report->tags[i].tag;
+  }
+  delete[] report->tags;
+  delete report;
+}
+
 void daliDeletePipeline(daliPipelineHandle* pipe_handle) {
   dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
   dali::DeviceWorkspace* ws = reinterpret_cast<dali::DeviceWorkspace*>(pipe_handle->ws);
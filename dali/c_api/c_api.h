@@ -75,6 +75,84 @@ extern "C" {
    */
   DLL_PUBLIC void daliCopyTensorNTo(daliPipelineHandle* pipe_handle, void* dst, int n);
 
+  /**
+   * @brief Summary of measured times, in microseconds.
+   */
+  struct daliTimingStatistics {
+    int64_t count;
+    double total_us;
+    double p50_us;
+    double p90_us;
+    double p99_us;
+    double max_us;
+  };
+
+  struct daliOpStatistics {
+    const char *name;
+    const char *device;
+    daliTimingStatistics run_time;
+    uint64_t bytes_produced;
+    daliTimingStatistics prefetch_wait;
+  };
+
+  struct daliStatistics {
+    int64_t iterations;
+    int num_ops;
+    daliOpStatistics *ops;
+    daliTimingStatistics free_queue_wait;
+    daliTimingStatistics ready_queue_wait;
+    uint64_t planned_peak_bytes;
+    uint64_t allocated_bytes;
+    uint64_t max_sample_bytes;
+  };
+
+  /**
+   * @brief Enable or disable the collection
+   * of the execution statistics.
+   */
+  DLL_PUBLIC void daliEnableStatistics(daliPipelineHandle* pipe_handle, int enable);
+
+  /**
+   * @brief Return the execution statistics collected
+   * so far. The result must be freed with
+   * daliDeleteStatistics.
+   */
+  DLL_PUBLIC daliStatistics* daliGetStatistics(daliPipelineHandle* pipe_handle);
+
+  /**
+   * @brief Free the statistics returned by daliGetStatistics.
+   */
+  DLL_PUBLIC void daliDeleteStatistics(daliStatistics* stats);
+
+  /**
+   * @brief Bytes held by the buffers of one op or
+   * executor queue, now and at the peak.
+   */
+  struct daliMemoryUsage {
+    const char *tag;
+    uint64_t host_bytes;
+    uint64_t host_peak_bytes;
+    uint64_t gpu_bytes;
+    uint64_t gpu_peak_bytes;
+  };
+
+  struct daliMemoryReport {
+    int num_tags;
+    daliMemoryUsage *tags;
+  };
+
+  /**
+   * @brief Return the memory held by the pipeline,
+   * by op. The result must be freed with
+   * daliDeleteMemoryReport.
+   */
+  DLL_PUBLIC daliMemoryReport* daliGetMemoryReport(daliPipelineHandle* pipe_handle);
+
+  /**
+   * @brief Free the report returned by daliGetMemoryReport.
+   */
+  DLL_PUBLIC void daliDeleteMemoryReport(daliMemoryReport* report);
+
   /**
    * @brief Delete the pipeline object.
    */
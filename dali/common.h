@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "dali/api_helper.h"
+#include "dali/util/tracer.h"
 
 namespace dali {
 
@@ -63,6 +64,10 @@ typedef int64_t Index;
 // Only supported on the GPU
 typedef __half float16;
 
+// Device id of pipelines that run only support and cpu ops and do
+// not use the GPU nor make any call to the CUDA runtime or NVML
+const int CPU_ONLY_DEVICE_ID = -99999;
+
 /**
  * @brief Supported interpolation types
  */
@@ -144,20 +149,18 @@ struct TimeRange {
   static const uint32_t kGreen1  = 0x859900;
   static const uint32_t knvGreen = 0x76B900;
 
-  TimeRange(std::string name, const uint32_t rgb = kBlue) { // NOLINT
-#ifdef DALI_USE_NVTX
-    nvtxEventAttributes_t att;
-    att.version = NVTX_VERSION;
-    att.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
-    att.colorType = NVTX_COLOR_ARGB;
-    att.color = rgb | 0xff000000;
-    att.messageType = NVTX_MESSAGE_TYPE_ASCII;
-    att.message.ascii = name.c_str();
-
-    nvtxRangePushEx(&att);
-    started = true;
+  /**
+   * @brief Range named by a string literal or a name interned with
+   * Tracer::Intern(), which is recorded without any allocation.
+   * `arg`, when not negative, is recorded by the Tracer with the range,
+   * e.g. the index of the sample.
+   */
+  TimeRange(const char *name, const uint32_t rgb = kBlue, int64_t arg = -1) { // NOLINT
+    Start(name, name, rgb, arg);
+  }
 
-#endif
+  TimeRange(const std::string &name, const uint32_t rgb = kBlue) { // NOLINT
+    Start(Tracer::Enabled() ? Tracer::Get().Intern(name) : nullptr, name.c_str(), rgb, -1);
   }
 
   ~TimeRange() {
@@ -171,13 +174,40 @@ struct TimeRange {
       nvtxRangePop();
     }
 #endif
+    if (trace_name_ != nullptr) {
+      Tracer::Get().Record(trace_name_, begin_ns_, Tracer::NowNs(), arg_);
+      trace_name_ = nullptr;
+    }
   }
 
+ private:
+  inline void Start(const char *trace_name, const char *name, uint32_t rgb, int64_t arg) {
 #ifdef DALI_USE_NVTX
+    nvtxEventAttributes_t att;
+    att.version = NVTX_VERSION;
+    att.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    att.colorType = NVTX_COLOR_ARGB;
+    att.color = rgb | 0xff000000;
+    att.messageType = NVTX_MESSAGE_TYPE_ASCII;
+    att.message.ascii = name;
 
- private:
-    bool started = false;
+    nvtxRangePushEx(&att);
+    started = true;
+
+#endif
+    if (trace_name != nullptr && Tracer::Enabled()) {
+      trace_name_ = trace_name;
+      arg_ = arg;
+      begin_ns_ = Tracer::NowNs();
+    }
+  }
+
+#ifdef DALI_USE_NVTX
+  bool started = false;
 #endif
+  const char *trace_name_ = nullptr;
+  int64_t begin_ns_ = 0;
+  int64_t arg_ = -1;
 };
 
 using std::to_string;
@@ -186,8 +186,9 @@ DALIError_t MakeColorTransformation(const uint8 *img, int H, int W, int C,
     for (int y = 0; y < H; ++y) {
       for (int x = 0; x < W; ++x) {
         // Using direct calculation because they are 25% faster
-        // than two loops which could be used here
-        const auto &inpPix = cv_imgIn.at<cv::Vec3b>(y, x);
+        // than two loops which could be used here.
+        // The pixel is copied, as the output may be the input
+        const cv::Vec3b inpPix = cv_imgIn.at<cv::Vec3b>(y, x);
         auto &outPix = cv_imgOut.at<cv::Vec3b>(y, x);
         outPix[0] = cv::saturate_cast<uint8>
           (inpPix[0] * matr[0] + inpPix[1] * matr[1] + inpPix[2] * matr[2] + matr[3]);
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/pipeline/data/allocator.h"
+#include "dali/pipeline/data/caching_cpu_allocator.h"
 
 namespace dali {
 
@@ -20,9 +21,10 @@ namespace dali {
 DALI_DEFINE_OPTYPE_REGISTRY(GPUAllocator, GPUAllocator);
 DALI_DEFINE_OPTYPE_REGISTRY(CPUAllocator, CPUAllocator);
 
-// Register GPU, CPU, and PinnedCPU allocators
+// Register GPU, CPU, CachingCPU and PinnedCPU allocators
 DALI_REGISTER_GPU_ALLOCATOR(GPUAllocator, GPUAllocator);
 DALI_REGISTER_CPU_ALLOCATOR(CPUAllocator, CPUAllocator);
+DALI_REGISTER_CPU_ALLOCATOR(CachingCPUAllocator, CachingCPUAllocator);
 DALI_REGISTER_CPU_ALLOCATOR(PinnedCPUAllocator, PinnedCPUAllocator);
 
 }  // namespace dali
@@ -106,16 +106,36 @@ DALI_DECLARE_OPTYPE_REGISTRY(CPUAllocator, CPUAllocator);
  */
 class PinnedCPUAllocator : public CPUAllocator {
  public:
-  explicit PinnedCPUAllocator(const OpSpec &spec) : CPUAllocator(spec) {}
+  explicit PinnedCPUAllocator(const OpSpec &spec) : CPUAllocator(spec) {
+    // Without a CUDA device (e.g. CPU-only pipelines on hosts without a
+    // GPU) memory can not be pinned, and plain host memory is used
+    int device_count = 0;
+    has_device_ = cudaGetDeviceCount(&device_count) == cudaSuccess && device_count > 0;
+    if (!has_device_) {
+      // Clear the error of the failed query
+      cudaGetLastError();
+    }
+  }
   virtual ~PinnedCPUAllocator() = default;
 
   void New(void **ptr, size_t bytes) override {
+    if (!has_device_) {
+      CPUAllocator::New(ptr, bytes);
+      return;
+    }
     CUDA_CALL(cudaMallocHost(ptr, bytes));
   }
 
-  void Delete(void *ptr, size_t /* unused */) override {
+  void Delete(void *ptr, size_t bytes) override {
+    if (!has_device_) {
+      CPUAllocator::Delete(ptr, bytes);
+      return;
+    }
     CUDA_CALL(cudaFreeHost(ptr));
   }
+
+ private:
+  bool has_device_;
 };
 
 }  // namespace dali
@@ -44,14 +44,15 @@ class AllocatorManager {
     std::lock_guard<std::mutex> lock(mutex_);
     DALI_ENFORCE(cpu_allocator_ == nullptr, "DALI CPU allocator already set");
     DALI_ENFORCE(pinned_cpu_allocator_ == nullptr, "DALI Pinned CPU allocator already set");
-    DALI_ENFORCE(gpu_allocators_.size() == 0, "DALI GPU allocator already set");
+    DALI_ENFORCE(gpu_opspec_ == nullptr && gpu_allocators_.size() == 0,
+        "DALI GPU allocator already set");
     cpu_allocator_ = CPUAllocatorRegistry::Registry()
       .Create(cpu_allocator.name(), cpu_allocator);
     pinned_cpu_allocator_ = CPUAllocatorRegistry::Registry()
       .Create(pinned_cpu_allocator.name(), pinned_cpu_allocator);
+    // The GPU allocator of each device is created on first use, so that
+    // processes running only CPU-only pipelines never call into CUDA
     gpu_opspec_.reset(new OpSpec(gpu_allocator));
-    MAP_INSERT_OR_UPDATE(
-      GPUAllocatorRegistry::Registry().Create(gpu_allocator.name(), gpu_allocator));
   }
 
   static CPUAllocator& GetCPUAllocator() {
@@ -85,6 +86,12 @@ class AllocatorManager {
       .Create(allocator.name(), allocator);
   }
 
+  static unique_ptr<CPUAllocator> SetCPUAllocator(unique_ptr<CPUAllocator> allocator) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(cpu_allocator_, allocator);
+    return allocator;
+  }
+
   static void SetPinnedCPUAllocator(const OpSpec& allocator) {
     std::lock_guard<std::mutex> lock(mutex_);
     pinned_cpu_allocator_ = CPUAllocatorRegistry::Registry()
@@ -131,6 +138,10 @@ void SetCPUAllocator(const OpSpec& allocator) {
   AllocatorManager::SetCPUAllocator(allocator);
 }
 
+std::unique_ptr<CPUAllocator> SetCPUAllocator(std::unique_ptr<CPUAllocator> allocator) {
+  return AllocatorManager::SetCPUAllocator(std::move(allocator));
+}
+
 void SetPinnedCPUAllocator(const OpSpec& allocator) {
   AllocatorManager::SetPinnedCPUAllocator(allocator);
 }
@@ -147,6 +158,10 @@ GPUAllocator& GetGPUAllocator() {
   return AllocatorManager::GetGPUAllocator();
 }
 
+CPUAllocator& GetCPUAllocator() {
+  return AllocatorManager::GetCPUAllocator();
+}
+
 void* GPUBackend::New(size_t bytes, bool) {
   void *ptr = nullptr;
   AllocatorManager::GetGPUAllocator().New(&ptr, bytes);
@@ -30,11 +30,15 @@ void InitializeBackends(const OpSpec &cpu_allocator,
     const OpSpec &gpu_allocator);
 
 DLL_PUBLIC void SetCPUAllocator(const OpSpec& allocator);
+// Returns the allocator it replaces, so that it can be put back
+DLL_PUBLIC std::unique_ptr<CPUAllocator> SetCPUAllocator(std::unique_ptr<CPUAllocator> allocator);
 DLL_PUBLIC void SetPinnedCPUAllocator(const OpSpec& allocator);
 DLL_PUBLIC void SetGPUAllocator(const OpSpec& allocator);
 DLL_PUBLIC void SetGPUAllocator(std::unique_ptr<GPUAllocator> allocator);
 
 GPUAllocator& GetGPUAllocator();
+DLL_PUBLIC CPUAllocator& GetCPUAllocator();
+
 /**
  * @brief Provides access to GPU allocator and other GPU meta-data.
  */
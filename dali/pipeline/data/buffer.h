@@ -15,33 +15,42 @@
 #ifndef DALI_PIPELINE_DATA_BUFFER_H_
 #define DALI_PIPELINE_DATA_BUFFER_H_
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
 #include <functional>
 #include <vector>
 #include <string>
 #include <memory>
+#include <utility>
 
 #include "dali/common.h"
 #include "dali/error_handling.h"
+#include "dali/pipeline/data/memory_tracker.h"
+#include "dali/pipeline/data/tensor_shape.h"
 #include "dali/pipeline/data/types.h"
 
 namespace dali {
 
 class GPUBackend;
 
-// Helper function to get product of dims
-inline Index Product(const vector<Index> &shape) {
-  if (shape.size() == 0) return 0;
-  return std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<Index>());
-}
-
-// Helper function to get a string of the data shape
-inline string ShapeString(vector<Index> shape) {
-  string tmp;
-  for (auto &val : shape) tmp += std::to_string(val) + " ";
-  return tmp;
-}
+/**
+ * @brief Controls how a Buffer sizes its allocations. The default
+ * policy allocates exactly the bytes needed and never shrinks.
+ */
+struct BufferPolicy {
+  // Allocations are made this many times larger than needed, so that
+  // a buffer growing a little at a time is not reallocated every time
+  double growth_factor = 1.0;
+  // Sizes of the allocations are rounded up to a multiple of this
+  size_t alignment = 1;
+  // A buffer resized `shrink_after` times in a row to less than
+  // `shrink_threshold` of its allocation is reallocated to fit,
+  // so that it does not keep the memory of one outlier forever.
+  // 0 never shrinks.
+  int shrink_after = 0;
+  double shrink_threshold = 0.5;
+};
 
 // NOTE: Data storage types in DALI use delayed allocation, and have a
 // small custom type system that allows us to circumvent template
@@ -76,7 +85,8 @@ class Buffer {
                     shares_data_(false),
                     num_bytes_(0),
                     pinned_(true),
-                    device_(-1)
+                    device_(-1),
+                    num_shrink_resizes_(0)
     {}
 
   virtual ~Buffer() = default;
@@ -168,7 +178,7 @@ class Buffer {
    * @brief Returns the TypeInfo object that keeps track of the
    * datatype of the underlying storage.
    */
-  inline TypeInfo type() const {
+  inline const TypeInfo &type() const {
     return type_;
   }
 
@@ -181,6 +191,34 @@ class Buffer {
     pinned_ = pinned;
   }
 
+  /**
+   * @brief Sets the policy used for the next allocations
+   * of the buffer. See BufferPolicy.
+   */
+  inline void set_policy(const BufferPolicy &policy) {
+    DALI_ENFORCE(policy.growth_factor >= 1.0, "Growth factor must be at least 1.");
+    DALI_ENFORCE(policy.alignment > 0, "Alignment must be positive.");
+    DALI_ENFORCE(policy.shrink_after >= 0, "Shrink count must be non-negative.");
+    policy_ = policy;
+  }
+
+  inline const BufferPolicy &policy() const {
+    return policy_;
+  }
+
+  /**
+   * @brief Sets the tag the next allocations of the buffer are
+   * accounted to. Without one, the buffer takes the tag of the
+   * MemoryTagScope active when it first allocates.
+   */
+  inline void set_memory_tag(std::shared_ptr<MemoryTag> tag) {
+    memory_tag_ = std::move(tag);
+  }
+
+  inline const std::shared_ptr<MemoryTag> &memory_tag() const {
+    return memory_tag_;
+  }
+
   /**
    * @brief Returns a device this buffer was allocated on
    * If the backend is CPUBackend, return -1
@@ -218,18 +256,7 @@ class Buffer {
 
     size_t new_num_bytes = size_ * type_.size();
     if (new_num_bytes > num_bytes_) {
-      new_num_bytes *= alloc_mult;
-
-      // re-allocating: get the device
-      if (std::is_same<Backend, GPUBackend>::value) {
-        CUDA_CALL(cudaGetDevice(&device_));
-      }
-      data_.reset(Backend::New(new_num_bytes, pinned_), std::bind(
-              &Buffer<Backend>::DeleterHelper,
-              this, std::placeholders::_1,
-              type_, size_));
-      num_bytes_ = new_num_bytes;
-      shares_data_ = false;
+      AllocateHelper(AllocationBytes(new_num_bytes), size_);
     }
 
     type_.template Construct<Backend>(data_.get(), size_);
@@ -242,17 +269,22 @@ class Buffer {
 
   // Helper function for cleaning up data storage. This unfortunately
   // has to be public so that we can bind it into the deleter of our
-  // shared pointers
-  void DeleterHelper(void *ptr, TypeInfo type, Index size) {
+  // shared pointers. It is static, as the buffer can be moved or
+  // destroyed while its data is still shared
+  static void DeleterHelper(void *ptr, TypeInfo type, Index size, int device,
+                            bool pinned, size_t num_bytes, const shared_ptr<MemoryTag> &tag) {
     // change to correct device for deletion
     // Note: Can't use device guard due to potentially not GPUBackend.
     int current_device = 0;
     if (std::is_same<Backend, GPUBackend>::value) {
       CUDA_CALL(cudaGetDevice(&current_device));
-      CUDA_CALL(cudaSetDevice(device_));
+      CUDA_CALL(cudaSetDevice(device));
     }
     type.template Destruct<Backend>(ptr, size);
-    Backend::Delete(ptr, size*type.size(), pinned_);
+    Backend::Delete(ptr, num_bytes, pinned);
+    if (tag) {
+      tag->Free(num_bytes, std::is_same<Backend, GPUBackend>::value);
+    }
 
     // reset to original calling device for consistency
     if (std::is_same<Backend, GPUBackend>::value) {
@@ -283,29 +315,65 @@ class Buffer {
     }
 
     size_t new_num_bytes = new_size * type_.size();
-    if (new_num_bytes > num_bytes_) {
-      new_num_bytes *= alloc_mult;
-      // re-allocating: get the device
-      if (std::is_same<Backend, GPUBackend>::value) {
-        CUDA_CALL(cudaGetDevice(&device_));
-      }
-      data_.reset(Backend::New(new_num_bytes, pinned_), std::bind(
-              &Buffer<Backend>::DeleterHelper,
-              this, std::placeholders::_1,
-              type_, new_size));
-      num_bytes_ = new_num_bytes;
+    if (new_num_bytes > num_bytes_ || ShouldShrink(new_size, new_num_bytes)) {
+      AllocateHelper(AllocationBytes(new_num_bytes), new_size);
 
       // Call the constructor for the underlying datatype
       type_.template Construct<Backend>(data_.get(), new_size);
-
-      // If we were sharing data, we aren't anymore
-      shares_data_ = false;
     }
 
     size_ = new_size;
   }
 
-  const double alloc_mult = 1.0;
+  // Size of the allocation for `bytes` bytes of data
+  inline size_t AllocationBytes(size_t bytes) const {
+    size_t alloc_bytes = std::max(static_cast<size_t>(bytes * policy_.growth_factor), bytes);
+    return (alloc_bytes + policy_.alignment - 1) / policy_.alignment * policy_.alignment;
+  }
+
+  // Counts the resizes that use little of the allocation. Resizes to
+  // the current size are not counted, so that the buffers of ops
+  // running in place are not reallocated with the input still in them.
+  inline bool ShouldShrink(Index new_size, size_t new_num_bytes) {
+    if (policy_.shrink_after == 0 || shares_data_ || new_size == size_) {
+      return false;
+    }
+    if (new_num_bytes >= policy_.shrink_threshold * num_bytes_) {
+      num_shrink_resizes_ = 0;
+      return false;
+    }
+    return ++num_shrink_resizes_ >= policy_.shrink_after;
+  }
+
+  // Replaces the allocation with a new one, of `num_bytes`
+  // bytes, holding `size` elements of the current type
+  inline void AllocateHelper(size_t num_bytes, Index size) {
+    // re-allocating: get the device
+    if (std::is_same<Backend, GPUBackend>::value) {
+      CUDA_CALL(cudaGetDevice(&device_));
+    }
+    // The old allocation is freed first, so that both are not held at once
+    data_.reset();
+    if (!memory_tag_ && MemoryTag::Current() != nullptr) {
+      memory_tag_ = MemoryTag::Current()->shared_from_this();
+    }
+    data_.reset(Backend::New(num_bytes, pinned_), std::bind(
+            &Buffer<Backend>::DeleterHelper,
+            std::placeholders::_1, type_, size,
+            device_, pinned_, num_bytes, memory_tag_));
+    if (memory_tag_) {
+      memory_tag_->Allocate(num_bytes, std::is_same<Backend, GPUBackend>::value);
+    }
+    num_bytes_ = num_bytes;
+    num_shrink_resizes_ = 0;
+
+    // If we were sharing data, we aren't anymore
+    shares_data_ = false;
+  }
+
+  BufferPolicy policy_;
+  // Tag the allocations of the buffer are accounted to
+  shared_ptr<MemoryTag> memory_tag_;
 
   Backend backend_;
 
@@ -322,6 +390,9 @@ class Buffer {
 
   // device the buffer was allocated on
   int device_;
+
+  // Resizes in a row to a small part of the allocation
+  int num_shrink_resizes_;
 };
 
 // Macro so we don't have to list these in all
@@ -334,7 +405,9 @@ class Buffer {
   using Buffer<Backend>::size_;                 \
   using Buffer<Backend>::shares_data_;          \
   using Buffer<Backend>::num_bytes_;            \
-  using Buffer<Backend>::device_
+  using Buffer<Backend>::device_;               \
+  using Buffer<Backend>::policy_;               \
+  using Buffer<Backend>::memory_tag_
 
 }  // namespace dali
 
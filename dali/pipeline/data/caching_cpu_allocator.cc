@@ -0,0 +1,339 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/caching_cpu_allocator.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "dali/pipeline/operators/op_spec.h"
+
+namespace dali {
+
+namespace {
+
+// The size class of a block is stored in front of it, as the size
+// passed to Delete is not always the size that was allocated
+const size_t kHeaderBytes = alignof(std::max_align_t);
+
+const int kMinClassLog2 = 6;
+const size_t kMaxBytes = size_t(1) << 62;
+
+inline int Log2(size_t x) {
+  return 63 - __builtin_clzll(x);
+}
+
+inline char *Base(void *ptr) {
+  return static_cast<char*>(ptr) - kHeaderBytes;
+}
+
+inline int &HeaderClass(char *base) {
+  return *reinterpret_cast<int*>(base);
+}
+
+}  // namespace
+
+const int CachingCPUAllocator::kNumClasses;
+
+struct CachingCPUAllocator::Pool {
+  explicit Pool(size_t max_cached_bytes) : max_cached_bytes(max_cached_bytes) {}
+
+  ~Pool() {
+    for (auto &blocks : free) {
+      for (char *base : blocks) {
+        SystemFree(base);
+      }
+    }
+  }
+
+  char *SystemAlloc(int size_class) {
+    char *base = static_cast<char*>(
+        ::operator new(ClassBytes(size_class) + kHeaderBytes));
+    HeaderClass(base) = size_class;
+    system_allocs.fetch_add(1, std::memory_order_relaxed);
+    return base;
+  }
+
+  void SystemFree(char *base) {
+    ::operator delete(base);
+    system_frees.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Reserves room for `bytes` more cached bytes, if that
+  // does not go over the cap
+  bool ReserveCached(size_t bytes) {
+    size_t cached = cached_bytes.load(std::memory_order_relaxed);
+    do {
+      if (cached + bytes > max_cached_bytes) {
+        return false;
+      }
+    } while (!cached_bytes.compare_exchange_weak(cached, cached + bytes,
+                                                 std::memory_order_relaxed));
+    return true;
+  }
+
+  char *Acquire(int size_class) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &blocks = free[size_class];
+    if (blocks.empty()) {
+      return nullptr;
+    }
+    char *base = blocks.back();
+    blocks.pop_back();
+    cached_bytes.fetch_sub(ClassBytes(size_class), std::memory_order_relaxed);
+    return base;
+  }
+
+  void Release(char *base) {
+    const int size_class = HeaderClass(base);
+    if (!ReserveCached(ClassBytes(size_class))) {
+      SystemFree(base);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    free[size_class].push_back(base);
+  }
+
+  void Trim(size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int c = kNumClasses - 1; c >= 0; --c) {
+      auto &blocks = free[c];
+      while (!blocks.empty() && cached_bytes.load(std::memory_order_relaxed) > max_bytes) {
+        SystemFree(blocks.back());
+        blocks.pop_back();
+        cached_bytes.fetch_sub(ClassBytes(c), std::memory_order_relaxed);
+      }
+    }
+  }
+
+  const size_t max_cached_bytes;
+  // Set when the allocator is destroyed, so that the caches
+  // of the threads stop using the pool
+  std::atomic<bool> closed{false};
+
+  std::mutex mutex;
+  std::vector<char*> free[kNumClasses];
+
+  std::atomic<size_t> system_allocs{0};
+  std::atomic<size_t> system_frees{0};
+  std::atomic<size_t> cache_hits{0};
+  // Bytes in the pool and in all caches of the threads
+  std::atomic<size_t> cached_bytes{0};
+  std::atomic<size_t> live_bytes{0};
+};
+
+/**
+ * @brief Blocks freed by one thread, that only this thread
+ * allocates from. Goes back to the pool when the thread exits.
+ */
+struct CachingCPUAllocator::ThreadCache {
+  explicit ThreadCache(std::shared_ptr<Pool> pool) : pool(std::move(pool)) {}
+
+  ~ThreadCache() {
+    const bool closed = pool->closed.load();
+    for (int c = 0; c < kNumClasses; ++c) {
+      for (char *base : free[c]) {
+        pool->cached_bytes.fetch_sub(ClassBytes(c), std::memory_order_relaxed);
+        if (closed) {
+          pool->SystemFree(base);
+        } else {
+          pool->Release(base);
+        }
+      }
+    }
+  }
+
+  void Trim(size_t max_bytes) {
+    for (int c = kNumClasses - 1; c >= 0; --c) {
+      auto &blocks = free[c];
+      while (!blocks.empty() && pool->cached_bytes.load(std::memory_order_relaxed) > max_bytes) {
+        pool->SystemFree(blocks.back());
+        blocks.pop_back();
+        bytes -= ClassBytes(c);
+        pool->cached_bytes.fetch_sub(ClassBytes(c), std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::shared_ptr<Pool> pool;
+  std::vector<char*> free[kNumClasses];
+  size_t bytes = 0;
+};
+
+/**
+ * @brief Caches of one thread, one for every allocator it used.
+ */
+struct CachingCPUAllocator::ThreadCacheList {
+  ~ThreadCacheList();
+
+  std::vector<std::unique_ptr<ThreadCache>> caches;
+};
+
+namespace {
+
+// Trivially destructible, so that it can be read after the caches of
+// an exiting thread are gone, e.g. by the destructors of static objects
+thread_local bool thread_caches_destroyed = false;
+
+}  // namespace
+
+CachingCPUAllocator::ThreadCacheList::~ThreadCacheList() {
+  thread_caches_destroyed = true;
+}
+
+CachingCPUAllocator::ThreadCacheList *CachingCPUAllocator::ThreadCaches() {
+  thread_local ThreadCacheList list;
+  return thread_caches_destroyed ? nullptr : &list;
+}
+
+CachingCPUAllocator::CachingCPUAllocator(const OpSpec &spec) :
+  CPUAllocator(spec),
+  pool_(std::make_shared<Pool>(spec.HasArgument("max_cached_bytes") ?
+      spec.GetArgument<int64>("max_cached_bytes") : static_cast<int64>(2) << 30)),
+  thread_cache_bytes_(spec.HasArgument("thread_cache_bytes") ?
+      spec.GetArgument<int64>("thread_cache_bytes") : static_cast<int64>(64) << 20) {}
+
+CachingCPUAllocator::~CachingCPUAllocator() {
+  pool_->closed = true;
+  // The caches of the other threads free their blocks
+  // when the threads exit or use another allocator
+  ThreadCacheList *list = ThreadCaches();
+  if (list == nullptr) {
+    return;
+  }
+  auto &caches = list->caches;
+  for (auto it = caches.begin(); it != caches.end(); ++it) {
+    if ((*it)->pool == pool_) {
+      caches.erase(it);
+      break;
+    }
+  }
+}
+
+CachingCPUAllocator::ThreadCache *CachingCPUAllocator::GetThreadCache() {
+  ThreadCacheList *list = ThreadCaches();
+  if (list == nullptr) {
+    return nullptr;
+  }
+  auto &caches = list->caches;
+  ThreadCache *cache = nullptr;
+  for (size_t i = 0; i < caches.size();) {
+    if (caches[i]->pool == pool_) {
+      cache = caches[i].get();
+    } else if (caches[i]->pool->closed) {
+      caches.erase(caches.begin() + i);
+      continue;
+    }
+    ++i;
+  }
+  if (cache == nullptr) {
+    caches.emplace_back(new ThreadCache(pool_));
+    cache = caches.back().get();
+  }
+  return cache;
+}
+
+int CachingCPUAllocator::SizeClass(size_t bytes) {
+  if (bytes <= (size_t(1) << kMinClassLog2)) {
+    return 0;
+  }
+  // Four classes between every two powers of two
+  const int log2 = Log2(bytes - 1);
+  const size_t step = size_t(1) << (log2 - 2);
+  const size_t sub = (bytes - (size_t(1) << log2) + step - 1) / step;
+  return (log2 - kMinClassLog2) * 4 + static_cast<int>(sub);
+}
+
+size_t CachingCPUAllocator::ClassBytes(int size_class) {
+  if (size_class == 0) {
+    return size_t(1) << kMinClassLog2;
+  }
+  const int log2 = (size_class - 1) / 4 + kMinClassLog2;
+  const size_t sub = (size_class - 1) % 4 + 1;
+  return (size_t(1) << log2) + sub * (size_t(1) << (log2 - 2));
+}
+
+void CachingCPUAllocator::New(void **ptr, size_t bytes) {
+  DALI_ENFORCE(bytes <= kMaxBytes, "Allocation of " + to_string(bytes) + " bytes is too large");
+  const int size_class = SizeClass(bytes);
+  const size_t class_bytes = ClassBytes(size_class);
+  ThreadCache *cache = GetThreadCache();
+
+  char *base = nullptr;
+  if (cache != nullptr && !cache->free[size_class].empty()) {
+    base = cache->free[size_class].back();
+    cache->free[size_class].pop_back();
+    cache->bytes -= class_bytes;
+    pool_->cached_bytes.fetch_sub(class_bytes, std::memory_order_relaxed);
+  } else {
+    base = pool_->Acquire(size_class);
+  }
+
+  if (base != nullptr) {
+    pool_->cache_hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    try {
+      base = pool_->SystemAlloc(size_class);
+    } catch (std::bad_alloc &) {
+      // Give the cached memory back and try again
+      Trim(0);
+      base = pool_->SystemAlloc(size_class);
+    }
+  }
+  pool_->live_bytes.fetch_add(class_bytes, std::memory_order_relaxed);
+  *ptr = base + kHeaderBytes;
+}
+
+void CachingCPUAllocator::Delete(void *ptr, size_t /* unused */) {
+  if (ptr == nullptr) {
+    return;
+  }
+  char *base = Base(ptr);
+  const int size_class = HeaderClass(base);
+  const size_t class_bytes = ClassBytes(size_class);
+  pool_->live_bytes.fetch_sub(class_bytes, std::memory_order_relaxed);
+
+  ThreadCache *cache = GetThreadCache();
+  if (cache != nullptr && cache->bytes + class_bytes <= thread_cache_bytes_ &&
+      pool_->ReserveCached(class_bytes)) {
+    cache->free[size_class].push_back(base);
+    cache->bytes += class_bytes;
+  } else {
+    pool_->Release(base);
+  }
+}
+
+void CachingCPUAllocator::Trim(size_t max_bytes) {
+  ThreadCache *cache = GetThreadCache();
+  if (cache != nullptr) {
+    cache->Trim(max_bytes);
+  }
+  pool_->Trim(max_bytes);
+}
+
+CPUAllocatorStats CachingCPUAllocator::GetStats() const {
+  CPUAllocatorStats stats;
+  stats.system_allocs = pool_->system_allocs.load();
+  stats.system_frees = pool_->system_frees.load();
+  stats.cache_hits = pool_->cache_hits.load();
+  stats.cached_bytes = pool_->cached_bytes.load();
+  stats.live_bytes = pool_->live_bytes.load();
+  return stats;
+}
+
+}  // namespace dali
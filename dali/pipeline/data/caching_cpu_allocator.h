@@ -0,0 +1,107 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_DATA_CACHING_CPU_ALLOCATOR_H_
+#define DALI_PIPELINE_DATA_CACHING_CPU_ALLOCATOR_H_
+
+#include <memory>
+
+#include "dali/common.h"
+#include "dali/pipeline/data/allocator.h"
+
+namespace dali {
+
+/**
+ * @brief Counters of a CachingCPUAllocator. In the steady state of
+ * a pipeline, `system_allocs` should not grow.
+ */
+struct CPUAllocatorStats {
+  // Blocks allocated from and returned to the system
+  size_t system_allocs = 0;
+  size_t system_frees = 0;
+  // Allocations served from the caches
+  size_t cache_hits = 0;
+  // Bytes of the blocks held by the caches, and of the blocks in use
+  size_t cached_bytes = 0;
+  size_t live_bytes = 0;
+};
+
+/**
+ * @brief CPU allocator that keeps freed blocks for reuse, so that
+ * buffers growing and shrinking with the sizes of the samples do not
+ * go to malloc, which maps and unmaps large blocks every time.
+ *
+ * Sizes are rounded up to size classes, four per power of two, so at
+ * most 25% of a block is wasted. Freed blocks go to a small cache of
+ * the freeing thread first, and to a cache shared by all threads when
+ * that is full. Blocks are returned to the system when the caches
+ * would hold more than `max_cached_bytes`, or on Trim().
+ *
+ * Select it with `DALIInit(OpSpec("CachingCPUAllocator"), ...)`.
+ * Optional arguments of the spec are `max_cached_bytes` (default 2 GB)
+ * and `thread_cache_bytes` (default 64 MB), both int64.
+ */
+class DLL_PUBLIC CachingCPUAllocator : public CPUAllocator {
+ public:
+  DLL_PUBLIC explicit CachingCPUAllocator(const OpSpec &spec);
+  DLL_PUBLIC ~CachingCPUAllocator() override;
+
+  DLL_PUBLIC void New(void **ptr, size_t bytes) override;
+
+  DLL_PUBLIC void Delete(void *ptr, size_t bytes) override;
+
+  /**
+   * @brief Returns the blocks of the shared cache and of the cache of
+   * the calling thread to the system, until at most `max_bytes` stay
+   * cached. The caches of the other threads are left as they are.
+   */
+  DLL_PUBLIC void Trim(size_t max_bytes = 0);
+
+  DLL_PUBLIC CPUAllocatorStats GetStats() const;
+
+  /**
+   * @brief Returns the size class of an allocation of `bytes` bytes.
+   */
+  DLL_PUBLIC static int SizeClass(size_t bytes);
+
+  /**
+   * @brief Returns the number of bytes of the blocks of `size_class`.
+   */
+  DLL_PUBLIC static size_t ClassBytes(int size_class);
+
+  // Number of size classes, that cover all 64 bit sizes
+  static const int kNumClasses = 4 * 58 + 1;
+
+  DISABLE_COPY_MOVE_ASSIGN(CachingCPUAllocator);
+
+ private:
+  struct Pool;
+  struct ThreadCache;
+  struct ThreadCacheList;
+
+  // Returns the caches of the calling thread, or nullptr
+  // if the thread is exiting and they are already destroyed
+  static ThreadCacheList *ThreadCaches();
+
+  ThreadCache *GetThreadCache();
+
+  // Shared by the allocator and the caches of the threads,
+  // which can outlive it
+  std::shared_ptr<Pool> pool_;
+  const size_t thread_cache_bytes_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_DATA_CACHING_CPU_ALLOCATOR_H_
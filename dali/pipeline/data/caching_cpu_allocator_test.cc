@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/caching_cpu_allocator.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "dali/pipeline/operators/op_spec.h"
+
+namespace dali {
+
+TEST(CachingCPUAllocatorTest, SizeClasses) {
+  ASSERT_EQ(CachingCPUAllocator::SizeClass(0), 0);
+  ASSERT_EQ(CachingCPUAllocator::SizeClass(64), 0);
+  ASSERT_EQ(CachingCPUAllocator::ClassBytes(0), 64);
+  ASSERT_EQ(CachingCPUAllocator::ClassBytes(CachingCPUAllocator::SizeClass(65)), 80);
+  ASSERT_EQ(CachingCPUAllocator::ClassBytes(CachingCPUAllocator::SizeClass(128)), 128);
+  ASSERT_EQ(CachingCPUAllocator::ClassBytes(CachingCPUAllocator::SizeClass(129)), 160);
+
+  size_t prev = 0;
+  for (int c = 0; c < 4 * 50; ++c) {
+    const size_t bytes = CachingCPUAllocator::ClassBytes(c);
+    ASSERT_GT(bytes, prev);
+    ASSERT_EQ(CachingCPUAllocator::SizeClass(bytes), c);
+    ASSERT_EQ(CachingCPUAllocator::SizeClass(prev + 1), c);
+    // At most 25% is wasted
+    ASSERT_LE(bytes, (prev + 1) * 5 / 4 + 64);
+    prev = bytes;
+  }
+}
+
+TEST(CachingCPUAllocatorTest, SteadyState) {
+  CachingCPUAllocator allocator(OpSpec("CachingCPUAllocator"));
+  const vector<size_t> sizes = {100, 3 << 20, 5000, 1 << 20, 77};
+
+  // Sizes vary between the iterations, like the sizes of decoded images
+  for (int iter = 0; iter < 10; ++iter) {
+    vector<void*> ptrs(sizes.size());
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      const size_t bytes = sizes[(i + iter) % sizes.size()];
+      allocator.New(&ptrs[i], bytes);
+      std::memset(ptrs[i], iter, bytes);
+    }
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      allocator.Delete(ptrs[i], 0);
+    }
+    if (iter == 0) {
+      ASSERT_EQ(allocator.GetStats().system_allocs, sizes.size());
+    }
+  }
+
+  CPUAllocatorStats stats = allocator.GetStats();
+  ASSERT_EQ(stats.system_allocs, sizes.size());
+  ASSERT_EQ(stats.system_frees, 0);
+  ASSERT_EQ(stats.cache_hits, 9 * sizes.size());
+  ASSERT_EQ(stats.live_bytes, 0);
+  ASSERT_GT(stats.cached_bytes, 0);
+
+  allocator.Trim();
+  stats = allocator.GetStats();
+  ASSERT_EQ(stats.system_frees, sizes.size());
+  ASSERT_EQ(stats.cached_bytes, 0);
+}
+
+TEST(CachingCPUAllocatorTest, MaxCachedBytes) {
+  CachingCPUAllocator allocator(OpSpec("CachingCPUAllocator")
+      .AddArg("max_cached_bytes", static_cast<int64>(1 << 20)));
+
+  void *small, *large;
+  allocator.New(&small, 1000);
+  allocator.New(&large, 2 << 20);
+  allocator.Delete(small, 1000);
+  allocator.Delete(large, 2 << 20);
+
+  // The large block does not fit under the cap
+  CPUAllocatorStats stats = allocator.GetStats();
+  ASSERT_EQ(stats.system_frees, 1);
+  ASSERT_EQ(stats.cached_bytes, CachingCPUAllocator::ClassBytes(
+      CachingCPUAllocator::SizeClass(1000)));
+
+  allocator.New(&small, 1000);
+  ASSERT_EQ(allocator.GetStats().cache_hits, 1);
+  allocator.Delete(small, 1000);
+}
+
+TEST(CachingCPUAllocatorTest, Threads) {
+  // Small thread caches, so that the blocks go through the pool
+  CachingCPUAllocator allocator(OpSpec("CachingCPUAllocator")
+      .AddArg("thread_cache_bytes", static_cast<int64>(4096)));
+  const int num_threads = 4;
+  const int num_blocks = 16;
+
+  auto run = [&]() {
+    std::atomic<int> allocated{0};
+    vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        vector<void*> ptrs(num_blocks);
+        for (int i = 0; i < num_blocks; ++i) {
+          allocator.New(&ptrs[i], 1000 * (i + 1));
+          std::memset(ptrs[i], t, 1000 * (i + 1));
+        }
+        // All blocks are in use at the same time
+        ++allocated;
+        while (allocated < num_threads) {
+          std::this_thread::yield();
+        }
+        for (int i = 0; i < num_blocks; ++i) {
+          allocator.Delete(ptrs[i], 0);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  };
+
+  // The caches of the exiting threads go back to the pool,
+  // so the new threads need no more system allocations
+  run();
+  const size_t system_allocs = allocator.GetStats().system_allocs;
+  ASSERT_EQ(system_allocs, num_threads * num_blocks);
+  run();
+  CPUAllocatorStats stats = allocator.GetStats();
+  ASSERT_EQ(stats.system_allocs, system_allocs);
+  ASSERT_EQ(stats.live_bytes, 0);
+
+  // Blocks allocated by one thread and freed by another
+  vector<void*> ptrs(num_blocks);
+  for (int i = 0; i < num_blocks; ++i) {
+    allocator.New(&ptrs[i], 1000 * (i + 1));
+  }
+  std::thread([&]() {
+    for (int i = 0; i < num_blocks; ++i) {
+      allocator.Delete(ptrs[i], 0);
+    }
+  }).join();
+  stats = allocator.GetStats();
+  ASSERT_EQ(stats.system_allocs, system_allocs);
+  ASSERT_EQ(stats.live_bytes, 0);
+}
+
+}  // namespace dali
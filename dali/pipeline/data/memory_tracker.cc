@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/memory_tracker.h"
+
+namespace dali {
+
+namespace {
+
+thread_local MemoryTag *current_tag = nullptr;
+
+}  // namespace
+
+void MemoryTag::Allocate(size_t bytes, bool gpu) {
+  const size_t now = bytes_[gpu].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  size_t peak = peak_bytes_[gpu].load(std::memory_order_relaxed);
+  while (now > peak &&
+      !peak_bytes_[gpu].compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+}
+
+void MemoryTag::Free(size_t bytes, bool gpu) {
+  bytes_[gpu].fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTag::ResetPeak() {
+  for (int i = 0; i < 2; ++i) {
+    peak_bytes_[i] = bytes_[i].load();
+  }
+}
+
+MemoryTag *MemoryTag::Current() {
+  return current_tag;
+}
+
+void MemoryTag::SetCurrent(MemoryTag *tag) {
+  current_tag = tag;
+}
+
+std::shared_ptr<MemoryTag> MemoryTracker::Tag(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &tag = tags_[name];
+  if (!tag) {
+    tag = std::make_shared<MemoryTag>(name);
+  }
+  return tag;
+}
+
+std::vector<MemoryUsage> MemoryTracker::Report() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<MemoryUsage> report;
+  for (auto &name_tag : tags_) {
+    const MemoryTag &tag = *name_tag.second;
+    MemoryUsage usage;
+    usage.tag = tag.name();
+    usage.host_bytes = tag.bytes(false);
+    usage.host_peak_bytes = tag.peak_bytes(false);
+    usage.gpu_bytes = tag.bytes(true);
+    usage.gpu_peak_bytes = tag.peak_bytes(true);
+    report.push_back(usage);
+  }
+  return report;
+}
+
+void MemoryTracker::ResetPeaks() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &name_tag : tags_) {
+    name_tag.second->ResetPeak();
+  }
+}
+
+}  // namespace dali
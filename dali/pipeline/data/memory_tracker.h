@@ -0,0 +1,141 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_DATA_MEMORY_TRACKER_H_
+#define DALI_PIPELINE_DATA_MEMORY_TRACKER_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dali/common.h"
+
+namespace dali {
+
+/**
+ * @brief Memory held by the buffers of one tag
+ */
+struct MemoryUsage {
+  std::string tag;
+  size_t host_bytes = 0;
+  size_t host_peak_bytes = 0;
+  size_t gpu_bytes = 0;
+  size_t gpu_peak_bytes = 0;
+};
+
+/**
+ * @brief Counts the bytes allocated by the buffers owned by an op
+ * or by a part of the pipeline, and their peak.
+ *
+ * A Buffer takes the tag it was given with `set_memory_tag`, or else
+ * the tag of the MemoryTagScope active in the thread making its first
+ * allocation, and keeps it for its lifetime. The executor runs every
+ * op in the scope of the op's tag, so the outputs and the scratch
+ * buffers of the ops are accounted to them without any changes to
+ * the ops.
+ */
+class DLL_PUBLIC MemoryTag : public std::enable_shared_from_this<MemoryTag> {
+ public:
+  DLL_PUBLIC explicit MemoryTag(const std::string &name) : name_(name) {
+    for (int i = 0; i < 2; ++i) {
+      bytes_[i] = 0;
+      peak_bytes_[i] = 0;
+    }
+  }
+
+  DLL_PUBLIC inline const std::string &name() const { return name_; }
+
+  DLL_PUBLIC void Allocate(size_t bytes, bool gpu);
+
+  DLL_PUBLIC void Free(size_t bytes, bool gpu);
+
+  DLL_PUBLIC inline size_t bytes(bool gpu) const { return bytes_[gpu]; }
+
+  DLL_PUBLIC inline size_t peak_bytes(bool gpu) const { return peak_bytes_[gpu]; }
+
+  /**
+   * @brief Sets the peak to the bytes allocated now.
+   */
+  DLL_PUBLIC void ResetPeak();
+
+  /**
+   * @brief Returns the tag of the innermost MemoryTagScope of the
+   * calling thread, or nullptr if there is none.
+   */
+  DLL_PUBLIC static MemoryTag *Current();
+
+  DISABLE_COPY_MOVE_ASSIGN(MemoryTag);
+
+ private:
+  friend class MemoryTagScope;
+  static void SetCurrent(MemoryTag *tag);
+
+  std::string name_;
+  // Indexed by whether the memory is on the gpu
+  std::atomic<size_t> bytes_[2];
+  std::atomic<size_t> peak_bytes_[2];
+};
+
+/**
+ * @brief Makes `tag` the tag of the new buffers allocated by
+ * the calling thread, until the scope ends.
+ */
+class DLL_PUBLIC MemoryTagScope {
+ public:
+  DLL_PUBLIC explicit inline MemoryTagScope(MemoryTag *tag) : previous_(MemoryTag::Current()) {
+    MemoryTag::SetCurrent(tag);
+  }
+
+  DLL_PUBLIC inline ~MemoryTagScope() {
+    MemoryTag::SetCurrent(previous_);
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(MemoryTagScope);
+
+ private:
+  MemoryTag *previous_;
+};
+
+/**
+ * @brief The memory tags of a pipeline, by name.
+ */
+class DLL_PUBLIC MemoryTracker {
+ public:
+  DLL_PUBLIC MemoryTracker() = default;
+
+  /**
+   * @brief Returns the tag with the given name, creating it if needed.
+   */
+  DLL_PUBLIC std::shared_ptr<MemoryTag> Tag(const std::string &name);
+
+  /**
+   * @brief Returns the usage of every tag, ordered by name.
+   */
+  DLL_PUBLIC std::vector<MemoryUsage> Report() const;
+
+  DLL_PUBLIC void ResetPeaks();
+
+  DISABLE_COPY_MOVE_ASSIGN(MemoryTracker);
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<MemoryTag>> tags_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_DATA_MEMORY_TRACKER_H_
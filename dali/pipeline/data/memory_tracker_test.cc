@@ -0,0 +1,109 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/memory_tracker.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/tensor.h"
+#include "dali/pipeline/data/tensor_list.h"
+
+namespace dali {
+
+TEST(MemoryTrackerTest, TestScope) {
+  MemoryTracker tracker;
+  auto outer = tracker.Tag("outer");
+  auto inner = tracker.Tag("inner");
+  ASSERT_EQ(tracker.Tag("outer"), outer);
+
+  ASSERT_EQ(MemoryTag::Current(), nullptr);
+  {
+    MemoryTagScope outer_scope(outer.get());
+    ASSERT_EQ(MemoryTag::Current(), outer.get());
+    {
+      MemoryTagScope inner_scope(inner.get());
+      ASSERT_EQ(MemoryTag::Current(), inner.get());
+
+      // Scopes are per thread
+      std::thread([]() {
+        ASSERT_EQ(MemoryTag::Current(), nullptr);
+      }).join();
+    }
+    ASSERT_EQ(MemoryTag::Current(), outer.get());
+  }
+  ASSERT_EQ(MemoryTag::Current(), nullptr);
+}
+
+TEST(MemoryTrackerTest, TestTensorAccounting) {
+  MemoryTracker tracker;
+  auto tag = tracker.Tag("op");
+  {
+    Tensor<CPUBackend> tensor;
+    {
+      MemoryTagScope scope(tag.get());
+      tensor.Resize({1000});
+      tensor.mutable_data<uint8>();
+    }
+    ASSERT_EQ(tensor.memory_tag(), tag);
+    ASSERT_EQ(tag->bytes(false), 1000);
+
+    // The tensor keeps its tag out of the scope
+    tensor.Resize({3000});
+    tensor.mutable_data<uint8>();
+    ASSERT_EQ(tag->bytes(false), 3000);
+    ASSERT_EQ(tag->peak_bytes(false), 3000);
+
+    // Moved tensors take their tag with them
+    Tensor<CPUBackend> moved(std::move(tensor));
+    ASSERT_EQ(moved.memory_tag(), tag);
+    ASSERT_EQ(tag->bytes(false), 3000);
+  }
+  ASSERT_EQ(tag->bytes(false), 0);
+  ASSERT_EQ(tag->peak_bytes(false), 3000);
+  ASSERT_EQ(tag->bytes(true), 0);
+
+  tracker.ResetPeaks();
+  ASSERT_EQ(tag->peak_bytes(false), 0);
+}
+
+TEST(MemoryTrackerTest, TestExplicitTag) {
+  MemoryTracker tracker;
+  auto scope_tag = tracker.Tag("scope");
+  auto explicit_tag = tracker.Tag("explicit");
+
+  TensorList<CPUBackend> tl;
+  tl.set_memory_tag(explicit_tag);
+  {
+    MemoryTagScope scope(scope_tag.get());
+    tl.Resize({{10, 10}, {20, 10}});
+    tl.mutable_data<float>();
+  }
+  ASSERT_EQ(scope_tag->bytes(false), 0);
+  ASSERT_EQ(explicit_tag->bytes(false), 300 * sizeof(float));
+
+  auto report = tracker.Report();
+  ASSERT_EQ(report.size(), 2);
+  ASSERT_EQ(report[0].tag, "explicit");
+  ASSERT_EQ(report[0].host_bytes, 300 * sizeof(float));
+  ASSERT_EQ(report[0].host_peak_bytes, 300 * sizeof(float));
+  ASSERT_EQ(report[1].tag, "scope");
+  ASSERT_EQ(report[1].host_bytes, 0);
+}
+
+}  // namespace dali
@@ -15,11 +15,65 @@
 #ifndef DALI_PIPELINE_DATA_META_H_
 #define DALI_PIPELINE_DATA_META_H_
 
+#include <memory>
 #include <string>
+#include <utility>
 #include "dali/pipeline/data/types.h"
 
 namespace dali {
 
+/**
+ * @brief Describes where a sample was read from: a source, e.g. a file,
+ * and optionally the index or the key of the sample in it. It shares
+ * the name of the source with the loader that read the sample, so it
+ * is cheap to set for every sample, and builds the string when asked
+ * for it, i.e. for error messages.
+ *
+ * The name is reference counted and the key is copied, so that the
+ * description stays valid wherever the sample goes, even after its
+ * loader is destroyed.
+ */
+class SourceInfo {
+ public:
+  SourceInfo() {
+  }
+
+  // The sample is the whole source
+  explicit SourceInfo(std::shared_ptr<const std::string> source)
+    : source_(std::move(source)) {
+  }
+
+  // The sample is at `index` in the source
+  SourceInfo(std::shared_ptr<const std::string> source, int64 index)
+    : source_(std::move(source)), index_(index) {
+  }
+
+  // The sample is stored with `key` in the source
+  SourceInfo(std::shared_ptr<const std::string> source, const char *key, size_t key_size)
+    : source_(std::move(source)), key_(key, key_size) {
+  }
+
+  inline bool empty() const {
+    return source_ == nullptr;
+  }
+
+  inline std::string str() const {
+    if (empty()) return "";
+    if (!key_.empty()) {
+      return *source_ + " at key " + key_;
+    }
+    if (index_ >= 0) {
+      return *source_ + " at index " + std::to_string(index_);
+    }
+    return *source_;
+  }
+
+ private:
+  std::shared_ptr<const std::string> source_;
+  int64 index_ = -1;
+  std::string key_;
+};
+
 class DALIMeta {
  public:
   DALIMeta() {
@@ -36,17 +90,17 @@ class DALIMeta {
     layout_ = layout;
   }
 
-  inline std::string GetSourceInfo() const {
+  inline const SourceInfo &GetSourceInfo() const {
     return source_info_;
   }
 
-  inline void SetSourceInfo(std::string source_info) {
+  inline void SetSourceInfo(const SourceInfo &source_info) {
     source_info_ = source_info;
   }
 
  private:
   DALITensorLayout layout_;
-  std::string source_info_;
+  SourceInfo source_info_;
 };
 
 }  // namespace dali
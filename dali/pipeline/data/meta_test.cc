@@ -0,0 +1,63 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/meta.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/tensor.h"
+
+namespace dali {
+
+TEST(SourceInfoTest, TestStr) {
+  const auto path = std::make_shared<const std::string>("/data/train.rec");
+  const char key[] = {'0', '0', '4', '2'};  // not null terminated
+
+  ASSERT_TRUE(SourceInfo().empty());
+  ASSERT_EQ(SourceInfo().str(), "");
+  ASSERT_EQ(SourceInfo(path).str(), *path);
+  ASSERT_EQ(SourceInfo(path, 1024).str(), *path + " at index 1024");
+  ASSERT_EQ(SourceInfo(path, 0).str(), *path + " at index 0");
+  ASSERT_EQ(SourceInfo(path, key, sizeof(key)).str(), *path + " at key 0042");
+}
+
+TEST(SourceInfoTest, TestTensor) {
+  auto path = std::make_shared<const std::string>("image.jpg");
+  Tensor<CPUBackend> tensor;
+  ASSERT_EQ(tensor.GetSourceInfo(), "");
+  tensor.SetSourceInfo(SourceInfo(path));
+  ASSERT_EQ(tensor.GetSourceInfo(), *path);
+
+  Tensor<CPUBackend> other;
+  other.SetSourceInfo(tensor.source_info());
+  ASSERT_EQ(other.GetSourceInfo(), *path);
+}
+
+TEST(SourceInfoTest, TestOutlivesSource) {
+  // The samples keep the names, and their own copy of the keys, after
+  // the loader that read them is gone
+  auto path = std::make_shared<const std::string>("/data/train_lmdb");
+  std::string key = "0042";
+  Tensor<CPUBackend> tensor;
+  tensor.SetSourceInfo(SourceInfo(path, key.data(), key.size()));
+  path.reset();
+  key = "----";
+  ASSERT_EQ(tensor.GetSourceInfo(), "/data/train_lmdb at key 0042");
+}
+
+}  // namespace dali
@@ -0,0 +1,72 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/scratch_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace dali {
+
+const size_t ScratchArena::kMinBlockBytes;
+
+void *ScratchArena::Allocate(size_t bytes, size_t alignment) {
+  DALI_ENFORCE(alignment > 0 && (alignment & (alignment - 1)) == 0,
+      "Alignment must be a power of two.");
+  if (!blocks_.empty()) {
+    Tensor<CPUBackend> &block = blocks_.back();
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.raw_mutable_data());
+    const size_t begin = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+    if (begin + bytes <= block.nbytes()) {
+      used_ += begin + bytes - offset_;
+      offset_ = begin + bytes;
+      return reinterpret_cast<void*>(base + begin);
+    }
+  }
+  // Blocks grow geometrically, so a sample needs few of them
+  const size_t last_bytes = blocks_.empty() ? 0 : blocks_.back().nbytes();
+  AddBlock(std::max({bytes + alignment, 2 * last_bytes, kMinBlockBytes}));
+  return Allocate(bytes, alignment);
+}
+
+void ScratchArena::Reset() {
+  if (blocks_.size() > 1) {
+    // Nothing points into the blocks anymore, so they can be
+    // replaced by one that fits the whole sample next time
+    blocks_.clear();
+    const size_t bytes = capacity_;
+    capacity_ = 0;
+    AddBlock(bytes);
+  }
+  offset_ = 0;
+  used_ = 0;
+}
+
+void ScratchArena::AddBlock(size_t bytes) {
+  blocks_.emplace_back();
+  Tensor<CPUBackend> &block = blocks_.back();
+  block.set_pinned(false);
+  block.set_memory_tag(memory_tag_);
+  block.Resize({static_cast<Index>(bytes)});
+  block.mutable_data<uint8>();
+  capacity_ += bytes;
+  offset_ = 0;
+}
+
+ScratchArena &ScratchArena::ThreadLocal() {
+  thread_local ScratchArena arena;
+  return arena;
+}
+
+}  // namespace dali
@@ -0,0 +1,111 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_DATA_SCRATCH_ARENA_H_
+#define DALI_PIPELINE_DATA_SCRATCH_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/tensor.h"
+
+namespace dali {
+
+/**
+ * @brief Bump-pointer allocator for the temporary buffers of the ops.
+ *
+ * Allocations are carved out of large blocks and are all released at
+ * once by Reset(). When a sample needed more than one block, Reset()
+ * replaces them with a single block of their total size, so once the
+ * arena has seen the largest sample it serves every allocation without
+ * touching the heap.
+ *
+ * The executor keeps one arena per worker thread and resets it before
+ * each op runs on a sample, see SampleWorkspace::scratch(). The arena of
+ * the thread, used by the other workspaces, is reset after each op runs.
+ * It is not thread safe.
+ */
+class DLL_PUBLIC ScratchArena {
+ public:
+  DLL_PUBLIC ScratchArena() = default;
+  DLL_PUBLIC ScratchArena(ScratchArena &&) = default;
+  DLL_PUBLIC ScratchArena &operator=(ScratchArena &&) = default;
+
+  /**
+   * @brief Returns `bytes` bytes of uninitialized memory aligned to
+   * `alignment`, a power of two. It is valid until the next Reset().
+   */
+  DLL_PUBLIC void *Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * @brief Returns uninitialized memory for `count` objects of type T.
+   * Their destructors are never run, so T must be trivially destructible.
+   */
+  template <typename T>
+  DLL_PUBLIC inline T *Allocate(size_t count) {
+    static_assert(std::is_trivially_destructible<T>::value,
+        "Scratch memory is released without running destructors");
+    return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief Releases all allocations.
+   */
+  DLL_PUBLIC void Reset();
+
+  /**
+   * @brief Returns the bytes allocated since the last Reset(),
+   * including the padding for the alignment.
+   */
+  DLL_PUBLIC inline size_t used() const { return used_; }
+
+  /**
+   * @brief Returns the bytes of all blocks of the arena.
+   */
+  DLL_PUBLIC inline size_t capacity() const { return capacity_; }
+
+  /**
+   * @brief Sets the tag the blocks of the arena are accounted to.
+   */
+  DLL_PUBLIC inline void set_memory_tag(std::shared_ptr<MemoryTag> tag) {
+    memory_tag_ = std::move(tag);
+  }
+
+  /**
+   * @brief Returns the arena of the calling thread, used by workspaces
+   * that were not given one by the executor.
+   */
+  DLL_PUBLIC static ScratchArena &ThreadLocal();
+
+ private:
+  void AddBlock(size_t bytes);
+
+  static const size_t kMinBlockBytes = 64 << 10;
+
+  std::vector<Tensor<CPUBackend>> blocks_;
+  // Offset of the free memory in the last block
+  size_t offset_ = 0;
+  size_t used_ = 0;
+  size_t capacity_ = 0;
+  std::shared_ptr<MemoryTag> memory_tag_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_DATA_SCRATCH_ARENA_H_
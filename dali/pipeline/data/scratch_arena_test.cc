@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/scratch_arena.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "dali/pipeline/data/memory_tracker.h"
+#include "dali/pipeline/workspace/host_workspace.h"
+#include "dali/pipeline/workspace/sample_workspace.h"
+
+namespace dali {
+
+TEST(ScratchArenaTest, TestAlignment) {
+  ScratchArena arena;
+  char *c = arena.Allocate<char>(3);
+  double *d = arena.Allocate<double>(5);
+  void *p = arena.Allocate(10, 256);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(d) % alignof(double), 0);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % 256, 0);
+  ASSERT_GT(reinterpret_cast<char*>(d), c + 2);
+  ASSERT_GE(reinterpret_cast<char*>(p), reinterpret_cast<char*>(d + 5));
+  ASSERT_GE(arena.used(), 3 + 5 * sizeof(double) + 10);
+}
+
+TEST(ScratchArenaTest, TestReset) {
+  MemoryTracker tracker;
+  auto tag = tracker.Tag("scratch");
+  ScratchArena arena;
+  arena.set_memory_tag(tag);
+
+  // A sample that does not fit in one block
+  const size_t sizes[] = {1000, 100 << 10, 300 << 10, 10};
+  for (size_t bytes : sizes) {
+    std::memset(arena.Allocate(bytes), 1, bytes);
+  }
+  const size_t capacity = arena.capacity();
+  ASSERT_GT(capacity, (400 << 10));
+  ASSERT_EQ(tag->bytes(false), capacity);
+
+  // After the reset the same sample fits in a single block
+  arena.Reset();
+  ASSERT_EQ(arena.used(), 0);
+  ASSERT_EQ(arena.capacity(), capacity);
+  void *first = arena.Allocate(sizes[0]);
+  for (int i = 1; i < 4; ++i) {
+    arena.Allocate(sizes[i]);
+  }
+  ASSERT_EQ(arena.capacity(), capacity);
+  arena.Reset();
+  ASSERT_EQ(arena.Allocate(sizes[0]), first);
+}
+
+TEST(ScratchArenaTest, TestSampleWorkspace) {
+  ScratchArena arena;
+  HostWorkspace host_ws;
+  SampleWorkspace ws;
+
+  host_ws.GetSample(&ws, 0, 0, &arena);
+  ASSERT_EQ(&ws.scratch(), &arena);
+  int *data = ws.AllocateScratch<int>(100);
+  ASSERT_EQ(arena.used(), 100 * sizeof(int));
+
+  // The arena is reset for the next sample
+  host_ws.GetSample(&ws, 1, 0, &arena);
+  ASSERT_EQ(arena.used(), 0);
+  ASSERT_EQ(ws.AllocateScratch<int>(100), data);
+
+  // Without an arena, the one of the thread is used
+  host_ws.GetSample(&ws, 2, 0);
+  ASSERT_EQ(&ws.scratch(), &ScratchArena::ThreadLocal());
+}
+
+TEST(ScratchArenaTest, TestThreadLocalRelease) {
+  // A workspace that did not come from GetSample
+  SampleWorkspace ws;
+  ScratchArena &arena = ScratchArena::ThreadLocal();
+  arena.Reset();
+  int *data = ws.AllocateScratch<int>(100);
+  ASSERT_EQ(arena.used(), 100 * sizeof(int));
+
+  // The memory is released when the op is done with the sample
+  ws.ReleaseThreadLocalScratch();
+  ASSERT_EQ(arena.used(), 0);
+  ASSERT_EQ(ws.AllocateScratch<int>(100), data);
+  ws.ReleaseThreadLocalScratch();
+
+  // The arena given by the executor is kept, it is reset before each op
+  ScratchArena own;
+  ws.set_scratch(&own);
+  ws.AllocateScratch<int>(100);
+  ws.ReleaseThreadLocalScratch();
+  ASSERT_EQ(own.used(), 100 * sizeof(int));
+}
+
+}  // namespace dali
@@ -16,7 +16,9 @@
 #define DALI_PIPELINE_DATA_TENSOR_H_
 
 #include <cstring>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -33,6 +35,10 @@ namespace dali {
 /**
  * @brief Stores dense, multi-dimensional data. Provides utilities
  * methods for handling dimensions and shapes of the stored data.
+ *
+ * A cpu Tensor can also be a strided view into the data of another
+ * Tensor (see ShareSlice). Only the ops that accept strided inputs
+ * are given such views, the others get a dense copy of them.
  */
 template <typename Backend>
 class Tensor : public Buffer<Backend> {
@@ -58,6 +64,12 @@ class Tensor : public Buffer<Backend> {
   inline void Copy(const Tensor<InBackend> &other, cudaStream_t stream) {
     this->set_type(other.type());
     this->ResizeLike(other);
+    if (!other.IsDense()) {
+      DALI_ENFORCE((std::is_same<Backend, CPUBackend>::value),
+          "Strided views can only be copied to cpu tensors.");
+      other.CopyDenseTo(this->raw_mutable_data());
+      return;
+    }
     type_.template Copy<Backend, InBackend>(this->raw_mutable_data(),
         other.raw_data(), this->size(), stream);
   }
@@ -86,10 +98,11 @@ class Tensor : public Buffer<Backend> {
    * the current buffer is not large enough for the requested
    * number of elements.
    */
-  inline void Resize(const vector<Index> &shape) {
+  inline void Resize(const TensorShape &shape) {
     Index new_size = Product(shape);
     ResizeHelper(new_size);
     shape_ = shape;
+    strides_.clear();
   }
 
   /**
@@ -122,6 +135,7 @@ class Tensor : public Buffer<Backend> {
 
     // Get the meta-data for the target tensor
     shape_ = tl->tensor_shape(idx);
+    strides_.clear();
     size_ = Product(shape_);
     type_ = tl->type();
     num_bytes_ = type_.size() * size_;
@@ -150,10 +164,12 @@ class Tensor : public Buffer<Backend> {
 
     // Save the tensor meta-data
     shape_ = t->shape_;
+    strides_ = t->strides_;
     size_ = t->size_;
     type_ = t->type_;
     num_bytes_ = t->num_bytes_;
-    shares_data_ = num_bytes_ > 0 ? true : false;
+    // Views have no bytes of their own, but still share data
+    shares_data_ = num_bytes_ > 0 || t->shares_data_;
     device_ = t->device_id();
   }
 
@@ -180,6 +196,7 @@ class Tensor : public Buffer<Backend> {
     num_bytes_ = bytes;
     type_ = TypeInfo::Create<NoType>();
     shape_.clear();
+    strides_.clear();
     size_ = 0;
 
     // If the input pointer stores a non-zero size allocation, mark
@@ -187,6 +204,130 @@ class Tensor : public Buffer<Backend> {
     shares_data_ = num_bytes_ > 0 ? true : false;
   }
 
+  /**
+   * @brief Wraps an allocation owned by `ptr`, e.g. a region of a memory
+   * mapped file. Same as the raw pointer version, except that the Tensor
+   * holds a reference to `ptr`, which keeps the allocation alive for as
+   * long as the Tensor uses it.
+   */
+  inline void ShareData(const shared_ptr<void> &ptr, size_t bytes) {
+    DALI_ENFORCE(ptr != nullptr, "Input pointer must not be nullptr.");
+
+    data_ = ptr;
+    num_bytes_ = bytes;
+    type_ = TypeInfo::Create<NoType>();
+    shape_.clear();
+    strides_.clear();
+    size_ = 0;
+    shares_data_ = num_bytes_ > 0 ? true : false;
+  }
+
+  /**
+   * @brief Stops sharing the data of another object, if the tensor
+   * does. The tensor is left empty, with its type, and allocates its
+   * own storage at the next resize.
+   */
+  inline void UnshareData() {
+    if (!shares_data_) return;
+    data_.reset();
+    num_bytes_ = 0;
+    shape_.clear();
+    strides_.clear();
+    size_ = 0;
+    shares_data_ = false;
+  }
+
+  /**
+   * @brief Makes the tensor a view of the region of `t` that starts
+   * at `anchor` and has the given shape, e.g. a crop of an image.
+   * No data is copied: the view keeps the allocation of `t` alive
+   * and indexes it with the strides of `t`.
+   *
+   * The view must only be read. Resizing it, or setting a type that
+   * does not fit, allocates new memory rather than writing into `t`.
+   */
+  inline void ShareSlice(const Tensor<Backend> &t, const TensorShape &anchor,
+                         const TensorShape &shape) {
+    DALI_ENFORCE(IsValidType(t.type()), "To share data, "
+        "the input Tensor must have a valid data type.");
+    DALI_ENFORCE(anchor.size() == t.shape_.size() && shape.size() == t.shape_.size(),
+        "Slice must have the same number of dimensions as the Tensor.");
+
+    const TensorShape strides = t.IsDense() ? DenseStrides(t.shape_) : t.strides_;
+    Index offset = 0;
+    for (size_t i = 0; i < shape.size(); ++i) {
+      DALI_ENFORCE(anchor[i] >= 0 && shape[i] >= 0 && anchor[i] + shape[i] <= t.shape_[i],
+          "Slice out of the bounds of the Tensor in dimension " + std::to_string(i));
+      offset += anchor[i] * strides[i];
+    }
+
+    // Alias the allocation of `t`, so that it is released only
+    // once both tensors are done with it
+    data_ = shared_ptr<void>(t.data_, static_cast<uint8*>(t.data_.get()) +
+        offset * t.type_.size());
+    shape_ = shape;
+    strides_ = IsDenseLayout(shape, strides) ? TensorShape() : strides;
+    size_ = Product(shape_);
+    type_ = t.type_;
+    num_bytes_ = 0;
+    shares_data_ = true;
+    device_ = t.device_;
+  }
+
+  /**
+   * @brief Returns whether the elements are stored densely, in
+   * row-major order. Only views made by ShareSlice can be strided.
+   */
+  inline bool IsDense() const {
+    return strides_.empty();
+  }
+
+  /**
+   * @brief Returns the distance, in elements, between consecutive
+   * indices of each dimension. Empty for dense tensors.
+   */
+  inline const TensorShape &strides() const {
+    return strides_;
+  }
+
+  /**
+   * @brief Copies the elements of a cpu tensor, which can be a
+   * strided view, to `dst` as a dense tensor of the same shape.
+   */
+  inline void CopyDenseTo(void *dst) const {
+    DALI_ENFORCE((std::is_same<Backend, CPUBackend>::value),
+        "CopyDenseTo is only supported for cpu tensors.");
+    if (IsDense()) {
+      type_.template Copy<CPUBackend, CPUBackend>(dst, this->raw_data(), size_, 0);
+      return;
+    }
+    if (size_ == 0) return;
+
+    // The innermost dimensions that are dense are copied as one run
+    int outer = shape_.size();
+    Index run = 1;
+    while (outer > 0 && (strides_[outer - 1] == run || shape_[outer - 1] == 1)) {
+      run *= shape_[outer - 1];
+      --outer;
+    }
+
+    const uint8 *src = static_cast<const uint8*>(this->raw_data());
+    uint8 *out = static_cast<uint8*>(dst);
+    const size_t elem_size = type_.size();
+    TensorShape pos(outer, 0);
+    for (Index copied = 0; copied < size_; copied += run) {
+      Index offset = 0;
+      for (int i = 0; i < outer; ++i) {
+        offset += pos[i] * strides_[i];
+      }
+      type_.template Copy<CPUBackend, CPUBackend>(out + copied * elem_size,
+          src + offset * elem_size, run, 0);
+      for (int i = outer - 1; i >= 0 && ++pos[i] == shape_[i]; --i) {
+        pos[i] = 0;
+      }
+    }
+  }
+
   /**
    * @brief Wraps a TensorList
    * TensorList has to be a valid tensor
@@ -207,6 +348,7 @@ class Tensor : public Buffer<Backend> {
     // Get the meta-data for the target tensor
     shape_ = tl->tensor_shape(0);
     shape_.insert(shape_.begin(), tl->ntensor());
+    strides_.clear();
     size_ = Product(shape_);
     type_ = tl->type();
     num_bytes_ = type_.size() * size_;
@@ -217,7 +359,7 @@ class Tensor : public Buffer<Backend> {
   /**
    * @brief Returns the shape of the Tensor
    */
-  inline vector<Index> shape() const {
+  inline const TensorShape &shape() const {
     return shape_;
   }
 
@@ -244,6 +386,14 @@ class Tensor : public Buffer<Backend> {
    * of a Tensor
    */
   inline void Squeeze() {
+    if (!IsDense()) {
+      // Drop the strides of the removed dimensions too
+      TensorShape strides;
+      for (size_t i = 0; i < shape_.size(); ++i) {
+        if (shape_[i] != 1) strides.push_back(strides_[i]);
+      }
+      strides_ = std::move(strides);
+    }
     shape_.erase(std::remove(shape_.begin(), shape_.end(), 1), shape_.end());
     if (shape_.empty()) {
       shape_.push_back(1);
@@ -270,6 +420,7 @@ class Tensor : public Buffer<Backend> {
   Tensor<Backend>(Tensor<Backend> &&t) noexcept {
     // Steal all data and set input to default state
     shape_ = std::move(t.shape_);
+    strides_ = std::move(t.strides_);
     backend_ = t.backend_;
     type_ = t.type_;
     data_ = t.data_;
@@ -277,8 +428,11 @@ class Tensor : public Buffer<Backend> {
     shares_data_ = t.shares_data_;
     num_bytes_ = t.num_bytes_;
     device_ = t.device_;
+    policy_ = t.policy_;
+    memory_tag_ = t.memory_tag_;
 
     t.shape_.clear();
+    t.strides_.clear();
     t.backend_ = Backend();
     t.type_ = TypeInfo::Create<NoType>();
     t.data_.reset();
@@ -290,6 +444,7 @@ class Tensor : public Buffer<Backend> {
   Tensor<Backend>& operator=(Tensor<Backend> &&t) noexcept {
     if (&t != this) {
       shape_ = std::move(t.shape_);
+      strides_ = std::move(t.strides_);
       backend_ = t.backend_;
       type_ = t.type_;
       data_ = t.data_;
@@ -297,9 +452,12 @@ class Tensor : public Buffer<Backend> {
       shares_data_ = t.shares_data_;
       num_bytes_ = t.num_bytes_;
       device_ = t.device_;
+      policy_ = t.policy_;
+      memory_tag_ = t.memory_tag_;
 
 
       t.shape_.clear();
+      t.strides_.clear();
       t.backend_ = Backend();
       t.type_ = TypeInfo::Create<NoType>();
       t.data_.reset();
@@ -318,16 +476,45 @@ class Tensor : public Buffer<Backend> {
     meta_.SetLayout(layout);
   }
 
+  /**
+   * @brief Returns where the data was read from, for error messages.
+   */
   inline string GetSourceInfo() const {
+    return meta_.GetSourceInfo().str();
+  }
+
+  inline const SourceInfo &source_info() const {
     return meta_.GetSourceInfo();
   }
 
-  inline void SetSourceInfo(string source_info) {
+  inline void SetSourceInfo(const SourceInfo &source_info) {
     meta_.SetSourceInfo(source_info);
   }
 
  protected:
-  vector<Index> shape_;
+  // Strides of the dense tensors of the given shape
+  static inline TensorShape DenseStrides(const TensorShape &shape) {
+    TensorShape strides(shape.size(), 1);
+    for (int i = static_cast<int>(shape.size()) - 2; i >= 0; --i) {
+      strides[i] = strides[i + 1] * shape[i + 1];
+    }
+    return strides;
+  }
+
+  // Whether the strides address the elements densely. The
+  // strides of the dimensions of extent 1 do not matter.
+  static inline bool IsDenseLayout(const TensorShape &shape, const TensorShape &strides) {
+    Index expected = 1;
+    for (int i = static_cast<int>(shape.size()) - 1; i >= 0; --i) {
+      if (shape[i] != 1 && strides[i] != expected) return false;
+      expected *= shape[i];
+    }
+    return true;
+  }
+
+  TensorShape shape_;
+  // Empty unless the tensor is a strided view
+  TensorShape strides_;
   DALIMeta meta_;
   USE_BUFFER_MEMBERS();
 };
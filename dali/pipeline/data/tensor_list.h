@@ -27,7 +27,7 @@ namespace dali {
 template <typename Backend>
 class Tensor;
 
-typedef vector<Index> Dims;
+typedef TensorShape Dims;
 
 /**
  * @brief Stores a number of Tensors in a contiguous buffer.
@@ -245,7 +245,7 @@ class DLL_PUBLIC TensorList : public Buffer<Backend> {
   /**
    * @brief Return the shape of the tensor with the given index.
    */
-  inline vector<Index> tensor_shape(int idx) const {
+  inline const Dims &tensor_shape(int idx) const {
 #ifndef NDEBUG
     DALI_ENFORCE(idx >= 0, "Negative index not supported");
     DALI_ENFORCE((size_t)idx < shape_.size(), "Index out of offset range");
@@ -256,7 +256,7 @@ class DLL_PUBLIC TensorList : public Buffer<Backend> {
   /**
    * @brief Returns the shape of the entire TensorList.
    */
-  inline vector<Dims> shape() const {
+  inline const vector<Dims> &shape() const {
     return shape_;
   }
 
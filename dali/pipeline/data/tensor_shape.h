@@ -0,0 +1,227 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_DATA_TENSOR_SHAPE_H_
+#define DALI_PIPELINE_DATA_TENSOR_SHAPE_H_
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/error_handling.h"
+
+namespace dali {
+
+/**
+ * @brief Shape of a tensor. Behaves like a vector<Index>, but keeps up
+ * to kInlineDims dimensions inline, so that creating, copying and
+ * comparing the shapes of the samples does not touch the heap.
+ *
+ * It converts implicitly from and to vector<Index> for the code that
+ * still uses them, the conversion to a vector allocates.
+ */
+class DLL_PUBLIC TensorShape {
+ public:
+  typedef Index value_type;
+  typedef Index *iterator;
+  typedef const Index *const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  static const size_t kInlineDims = 6;
+
+  inline TensorShape() = default;
+
+  inline TensorShape(std::initializer_list<Index> dims) {
+    assign(dims.begin(), dims.end());
+  }
+
+  inline explicit TensorShape(size_t ndim, Index value = 0) {
+    resize(ndim, value);
+  }
+
+  inline TensorShape(const vector<Index> &dims) {  // NOLINT(runtime/explicit)
+    assign(dims.begin(), dims.end());
+  }
+
+  inline TensorShape(const TensorShape &other) {
+    assign(other.begin(), other.end());
+  }
+
+  inline TensorShape(TensorShape &&other) noexcept {
+    *this = std::move(other);
+  }
+
+  inline TensorShape &operator=(const TensorShape &other) {
+    if (this != &other) {
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  inline TensorShape &operator=(TensorShape &&other) noexcept {
+    if (this == &other) return *this;
+    if (other.heap_) {
+      heap_ = std::move(other.heap_);
+      capacity_ = other.capacity_;
+    } else {
+      heap_.reset();
+      capacity_ = kInlineDims;
+      std::copy(other.inline_, other.inline_ + other.size_, inline_);
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+    other.capacity_ = kInlineDims;
+    return *this;
+  }
+
+  inline operator vector<Index>() const {
+    return vector<Index>(begin(), end());
+  }
+
+  template <typename It>
+  inline void assign(It first, It last) {
+    const size_t n = std::distance(first, last);
+    clear();
+    reserve(n);
+    std::copy(first, last, data());
+    size_ = n;
+  }
+
+  inline size_t size() const { return size_; }
+  inline bool empty() const { return size_ == 0; }
+  inline size_t capacity() const { return capacity_; }
+
+  inline Index *data() { return heap_ ? heap_.get() : inline_; }
+  inline const Index *data() const { return heap_ ? heap_.get() : inline_; }
+
+  inline Index &operator[](size_t idx) { return data()[idx]; }
+  inline const Index &operator[](size_t idx) const { return data()[idx]; }
+
+  inline Index &at(size_t idx) {
+    DALI_ENFORCE(idx < size_, "Index " + std::to_string(idx) +
+        " out of range for a shape of " + std::to_string(size_) + " dims");
+    return data()[idx];
+  }
+
+  inline const Index &at(size_t idx) const {
+    return const_cast<TensorShape*>(this)->at(idx);
+  }
+
+  inline Index &front() { return data()[0]; }
+  inline const Index &front() const { return data()[0]; }
+  inline Index &back() { return data()[size_ - 1]; }
+  inline const Index &back() const { return data()[size_ - 1]; }
+
+  inline iterator begin() { return data(); }
+  inline iterator end() { return data() + size_; }
+  inline const_iterator begin() const { return data(); }
+  inline const_iterator end() const { return data() + size_; }
+  inline const_iterator cbegin() const { return begin(); }
+  inline const_iterator cend() const { return end(); }
+  inline reverse_iterator rbegin() { return reverse_iterator(end()); }
+  inline reverse_iterator rend() { return reverse_iterator(begin()); }
+  inline const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  inline const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+  inline void reserve(size_t n) {
+    if (n <= capacity_) return;
+    const size_t new_capacity = std::max(n, 2 * capacity_);
+    std::unique_ptr<Index[]> heap(new Index[new_capacity]);
+    std::copy(begin(), end(), heap.get());
+    heap_ = std::move(heap);
+    capacity_ = new_capacity;
+  }
+
+  inline void resize(size_t n, Index value = 0) {
+    reserve(n);
+    if (n > size_) {
+      std::fill(data() + size_, data() + n, value);
+    }
+    size_ = n;
+  }
+
+  inline void clear() { size_ = 0; }
+
+  inline void push_back(Index value) {
+    reserve(size_ + 1);
+    data()[size_++] = value;
+  }
+
+  inline void pop_back() { --size_; }
+
+  inline iterator insert(const_iterator pos, Index value) {
+    const size_t idx = pos - begin();
+    reserve(size_ + 1);
+    Index *d = data();
+    std::copy_backward(d + idx, d + size_, d + size_ + 1);
+    d[idx] = value;
+    ++size_;
+    return d + idx;
+  }
+
+  inline iterator erase(const_iterator first, const_iterator last) {
+    const size_t idx = first - begin();
+    const size_t count = last - first;
+    Index *d = data();
+    std::copy(d + idx + count, d + size_, d + idx);
+    size_ -= count;
+    return d + idx;
+  }
+
+  inline iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+  }
+
+ private:
+  size_t size_ = 0;
+  size_t capacity_ = kInlineDims;
+  Index inline_[kInlineDims];
+  // Only used by the shapes of more than kInlineDims dims
+  std::unique_ptr<Index[]> heap_;
+};
+
+inline bool operator==(const TensorShape &a, const TensorShape &b) {
+  return a.size() == b.size() &&
+      std::memcmp(a.data(), b.data(), a.size() * sizeof(Index)) == 0;
+}
+
+inline bool operator!=(const TensorShape &a, const TensorShape &b) {
+  return !(a == b);
+}
+
+// Helper function to get product of dims
+inline Index Product(const TensorShape &shape) {
+  if (shape.size() == 0) return 0;
+  Index product = 1;
+  for (Index dim : shape) product *= dim;
+  return product;
+}
+
+// Helper function to get a string of the data shape
+inline string ShapeString(const TensorShape &shape) {
+  string tmp;
+  for (auto &val : shape) tmp += std::to_string(val) + " ";
+  return tmp;
+}
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_DATA_TENSOR_SHAPE_H_
@@ -0,0 +1,94 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/tensor_shape.h"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+namespace dali {
+
+TEST(TensorShapeTest, TestInline) {
+  TensorShape shape = {480, 640, 3};
+  ASSERT_EQ(shape.size(), 3);
+  ASSERT_EQ(shape.capacity(), static_cast<size_t>(TensorShape::kInlineDims));
+  ASSERT_EQ(shape[0], 480);
+  ASSERT_EQ(shape.back(), 3);
+  ASSERT_EQ(Product(shape), 480 * 640 * 3);
+  ASSERT_EQ(Product(TensorShape()), 0);
+  ASSERT_EQ(ShapeString(shape), "480 640 3 ");
+}
+
+TEST(TensorShapeTest, TestHeap) {
+  TensorShape shape;
+  for (Index i = 0; i < 10; ++i) {
+    shape.push_back(i + 1);
+  }
+  ASSERT_EQ(shape.size(), 10);
+  ASSERT_GE(shape.capacity(), 10);
+  for (Index i = 0; i < 10; ++i) {
+    ASSERT_EQ(shape[i], i + 1);
+  }
+
+  // Copies are deep, moves steal the buffer
+  TensorShape copy(shape);
+  ASSERT_EQ(copy, shape);
+  ASSERT_NE(copy.data(), shape.data());
+  const Index *data = shape.data();
+  TensorShape moved(std::move(shape));
+  ASSERT_EQ(moved.data(), data);
+  ASSERT_EQ(moved, copy);
+  ASSERT_TRUE(shape.empty());
+
+  // Shrinking keeps the values
+  moved.resize(2);
+  ASSERT_EQ(moved, TensorShape({1, 2}));
+  TensorShape small = {1, 2};
+  small = std::move(moved);
+  ASSERT_EQ(small, TensorShape({1, 2}));
+}
+
+TEST(TensorShapeTest, TestInsertErase) {
+  TensorShape shape = {1, 5, 1, 7};
+  shape.insert(shape.begin(), 3);
+  ASSERT_EQ(shape, TensorShape({3, 1, 5, 1, 7}));
+
+  // Same as Tensor::Squeeze()
+  for (auto it = shape.begin(); it != shape.end();) {
+    if (*it == 1) {
+      it = shape.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ASSERT_EQ(shape, TensorShape({3, 5, 7}));
+
+  shape.erase(shape.begin(), shape.begin() + 2);
+  ASSERT_EQ(shape, TensorShape({7}));
+  ASSERT_NE(shape, TensorShape({7, 7}));
+  ASSERT_NE(shape, TensorShape({8}));
+}
+
+TEST(TensorShapeTest, TestVectorConversion) {
+  vector<Index> dims = {2, 3, 4, 5, 6, 7, 8};
+  TensorShape shape = dims;
+  ASSERT_EQ(shape.size(), dims.size());
+  vector<Index> back = shape;
+  ASSERT_EQ(back, dims);
+  ASSERT_EQ(shape, TensorShape(dims));
+}
+
+}  // namespace dali
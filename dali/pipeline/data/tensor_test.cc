@@ -16,12 +16,53 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/buffer.h"
+#include "dali/pipeline/operators/op_spec.h"
 #include "dali/test/dali_test.h"
 
 namespace dali {
 
+// Checks that every allocation is freed with the size it was made with
+class SizeCheckingCPUAllocator : public CPUAllocator {
+ public:
+  explicit SizeCheckingCPUAllocator(const OpSpec &spec) : CPUAllocator(spec) {}
+
+  void New(void **ptr, size_t bytes) override {
+    CPUAllocator::New(ptr, bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    sizes_[*ptr] = bytes;
+  }
+
+  void Delete(void *ptr, size_t bytes) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = sizes_.find(ptr);
+      if (it != sizes_.end()) {
+        if (it->second != bytes) ++mismatches_;
+        sizes_.erase(it);
+      }
+    }
+    CPUAllocator::Delete(ptr, bytes);
+  }
+
+  static int mismatches() { return mismatches_; }
+
+ private:
+  static std::mutex mutex_;
+  static std::unordered_map<void*, size_t> sizes_;
+  static int mismatches_;
+};
+
+std::mutex SizeCheckingCPUAllocator::mutex_;
+std::unordered_map<void*, size_t> SizeCheckingCPUAllocator::sizes_;
+int SizeCheckingCPUAllocator::mismatches_ = 0;
+
 template <typename Backend>
 class TensorTest : public DALITest {
  public:
@@ -418,4 +459,147 @@ TYPED_TEST(TensorTest, TestTypeChange) {
   ASSERT_EQ(nbytes / sizeof(float) * sizeof(double), tensor.nbytes());
 }
 
+TYPED_TEST(TensorTest, TestGrowthPolicy) {
+  Tensor<TypeParam> tensor;
+  BufferPolicy policy;
+  policy.growth_factor = 1.5;
+  policy.alignment = 256;
+  tensor.set_policy(policy);
+
+  tensor.Resize({1000});
+  tensor.template mutable_data<uint8>();
+  ASSERT_EQ(tensor.capacity(), 1536);
+  const void *ptr = tensor.raw_data();
+
+  // Growing within the allocation does not reallocate
+  tensor.Resize({1500});
+  ASSERT_EQ(tensor.raw_data(), ptr);
+  ASSERT_EQ(tensor.capacity(), 1536);
+
+  tensor.Resize({1537});
+  ASSERT_EQ(tensor.capacity(), 2560);
+}
+
+TYPED_TEST(TensorTest, TestShrinkPolicy) {
+  Tensor<TypeParam> tensor;
+  BufferPolicy policy;
+  policy.shrink_after = 3;
+  policy.shrink_threshold = 0.5;
+  tensor.set_policy(policy);
+
+  tensor.Resize({10000});
+  tensor.template mutable_data<uint8>();
+  ASSERT_EQ(tensor.capacity(), 10000);
+
+  // A resize to the same size or to more than the threshold
+  // does not count towards the shrink
+  tensor.Resize({100});
+  tensor.Resize({200});
+  tensor.Resize({200});
+  tensor.Resize({6000});
+  tensor.Resize({100});
+  tensor.Resize({200});
+  ASSERT_EQ(tensor.capacity(), 10000);
+
+  tensor.Resize({300});
+  ASSERT_EQ(tensor.capacity(), 300);
+  ASSERT_EQ(tensor.size(), 300);
+
+  // Never shrinks with the default policy
+  tensor.set_policy(BufferPolicy());
+  tensor.Resize({10000});
+  for (int i = 0; i < 10; ++i) {
+    tensor.Resize({100 + i});
+  }
+  ASSERT_EQ(tensor.capacity(), 10000);
+}
+
+TEST(TensorViewTest, TestShareSlice) {
+  Tensor<CPUBackend> image;
+  image.Resize({4, 5, 3});
+  uint8 *data = image.mutable_data<uint8>();
+  for (int i = 0; i < 4 * 5 * 3; ++i) {
+    data[i] = i;
+  }
+
+  // Crop of rows 1-2 and columns 2-4
+  Tensor<CPUBackend> crop;
+  crop.ShareSlice(image, {1, 2, 0}, {2, 3, 3});
+  ASSERT_TRUE(crop.shares_data());
+  ASSERT_FALSE(crop.IsDense());
+  ASSERT_EQ(crop.shape(), TensorShape({2, 3, 3}));
+  ASSERT_EQ(crop.strides(), TensorShape({15, 3, 1}));
+  ASSERT_EQ(crop.data<uint8>(), data + (1 * 5 + 2) * 3);
+
+  Tensor<CPUBackend> dense;
+  dense.Copy(crop, 0);
+  ASSERT_TRUE(dense.IsDense());
+  ASSERT_EQ(dense.shape(), crop.shape());
+  for (int h = 0; h < 2; ++h) {
+    for (int w = 0; w < 3; ++w) {
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(dense.data<uint8>()[(h * 3 + w) * 3 + c], ((h + 1) * 5 + w + 2) * 3 + c);
+      }
+    }
+  }
+
+  // Full rows are dense
+  Tensor<CPUBackend> rows;
+  rows.ShareSlice(image, {2, 0, 0}, {2, 5, 3});
+  ASSERT_TRUE(rows.IsDense());
+  ASSERT_EQ(rows.data<uint8>(), data + 2 * 5 * 3);
+
+  // A view of the view keeps the image alive
+  Tensor<CPUBackend> pixel;
+  pixel.ShareSlice(crop, {1, 1, 0}, {1, 1, 3});
+  ASSERT_EQ(pixel.data<uint8>(), data + (2 * 5 + 3) * 3);
+  image.Resize({100, 100, 3});
+  image.mutable_data<uint8>();
+  crop.Resize({2, 3, 3});
+  ASSERT_FALSE(crop.shares_data());
+  ASSERT_TRUE(crop.IsDense());
+  ASSERT_NE(crop.data<uint8>(), pixel.data<uint8>());
+  uint8 rgb[3];
+  pixel.CopyDenseTo(rgb);
+  ASSERT_EQ(rgb[0], (2 * 5 + 3) * 3);
+  ASSERT_EQ(rgb[2], (2 * 5 + 3) * 3 + 2);
+
+  ASSERT_THROW(crop.ShareSlice(image, {99, 0, 0}, {2, 1, 3}), std::runtime_error);
+}
+
+// Sets the CPU allocator for its scope, and puts back the one it replaced
+class ScopedCPUAllocator {
+ public:
+  explicit ScopedCPUAllocator(std::unique_ptr<CPUAllocator> allocator)
+    : previous_(SetCPUAllocator(std::move(allocator))) {}
+
+  ~ScopedCPUAllocator() {
+    SetCPUAllocator(std::move(previous_));
+  }
+
+ private:
+  std::unique_ptr<CPUAllocator> previous_;
+};
+
+TEST(TensorPolicyTest, TestFreedWithAllocatedSize) {
+  {
+    ScopedCPUAllocator allocator(std::unique_ptr<CPUAllocator>(
+        new SizeCheckingCPUAllocator(OpSpec("SizeCheckingCPUAllocator"))));
+    Tensor<CPUBackend> tensor;
+    BufferPolicy policy;
+    policy.growth_factor = 1.5;
+    policy.alignment = 256;
+    tensor.set_policy(policy);
+    tensor.set_pinned(false);
+
+    // The allocations are larger than the data they hold
+    tensor.Resize({1000});
+    tensor.mutable_data<float>();
+    ASSERT_GT(tensor.capacity(), tensor.nbytes());
+    tensor.Resize({5000});
+    tensor.mutable_data<float>();
+  }
+  ASSERT_EQ(SizeCheckingCPUAllocator::mismatches(), 0);
+}
+
 }  // namespace dali
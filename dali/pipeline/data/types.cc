@@ -20,7 +20,6 @@
 
 #define DALI_TYPEID_REGISTERER(Type, dtype)                           \
 {                                                                     \
-  std::lock_guard<std::mutex> lock(mutex_);                           \
   static DALIDataType type_id = TypeTable::RegisterType<Type>(dtype); \
   return type_id;                                                     \
 }
@@ -37,50 +36,54 @@ std::unordered_map<size_t, TypeInfo> TypeTable::type_info_map_;
 int TypeTable::index_ = DALI_DATATYPE_END;
 
 template <>
-void TypeInfo::Construct<CPUBackend>(void *ptr, Index n) {
-  // Call our constructor function
-  constructor_(ptr, n);
+void TypeInfo::Construct<CPUBackend>(void *ptr, Index n) const {
+  // Call our constructor function, if the type has one
+  if (constructor_) constructor_(ptr, n);
 }
 
 template <>
-void TypeInfo::Construct<GPUBackend>(void *, Index) {
+void TypeInfo::Construct<GPUBackend>(void *, Index) const {
   // NoOp. GPU types must not require constructor
 }
 
 template <>
-void TypeInfo::Destruct<CPUBackend>(void *ptr, Index n) {
-  // Call our destructor function
-  destructor_(ptr, n);
+void TypeInfo::Destruct<CPUBackend>(void *ptr, Index n) const {
+  // Call our destructor function, if the type has one
+  if (destructor_) destructor_(ptr, n);
 }
 
 template <>
-void TypeInfo::Destruct<GPUBackend>(void *, Index) {
+void TypeInfo::Destruct<GPUBackend>(void *, Index) const {
   // NoOp. GPU types must not require destructor
 }
 
 template <>
 void TypeInfo::Copy<CPUBackend, CPUBackend>(void *dst,
-    const void *src, Index n, cudaStream_t /* unused */) {
-  // Call our copy function
-  copier_(dst, src, n);
+    const void *src, Index n, cudaStream_t /* unused */) const {
+  if (copier_) {
+    copier_(dst, src, n);
+  } else {
+    // Trivially copyable, we can copy using raw memcopy
+    std::memcpy(dst, src, n*size());
+  }
 }
 
 // For any GPU related copy, we do a plain memcpy
 template <>
 void TypeInfo::Copy<CPUBackend, GPUBackend>(void *dst,
-    const void *src, Index n, cudaStream_t stream) {
+    const void *src, Index n, cudaStream_t stream) const {
   MemCopy(dst, src, n*size(), stream);
 }
 
 template <>
 void TypeInfo::Copy<GPUBackend, CPUBackend>(void *dst,
-    const void *src, Index n, cudaStream_t stream) {
+    const void *src, Index n, cudaStream_t stream) const {
   MemCopy(dst, src, n*size(), stream);
 }
 
 template <>
 void TypeInfo::Copy<GPUBackend, GPUBackend>(void *dst,
-    const void *src, Index n, cudaStream_t stream) {
+    const void *src, Index n, cudaStream_t stream) const {
   MemCopy(dst, src, n*size(), stream);
 }
 
@@ -15,12 +15,16 @@
 #ifndef DALI_PIPELINE_DATA_TYPES_H_
 #define DALI_PIPELINE_DATA_TYPES_H_
 
-// workaround missing "is_trivially_copyable" in g++ < 5.0
+// workaround missing "is_trivially_copyable" and
+// "is_trivially_default_constructible" in g++ < 5.0
 #if __cplusplus && __GNUC__ < 5 && !__clang__
+#include <boost/type_traits/has_trivial_constructor.hpp>
 #include <boost/type_traits/has_trivial_copy.hpp>
 #define IS_TRIVIALLY_COPYABLE(T) ::boost::has_trivial_copy<T>::value
+#define IS_TRIVIALLY_CONSTRUCTIBLE(T) ::boost::has_trivial_constructor<T>::value
 #else
 #define IS_TRIVIALLY_COPYABLE(T) std::is_trivially_copyable<T>::value
+#define IS_TRIVIALLY_CONSTRUCTIBLE(T) std::is_trivially_default_constructible<T>::value
 #endif
 
 #include <cstdint>
@@ -30,6 +34,7 @@
 
 #include <functional>
 #include <mutex>
+#include <type_traits>
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
@@ -86,7 +91,9 @@ enum DALIDataType {
 // Dummy type to represent the invalid default state of dali types.
 struct NoType {};
 
-// Stores the unqiue ID for a type and its size in bytes
+// Stores the unqiue ID for a type and its size in bytes. Copying
+// it is cheap: the functions of the type are plain pointers, left
+// null for the types that do not need them, and the name is shared.
 class DLL_PUBLIC TypeInfo {
  public:
   DLL_PUBLIC inline TypeInfo() {
@@ -104,13 +111,13 @@ class DLL_PUBLIC TypeInfo {
   DLL_PUBLIC inline void SetType(DALIDataType dtype = DALI_NO_TYPE);
 
   template <typename Backend>
-  DLL_PUBLIC void Construct(void *ptr, Index n);
+  DLL_PUBLIC void Construct(void *ptr, Index n) const;
 
   template <typename Backend>
-  DLL_PUBLIC void Destruct(void *ptr, Index n);
+  DLL_PUBLIC void Destruct(void *ptr, Index n) const;
 
   template <typename DstBackend, typename SrcBackend>
-  DLL_PUBLIC void Copy(void *dst, const void *src, Index n, cudaStream_t stream);
+  DLL_PUBLIC void Copy(void *dst, const void *src, Index n, cudaStream_t stream) const;
 
   DLL_PUBLIC inline DALIDataType id() const {
     return id_;
@@ -121,13 +128,13 @@ class DLL_PUBLIC TypeInfo {
   }
 
   DLL_PUBLIC inline const string &name() const {
-    return name_;
+    return *name_;
   }
 
   DLL_PUBLIC inline bool operator==(const TypeInfo &rhs) const {
     if ((rhs.id_ == id_) &&
         (rhs.type_size_ == type_size_) &&
-        (rhs.name_ == name_)) {
+        (rhs.name_ == name_ || *rhs.name_ == *name_)) {
       return true;
     }
     return false;
@@ -135,7 +142,7 @@ class DLL_PUBLIC TypeInfo {
 
  private:
   template <typename T>
-  inline void ConstructorFunc(void *ptr, Index n) {
+  static void ConstructorFunc(void *ptr, Index n) {
     T *typed_ptr = static_cast<T*>(ptr);
     for (Index i = 0; i < n; ++i) {
       new (typed_ptr + i) T;
@@ -143,7 +150,7 @@ class DLL_PUBLIC TypeInfo {
   }
 
   template <typename T>
-  inline void DestructorFunc(void *ptr, Index n) {
+  static void DestructorFunc(void *ptr, Index n) {
     T *typed_ptr = static_cast<T*>(ptr);
     for (Index i = 0; i < n; ++i) {
       typed_ptr[i].~T();
@@ -151,15 +158,7 @@ class DLL_PUBLIC TypeInfo {
   }
 
   template <typename T>
-  inline typename std::enable_if<IS_TRIVIALLY_COPYABLE(T)>::type
-  CopyFunc(void *dst, const void *src, Index n) {
-    // T is trivially copyable, we can copy using raw memcopy
-    std::memcpy(dst, src, n*sizeof(T));
-  }
-
-  template <typename T>
-  inline typename std::enable_if<!IS_TRIVIALLY_COPYABLE(T)>::type
-  CopyFunc(void *dst, const void *src, Index n) {
+  static void CopyFunc(void *dst, const void *src, Index n) {
     T *typed_dst = static_cast<T*>(dst);
     const T* typed_src = static_cast<const T*>(src);
     for (Index i = 0; i < n; ++i) {
@@ -169,17 +168,19 @@ class DLL_PUBLIC TypeInfo {
     }
   }
 
-  typedef std::function<void (void*, Index)> Constructor;
-  typedef std::function<void (void*, Index)> Destructor;
-  typedef std::function<void (void *, const void*, Index)> Copier;
+  typedef void (*Constructor)(void*, Index);
+  typedef void (*Destructor)(void*, Index);
+  typedef void (*Copier)(void *, const void*, Index);
 
+  // Null when the type is trivially constructible, destructible
+  // or copyable respectively
   Constructor constructor_;
   Destructor destructor_;
   Copier copier_;
 
   DALIDataType id_;
   size_t type_size_;
-  string name_;
+  const string *name_;
 };
 
 template <typename T>
@@ -196,8 +197,8 @@ class DLL_PUBLIC TypeTable {
  public:
   template <typename T>
   DLL_PUBLIC static DALIDataType GetTypeID() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    static DALIDataType type_id = TypeTable::RegisterType<T>(static_cast<DALIDataType>(++index_));
+    // Only the first call registers the type and takes the lock
+    static DALIDataType type_id = TypeTable::RegisterType<T>(NewTypeID());
     return type_id;
   }
 
@@ -218,10 +219,14 @@ class DLL_PUBLIC TypeTable {
   // TypeTable should only be referenced through its static members
   TypeTable();
 
+  static DALIDataType NewTypeID() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<DALIDataType>(++index_);
+  }
+
   template <typename T>
   static DALIDataType RegisterType(DALIDataType dtype) {
-    // Use only when already guarded by the mutex to
-    // avoid races when used from multiple threads
+    std::lock_guard<std::mutex> lock(mutex_);
 
     // Check the map for this types id
     auto id_it = type_map_.find(typeid(T));
@@ -270,16 +275,14 @@ void TypeInfo::SetType(DALIDataType dtype) {
   } else {
     id_ = DALI_NO_TYPE;
   }
-  name_ = TypeTable::GetTypeName<T>();
+  static const string name = TypeTable::GetTypeName<T>();
+  name_ = &name;
 
   // Get constructor/destructor/copier for this type
-  constructor_ = std::bind(&TypeInfo::ConstructorFunc<T>,
-      this, std::placeholders::_1, std::placeholders::_2);
-  destructor_ = std::bind(&TypeInfo::DestructorFunc<T>,
-      this, std::placeholders::_1, std::placeholders::_2);
-  copier_ = std::bind(&TypeInfo::CopyFunc<T>,
-      this, std::placeholders::_1, std::placeholders::_2,
-      std::placeholders::_3);
+  constructor_ = IS_TRIVIALLY_CONSTRUCTIBLE(T) ? nullptr : &TypeInfo::ConstructorFunc<T>;
+  destructor_ = std::is_trivially_destructible<T>::value ?
+      nullptr : &TypeInfo::DestructorFunc<T>;
+  copier_ = IS_TRIVIALLY_COPYABLE(T) ? nullptr : &TypeInfo::CopyFunc<T>;
 }
 
 inline std::string to_string(const DALIDataType& dtype) {
@@ -290,14 +293,14 @@ inline std::string to_string(const DALIDataType& dtype) {
  * @brief Utility to check types
  */
 template <typename T>
-DLL_PUBLIC inline bool IsType(TypeInfo type) {
+DLL_PUBLIC inline bool IsType(const TypeInfo &type) {
   return type.id() == TypeTable::GetTypeID<T>();
 }
 
 /**
  * @brief Utility to check for valid type
  */
-DLL_PUBLIC inline bool IsValidType(TypeInfo type) {
+DLL_PUBLIC inline bool IsValidType(const TypeInfo &type) {
   return !IsType<NoType>(type);
 }
 
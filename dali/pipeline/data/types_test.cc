@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "dali/pipeline/data/backend.h"
 #include "dali/test/dali_test.h"
 
 namespace dali {
@@ -87,4 +88,32 @@ TYPED_TEST(TypesTest, TestRegisteredType) {
   ASSERT_EQ(type.name(), this->TypeName());
 }
 
+TEST(TypeInfoTest, TestCopy) {
+  // Trivially copyable types are copied with memcpy
+  auto float_type = TypeInfo::Create<float>();
+  float float_src[3] = {1.f, 2.f, 3.f}, float_dst[3];
+  float_type.Copy<CPUBackend, CPUBackend>(float_dst, float_src, 3, 0);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(float_dst[i], float_src[i]);
+  }
+
+  // Other types are constructed, copied and destroyed one by one
+  auto string_type = TypeInfo::Create<std::string>();
+  std::string string_src[2] = {"first", std::string(100, 'x')};
+  void *string_dst = ::operator new(2 * sizeof(std::string));
+  string_type.Construct<CPUBackend>(string_dst, 2);
+  string_type.Copy<CPUBackend, CPUBackend>(string_dst, string_src, 2, 0);
+  ASSERT_EQ(static_cast<std::string*>(string_dst)[0], string_src[0]);
+  ASSERT_EQ(static_cast<std::string*>(string_dst)[1], string_src[1]);
+  string_type.Destruct<CPUBackend>(string_dst, 2);
+  ::operator delete(string_dst);
+
+  // Copies of a TypeInfo are the same type
+  TypeInfo copy = string_type;
+  ASSERT_TRUE(copy == string_type);
+  ASSERT_FALSE(copy == float_type);
+  ASSERT_EQ(copy.name(), "string");
+  ASSERT_EQ(copy.id(), DALI_STRING);
+}
+
 }  // namespace dali
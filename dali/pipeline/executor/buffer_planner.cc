@@ -0,0 +1,171 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/executor/buffer_planner.h"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace dali {
+
+const int BufferPlanner::kEndOfIteration;
+
+void BufferPlanner::Plan(OpGraph *graph, const vector<string> &persistent_tensors) {
+  std::set<string> persistent(persistent_tensors.begin(), persistent_tensors.end());
+  outputs_.clear();
+  outputs_.resize(graph->NumCPUOp());
+  num_buffers_ = 0;
+
+  // Buffers whose outputs are no longer used, and the
+  // buffers in use with the last use of their output
+  vector<int> free_buffers;
+  vector<std::pair<int, int>> used_buffers;
+  for (int i = 0; i < graph->NumCPUOp(); ++i) {
+    // Outputs last read by the previous ops are dead
+    auto dead = std::partition(used_buffers.begin(), used_buffers.end(),
+        [i](const std::pair<int, int> &used) { return used.first >= i; });
+    for (auto it = dead; it != used_buffers.end(); ++it) {
+      free_buffers.push_back(it->second);
+    }
+    used_buffers.erase(dead, used_buffers.end());
+
+    const OpSpec &spec = graph->cpu_node(i).spec;
+    const OpSchema &schema = SchemaRegistry::GetSchema(spec.name());
+    // Output j can be written over input j
+    const bool in_place = schema.SupportsInPlace(spec) &&
+      spec.NumRegularInput() == spec.NumOutput();
+    const bool view = schema.ProducesStridedOutputs(spec);
+    for (int j = 0; j < spec.NumOutput(); ++j) {
+      const string name = spec.Output(j);
+      int last_use = i;
+      if (persistent.count(name) > 0) {
+        last_use = kEndOfIteration;
+      }
+      for (auto &meta : graph->TensorConsumerMeta(name)) {
+        if (graph->NodeType(meta.node) == DALI_CPU) {
+          last_use = std::max<int>(last_use, graph->NodeIdx(meta.node));
+        } else {
+          last_use = kEndOfIteration;
+        }
+      }
+
+      outputs_[i].push_back(OutputPlan());
+      OutputPlan &output = outputs_[i].back();
+      output.last_use = last_use;
+      output.in_place = false;
+      output.view = view;
+      if (view) {
+        output.buffer = num_buffers_++;
+        ExtendInputsLastUse(graph, i, last_use, &used_buffers);
+        continue;
+      }
+      if (last_use == kEndOfIteration) {
+        output.buffer = num_buffers_++;
+        continue;
+      }
+      const int input_buffer = in_place ? InPlaceBuffer(graph, i, j) : -1;
+      if (input_buffer >= 0) {
+        // The input dies with this op, its buffer is passed on to the output
+        auto used = std::find(used_buffers.begin(), used_buffers.end(),
+            std::make_pair(i, input_buffer));
+        DALI_ENFORCE(used != used_buffers.end(), "Input buffer of an in-place op is not in use.");
+        used_buffers.erase(used);
+        output.buffer = input_buffer;
+        output.in_place = true;
+      } else if (free_buffers.empty()) {
+        output.buffer = num_buffers_++;
+      } else {
+        // The buffer freed last is the most likely to be large enough
+        output.buffer = free_buffers.back();
+        free_buffers.pop_back();
+      }
+      used_buffers.emplace_back(last_use, output.buffer);
+    }
+  }
+}
+
+void BufferPlanner::ExtendInputsLastUse(OpGraph *graph, int cpu_op_idx, int last_use,
+    vector<std::pair<int, int>> *used_buffers) {
+  const OpSpec &spec = graph->cpu_node(cpu_op_idx).spec;
+  for (int k = 0; k < spec.NumRegularInput(); ++k) {
+    const NodeID parent_id = graph->TensorSourceID(spec.Input(k));
+    if (graph->NodeType(parent_id) != DALI_CPU) continue;
+    const int parent_idx = graph->NodeIdx(parent_id);
+    OutputPlan &input = outputs_[parent_idx][graph->TensorIdxInSource(spec.Input(k))];
+    if (input.last_use >= last_use) continue;
+
+    if (input.view) {
+      ExtendInputsLastUse(graph, parent_idx, last_use, used_buffers);
+    } else if (input.last_use != kEndOfIteration) {
+      auto used = std::find(used_buffers->begin(), used_buffers->end(),
+          std::make_pair(input.last_use, input.buffer));
+      DALI_ENFORCE(used != used_buffers->end(), "Input buffer of a view is not in use.");
+      if (last_use == kEndOfIteration) {
+        // The buffer is never freed
+        used_buffers->erase(used);
+      } else {
+        used->first = last_use;
+      }
+    }
+    input.last_use = last_use;
+  }
+}
+
+int BufferPlanner::InPlaceBuffer(OpGraph *graph, int cpu_op_idx, int output_idx) const {
+  const string &input_name = graph->cpu_node(cpu_op_idx).spec.Input(output_idx);
+  // The op must be the only reader of the input
+  if (graph->TensorConsumerMeta(input_name).size() != 1) {
+    return -1;
+  }
+  const NodeID parent_id = graph->TensorSourceID(input_name);
+  if (graph->NodeType(parent_id) != DALI_CPU) {
+    return -1;
+  }
+  const OutputPlan &input =
+    outputs_[graph->NodeIdx(parent_id)][graph->TensorIdxInSource(input_name)];
+  // Views have no memory to write into
+  if (input.last_use != cpu_op_idx || input.view) {
+    return -1;
+  }
+  return input.buffer;
+}
+
+size_t BufferPlanner::PeakBytes(const vector<vector<size_t>> &output_bytes) const {
+  DALI_ENFORCE(output_bytes.size() == outputs_.size(),
+      "Expected the sizes of the outputs of every cpu op.");
+  size_t peak = 0;
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    // Outputs live while the i-th op runs
+    size_t live = 0;
+    for (size_t k = 0; k <= i; ++k) {
+      DALI_ENFORCE(output_bytes[k].size() == outputs_[k].size(),
+          "Expected the size of every output of cpu op " + to_string(k) + ".");
+      for (size_t j = 0; j < outputs_[k].size(); ++j) {
+        const OutputPlan &output = outputs_[k][j];
+        // Written over its input, that is already counted
+        if (output.in_place && k == i) continue;
+        // Views hold no data of their own
+        if (output.view) continue;
+        if (output.last_use != kEndOfIteration && output.last_use >= static_cast<int>(i)) {
+          live += output_bytes[k][j];
+        }
+      }
+    }
+    peak = std::max(peak, live);
+  }
+  return peak;
+}
+
+}  // namespace dali
@@ -0,0 +1,126 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_BUFFER_PLANNER_H_
+#define DALI_PIPELINE_EXECUTOR_BUFFER_PLANNER_H_
+
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/pipeline/op_graph.h"
+
+namespace dali {
+
+/**
+ * @brief Plans the per-sample buffers of the outputs of the cpu ops,
+ * so that outputs whose lifetimes do not overlap share a buffer.
+ *
+ * The cpu ops of a sample always run in the order of their index, so
+ * the lifetime of an output spans from its producer to its last cpu
+ * consumer. Outputs consumed by the later stages, and the persistent
+ * tensors given to the planner, live until the end of the iteration
+ * and get a buffer of their own.
+ *
+ * Ops whose schema allows in-place execution write their outputs into
+ * the buffer of the matching input, when they are its only reader.
+ *
+ * Outputs of ops that produce strided views get a buffer of their own,
+ * that holds no data, and their inputs are kept alive as long as them.
+ */
+class DLL_PUBLIC BufferPlanner {
+ public:
+  // Last use of the outputs that live until the end of the iteration
+  static const int kEndOfIteration = std::numeric_limits<int>::max();
+
+  DLL_PUBLIC BufferPlanner() = default;
+
+  /**
+   * @brief Plans the buffers of the cpu ops of `graph`. Tensors named
+   * in `persistent_tensors` are never shared.
+   */
+  DLL_PUBLIC void Plan(OpGraph *graph, const vector<string> &persistent_tensors);
+
+  DLL_PUBLIC inline int NumBuffers() const { return num_buffers_; }
+
+  /**
+   * @brief Returns the index of the buffer of the `output_idx`-th output
+   * of the `cpu_op_idx`-th cpu op.
+   */
+  DLL_PUBLIC inline int BufferIdx(int cpu_op_idx, int output_idx) const {
+    return outputs_[cpu_op_idx][output_idx].buffer;
+  }
+
+  /**
+   * @brief Returns the index of the last cpu op that reads the output,
+   * or kEndOfIteration if it is needed by the later stages.
+   */
+  DLL_PUBLIC inline int LastUse(int cpu_op_idx, int output_idx) const {
+    return outputs_[cpu_op_idx][output_idx].last_use;
+  }
+
+  DLL_PUBLIC inline bool IsShared(int cpu_op_idx, int output_idx) const {
+    return !IsView(cpu_op_idx, output_idx) &&
+      LastUse(cpu_op_idx, output_idx) != kEndOfIteration;
+  }
+
+  /**
+   * @brief Returns whether the output can be a view into the inputs
+   * of the op, in which case its buffer owns no memory.
+   */
+  DLL_PUBLIC inline bool IsView(int cpu_op_idx, int output_idx) const {
+    return outputs_[cpu_op_idx][output_idx].view;
+  }
+
+  /**
+   * @brief Returns whether the output is written over the input
+   * of the op with the same index.
+   */
+  DLL_PUBLIC inline bool IsInPlace(int cpu_op_idx, int output_idx) const {
+    return outputs_[cpu_op_idx][output_idx].in_place;
+  }
+
+  /**
+   * @brief Returns the largest total size of the shareable outputs that
+   * are live at the same time, given the size of each output, indexed
+   * like BufferIdx(). It is the least memory the plan could use.
+   */
+  DLL_PUBLIC size_t PeakBytes(const vector<vector<size_t>> &output_bytes) const;
+
+ private:
+  struct OutputPlan {
+    int buffer;
+    int last_use;
+    bool in_place;
+    bool view;
+  };
+
+  // Returns the buffer the output can share with its input,
+  // or -1 if the input is read after the op or by other ops
+  int InPlaceBuffer(OpGraph *graph, int cpu_op_idx, int output_idx) const;
+
+  // Keeps the buffers of the cpu inputs of the op, and of the inputs
+  // of the views among them, in use until `last_use`
+  void ExtendInputsLastUse(OpGraph *graph, int cpu_op_idx, int last_use,
+                           vector<std::pair<int, int>> *used_buffers);
+
+  vector<vector<OutputPlan>> outputs_;
+  int num_buffers_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_BUFFER_PLANNER_H_
@@ -0,0 +1,304 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/executor/buffer_planner.h"
+
+#include <gtest/gtest.h>
+
+namespace dali {
+
+class BufferPlannerTest : public ::testing::Test {
+ public:
+  inline OpSpec PrepareSpec(OpSpec spec) {
+    spec.AddArg("batch_size", 1)
+      .AddArg("num_threads", 1)
+      .AddArg("cuda_stream", 0)
+      .AddArg("pixels_per_image_hint", 0);
+    return spec;
+  }
+};
+
+TEST_F(BufferPlannerTest, TestCPUOnly) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("external_data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("external_data", "cpu")
+          .AddOutput("copy_data", "cpu")), "");
+
+  BufferPlanner plan;
+  plan.Plan(&graph, {});
+
+  // The copy reads its input while writing its output
+  ASSERT_EQ(plan.NumBuffers(), 2);
+  ASSERT_NE(plan.BufferIdx(0, 0), plan.BufferIdx(1, 0));
+  ASSERT_EQ(plan.LastUse(0, 0), 1);
+  ASSERT_EQ(plan.LastUse(1, 0), 1);
+  ASSERT_EQ(plan.PeakBytes({{10}, {20}}), 30u);
+
+  plan.Plan(&graph, {"copy_data_cpu"});
+  ASSERT_TRUE(plan.IsShared(0, 0));
+  ASSERT_FALSE(plan.IsShared(1, 0));
+  ASSERT_EQ(plan.PeakBytes({{10}, {20}}), 10u);
+}
+
+TEST_F(BufferPlannerTest, TestChain) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("external_data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("external_data", "cpu")
+          .AddOutput("copy_1", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("copy_1", "cpu")
+          .AddOutput("copy_2", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("copy_2", "cpu")
+          .AddOutput("copy_3", "cpu")), "");
+
+  BufferPlanner plan;
+  plan.Plan(&graph, {"copy_3_cpu"});
+
+  // Every other output shares a buffer
+  ASSERT_EQ(plan.NumBuffers(), 3);
+  ASSERT_EQ(plan.BufferIdx(0, 0), plan.BufferIdx(2, 0));
+  ASSERT_NE(plan.BufferIdx(1, 0), plan.BufferIdx(2, 0));
+  ASSERT_NE(plan.BufferIdx(3, 0), plan.BufferIdx(1, 0));
+  ASSERT_NE(plan.BufferIdx(3, 0), plan.BufferIdx(2, 0));
+  ASSERT_EQ(plan.LastUse(3, 0), BufferPlanner::kEndOfIteration);
+  ASSERT_EQ(plan.PeakBytes({{10}, {20}, {30}, {40}}), 50u);
+}
+
+TEST_F(BufferPlannerTest, TestMultipleOutputs) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("DummyOp")
+          .AddArg("device", "cpu")
+          .AddOutput("data_1", "cpu")
+          .AddOutput("data_2", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("DummyOp")
+          .AddArg("device", "cpu")
+          .AddArg("num_outputs", 1)
+          .AddInput("data_2", "cpu")
+          .AddInput("data_1", "cpu")
+          .AddOutput("dummy_out", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("DummyOp")
+          .AddArg("device", "cpu")
+          .AddArg("num_outputs", 1)
+          .AddInput("data_1", "cpu")
+          .AddOutput("dummy_out_two", "cpu")), "");
+
+  BufferPlanner plan;
+  plan.Plan(&graph, {});
+
+  ASSERT_EQ(plan.LastUse(0, 0), 2);
+  ASSERT_EQ(plan.LastUse(0, 1), 1);
+  ASSERT_EQ(plan.LastUse(1, 0), 1);
+  ASSERT_EQ(plan.LastUse(2, 0), 2);
+
+  // Outputs of an op never share a buffer, the last
+  // output reuses one of the buffers freed by the second op
+  ASSERT_EQ(plan.NumBuffers(), 3);
+  ASSERT_NE(plan.BufferIdx(0, 0), plan.BufferIdx(0, 1));
+  ASSERT_NE(plan.BufferIdx(2, 0), plan.BufferIdx(0, 0));
+  ASSERT_EQ(plan.PeakBytes({{1, 2}, {4}, {8}}), 9u);
+}
+
+TEST_F(BufferPlannerTest, TestInPlace) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("external_data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("external_data", "cpu")
+          .AddOutput("copy_1", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("dtype", DALI_INT32)
+          .AddInput("copy_1", "cpu")
+          .AddOutput("cast_1", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("dtype", DALI_FLOAT)
+          .AddInput("cast_1", "cpu")
+          .AddOutput("cast_2", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("cast_2", "cpu")
+          .AddOutput("copy_2", "cpu")), "");
+
+  BufferPlanner plan;
+  plan.Plan(&graph, {"copy_2_cpu"});
+
+  // Both casts write over the output of the first copy
+  ASSERT_EQ(plan.NumBuffers(), 3);
+  ASSERT_FALSE(plan.IsInPlace(1, 0));
+  ASSERT_TRUE(plan.IsInPlace(2, 0));
+  ASSERT_TRUE(plan.IsInPlace(3, 0));
+  ASSERT_FALSE(plan.IsInPlace(4, 0));
+  ASSERT_EQ(plan.BufferIdx(2, 0), plan.BufferIdx(1, 0));
+  ASSERT_EQ(plan.BufferIdx(3, 0), plan.BufferIdx(1, 0));
+  ASSERT_EQ(plan.LastUse(3, 0), 4);
+  ASSERT_EQ(plan.PeakBytes({{10}, {20}, {20}, {20}, {20}}), 30u);
+
+  // Inputs kept until the end of the iteration are never overwritten
+  plan.Plan(&graph, {"copy_1_cpu", "copy_2_cpu"});
+  ASSERT_FALSE(plan.IsInPlace(2, 0));
+  ASSERT_TRUE(plan.IsInPlace(3, 0));
+}
+
+TEST_F(BufferPlannerTest, TestInPlaceMultipleConsumers) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("external_data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("external_data", "cpu")
+          .AddOutput("copy_1", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("dtype", DALI_INT32)
+          .AddInput("copy_1", "cpu")
+          .AddOutput("cast_1", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("copy_1", "cpu")
+          .AddOutput("copy_2", "cpu")), "");
+
+  BufferPlanner plan;
+  plan.Plan(&graph, {"cast_1_cpu", "copy_2_cpu"});
+  ASSERT_FALSE(plan.IsInPlace(2, 0));
+
+  // The input is still read by the second copy
+  plan.Plan(&graph, {"copy_2_cpu"});
+  ASSERT_FALSE(plan.IsInPlace(2, 0));
+  ASSERT_NE(plan.BufferIdx(2, 0), plan.BufferIdx(1, 0));
+}
+
+TEST_F(BufferPlannerTest, TestViews) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("external_data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("external_data", "cpu")
+          .AddOutput("copy_1", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Crop")
+          .AddArg("crop", vector<int>{4, 4})
+          .AddInput("copy_1", "cpu")
+          .AddOutput("crop_1", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Crop")
+          .AddArg("crop", vector<int>{2, 2})
+          .AddInput("crop_1", "cpu")
+          .AddOutput("crop_2", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("crop_2", "cpu")
+          .AddOutput("copy_2", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddInput("copy_2", "cpu")
+          .AddOutput("copy_3", "cpu")), "");
+
+  BufferPlanner plan;
+  plan.Plan(&graph, {"external_data_cpu", "copy_3_cpu"});
+
+  // The crops are views into the first copy, that lives until
+  // the last of them is read
+  ASSERT_EQ(plan.NumBuffers(), 6);
+  ASSERT_TRUE(plan.IsView(2, 0));
+  ASSERT_TRUE(plan.IsView(3, 0));
+  ASSERT_FALSE(plan.IsShared(2, 0));
+  ASSERT_EQ(plan.LastUse(1, 0), 4);
+  ASSERT_NE(plan.BufferIdx(4, 0), plan.BufferIdx(1, 0));
+  ASSERT_EQ(plan.PeakBytes({{0}, {20}, {10}, {5}, {5}, {5}}), 25u);
+
+  // Viewed until the end of the iteration
+  plan.Plan(&graph, {"external_data_cpu", "crop_2_cpu", "copy_3_cpu"});
+  ASSERT_EQ(plan.LastUse(1, 0), BufferPlanner::kEndOfIteration);
+  ASSERT_FALSE(plan.IsShared(1, 0));
+}
+
+TEST_F(BufferPlannerTest, TestCPUToGPU) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("external_data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("external_data", "cpu")
+          .AddOutput("external_data", "gpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput("external_data", "gpu")
+          .AddOutput("copy_data", "gpu")), "");
+
+  BufferPlanner plan;
+  plan.Plan(&graph, {});
+
+  // Outputs read by the later stages are never shared
+  ASSERT_EQ(plan.NumBuffers(), 1);
+  ASSERT_FALSE(plan.IsShared(0, 0));
+  ASSERT_EQ(plan.PeakBytes({{10}}), 0u);
+}
+
+}  // namespace dali
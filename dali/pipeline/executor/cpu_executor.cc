@@ -0,0 +1,160 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/executor/cpu_executor.h"
+
+#include <string>
+#include <vector>
+
+#include "dali/pipeline/operators/util/make_contiguous.h"
+
+namespace dali {
+
+void CPUExecutor::Build(OpGraph *graph, vector<string> output_names) {
+  DALI_ENFORCE(graph != nullptr, "Input graph is nullptr.");
+  DALI_ENFORCE(graph->NumOp() > 0, "Graph has no operators.");
+  DALI_ENFORCE(graph->NumMixedOp() == 0 && graph->NumGPUOp() == 0,
+      "CPU-only pipeline can only run cpu and support ops.");
+  output_names_ = output_names;
+  graph_ = graph;
+
+  PruneUnusedGraphNodes();
+
+  CheckStridedOutputsForGraph();
+
+  SetupMemoryTagsForGraph();
+
+  SetupShapesForGraph();
+
+  WorkspaceBlob base_wsb;
+  SetupDataForGraph(&base_wsb);
+
+  PresizeData(&base_wsb);
+
+  // No streams to assign, the outputs are gathered by RunMixed
+  SetupOutputQueuesForGraph();
+  for (size_t i = 0; i < cpu_outputs_.size(); ++i) {
+    DALI_ENFORCE(graph_->NodeType(cpu_output_info_[i].prod_and_idx.first) == DALI_CPU,
+        "Outputs of a CPU-only pipeline must be produced by cpu ops.");
+    for (int j = 0; j < queue_depth_; ++j) {
+      cpu_outputs_[i].Get(j)->set_pinned(false);
+    }
+  }
+  SetupDirectOutputsForGraph();
+
+  SetupSchedulingForGraph();
+
+  SetupStreamingForGraph();
+
+  SetupStatisticsForGraph();
+
+  SetupTracingForGraph();
+
+  for (int i = 0; i < queue_depth_; ++i) {
+    if (cpu_execution_mode_ == DALI_CPU_STREAMING && i > 0) {
+      SetSupportOutputsForIter(&base_wsb);
+    }
+    wss_.push_back(base_wsb);
+  }
+}
+
+void CPUExecutor::RunMixed() {
+  TimeRange tr("[CPUExecutor] RunMixed");
+  std::unique_lock<std::mutex> lock(mixed_mutex_);
+  DALI_ENFORCE(!mixed_work_queue_.empty(), "Mixed work "
+      "queue empty. Did you call RunCPU prior to RunMixed?");
+  int queue_idx = mixed_work_queue_.front();
+  mixed_work_queue_.pop();
+  lock.unlock();
+
+  if (cpu_execution_mode_ == DALI_CPU_STREAMING) {
+    std::unique_lock<std::mutex> streaming_lock(streaming_mutex_);
+    StreamingBatch &batch = streaming_batches_[queue_idx];
+    streaming_cond_.wait(streaming_lock, [&batch] { return batch.samples_pending == 0; });
+  }
+
+  WorkspaceBlob &wsb = wss_[queue_idx];
+
+  // Stands in for the MakeContiguous ops of a regular pipeline
+  try {
+    for (size_t i = 0; !exec_error_ && i < cpu_outputs_.size(); ++i) {
+      auto &info = cpu_output_info_[i];
+      int cpu_op_id = graph_->NodeIdx(info.prod_and_idx.first);
+      GatherOutput(&wsb.cpu_op_data[cpu_op_id], info.prod_and_idx.second,
+          cpu_outputs_[i].Get(queue_idx).get());
+    }
+  } catch (std::runtime_error &e) {
+    exec_error_ = true;
+    std::unique_lock<std::mutex> errors_lock(errors_mutex_);
+    errors_.push_back(e.what());
+    ready_cond_.notify_all();
+    free_cond_.notify_all();
+  }
+
+  std::unique_lock<std::mutex> gpu_lock(gpu_mutex_);
+  gpu_work_queue_.push(queue_idx);
+  gpu_lock.unlock();
+}
+
+void CPUExecutor::RunGPU() {
+  TimeRange tr("[CPUExecutor] RunGPU");
+  std::unique_lock<std::mutex> gpu_lock(gpu_mutex_);
+  DALI_ENFORCE(!gpu_work_queue_.empty(), "GPU work queue "
+      "empty. Did you call RunMixed prior to RunGPU?");
+  int queue_idx = gpu_work_queue_.front();
+  gpu_work_queue_.pop();
+  gpu_lock.unlock();
+
+  if (exec_error_) return;
+
+  // All the work of the batch is done by now
+  std::unique_lock<std::mutex> lock(ready_mutex_);
+  ready_queue_.push(queue_idx);
+  ready_cond_.notify_all();
+}
+
+void CPUExecutor::GatherOutput(HostWorkspace *ws, int output_idx,
+    TensorList<CPUBackend> *output) {
+  // Skips the samples the op wrote into the output directly,
+  // and also copies the strided views densely
+  GatherSamples(batch_size_, [ws, output_idx](int j) -> const Tensor<CPUBackend>& {
+        return *ws->Output<CPUBackend>(output_idx, j);
+      }, output);
+}
+
+void AsyncCPUExecutor::RunCPU() {
+  worker_.CheckForErrors();
+  worker_.DoWork([this]() {
+        if (exec_error_) return;
+        CPUExecutor::RunCPU();
+      });
+}
+
+void AsyncCPUExecutor::RunMixed() {
+  worker_.CheckForErrors();
+  worker_.DoWork([this]() {
+        if (exec_error_) return;
+        CPUExecutor::RunMixed();
+      });
+}
+
+void AsyncCPUExecutor::RunGPU() {
+  worker_.CheckForErrors();
+  worker_.DoWork([this]() {
+        if (exec_error_) return;
+        CPUExecutor::RunGPU();
+      });
+}
+
+}  // namespace dali
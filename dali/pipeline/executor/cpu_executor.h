@@ -0,0 +1,103 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_CPU_EXECUTOR_H_
+#define DALI_PIPELINE_EXECUTOR_CPU_EXECUTOR_H_
+
+#include <string>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/error_handling.h"
+#include "dali/pipeline/executor/executor.h"
+#include "dali/pipeline/util/worker_thread.h"
+
+namespace dali {
+
+/**
+ * @brief Executor for graphs made of support and cpu ops only, which
+ * never touches the GPU: it makes no call to the CUDA runtime or NVML,
+ * creates no streams or events and allocates no pinned memory.
+ *
+ * Instead of relying on MakeContiguous mixed ops, the executor itself
+ * gathers the per-sample outputs of the cpu ops into the contiguous
+ * TensorLists returned to the user, in place of the mixed stage. The
+ * gpu stage only marks the batch as ready.
+ */
+class DLL_PUBLIC CPUExecutor : public Executor {
+ public:
+  DLL_PUBLIC inline CPUExecutor(int batch_size, int num_thread,
+      size_t bytes_per_sample_hint, bool set_affinity = false,
+      int prefetch_queue_depth = 2) :
+    Executor(batch_size, num_thread, CPU_ONLY_DEVICE_ID, bytes_per_sample_hint,
+        set_affinity, -1, prefetch_queue_depth) {}
+
+  DLL_PUBLIC virtual ~CPUExecutor() = default;
+
+  DLL_PUBLIC void Build(OpGraph *graph, vector<string> output_names) override;
+
+  DLL_PUBLIC void RunMixed() override;
+
+  DLL_PUBLIC void RunGPU() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(CPUExecutor);
+
+ protected:
+  void GatherOutput(HostWorkspace *ws, int output_idx, TensorList<CPUBackend> *output);
+};
+
+/**
+ * @brief CPUExecutor issuing its work from a worker thread, so that
+ * the calls to RunCPU, RunMixed and RunGPU return immediately and
+ * the next batches can be prefetched. The stages of a batch are run
+ * in order by the same thread.
+ */
+class DLL_PUBLIC AsyncCPUExecutor : public CPUExecutor {
+ public:
+  DLL_PUBLIC inline AsyncCPUExecutor(int batch_size, int num_thread,
+      size_t bytes_per_sample_hint, bool set_affinity = false,
+      int prefetch_queue_depth = 2) :
+    CPUExecutor(batch_size, num_thread, bytes_per_sample_hint,
+        set_affinity, prefetch_queue_depth),
+    worker_(CPU_ONLY_DEVICE_ID, false) {}
+
+  DLL_PUBLIC virtual ~AsyncCPUExecutor() {
+    worker_.ForceStop();
+  }
+
+  DLL_PUBLIC void Init() override {
+    if (!worker_.WaitForInit()) {
+      worker_.ForceStop();
+      throw std::runtime_error("Failed to init CPU-only pipeline");
+    }
+  }
+
+  DLL_PUBLIC void RunCPU() override;
+
+  DLL_PUBLIC void RunMixed() override;
+
+  DLL_PUBLIC void RunGPU() override;
+
+  DLL_PUBLIC void Outputs(DeviceWorkspace *ws) override {
+    worker_.CheckForErrors();
+    CPUExecutor::Outputs(ws);
+  }
+
+ protected:
+  WorkerThread worker_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_CPU_EXECUTOR_H_
@@ -15,10 +15,12 @@
 #include "dali/pipeline/executor/executor.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace dali {
 
@@ -32,12 +34,19 @@ void Executor::Build(OpGraph *graph, vector<string> output_names) {
   // will not be used as an output or by another node
   PruneUnusedGraphNodes();
 
+  CheckStridedOutputsForGraph();
+
+  SetupMemoryTagsForGraph();
+
+  SetupShapesForGraph();
+
   // Setup workspaces for each op and connect
   // their inputs and outputs.
   WorkspaceBlob base_wsb;
   SetupDataForGraph(&base_wsb);
 
-  // Presize the workspaces based on the hint
+  // Presize the workspaces based on the hint, the outputs
+  // of the mixed & gpu ops also get the buffer policy here
   PresizeData(&base_wsb);
 
   // Assign streams to all mixed & gpu ops
@@ -45,11 +54,25 @@ void Executor::Build(OpGraph *graph, vector<string> output_names) {
 
   SetupOutputQueuesForGraph();
 
+  SetupDirectOutputsForGraph();
+
+  SetupSchedulingForGraph();
+
+  SetupStreamingForGraph();
+
+  SetupStatisticsForGraph();
+
+  SetupTracingForGraph();
+
   // For each set of outputs, setup another set of
   // workspaces so that nothing has to be altered
   // during execution (this is necessary for
   // asynchonrous executors that can overlap work issue)
   for (int i = 0; i < queue_depth_; ++i) {
+    if (cpu_execution_mode_ == DALI_CPU_STREAMING && i > 0) {
+      // Batches run their support & cpu ops concurrently
+      SetSupportOutputsForIter(&base_wsb);
+    }
     SetOutputBuffersForIter(i, &base_wsb);
     wss_.push_back(base_wsb);
   }
@@ -58,6 +81,7 @@ void Executor::Build(OpGraph *graph, vector<string> output_names) {
 void Executor::RunCPU() {
   TimeRange tr("[Executor] RunCPU");
   // Block until there is a free buffer to use
+  auto wait_start = std::chrono::steady_clock::now();
   std::unique_lock<std::mutex> lock(free_mutex_);
   while (free_queue_.empty() && !exec_error_) {
     free_cond_.wait(lock);
@@ -68,6 +92,17 @@ void Executor::RunCPU() {
   int queue_idx = free_queue_.front();
   free_queue_.pop();
   lock.unlock();
+  // Random ops select their streams by the iteration
+  wss_[queue_idx].SetIteration(iteration_++);
+  if (!exec_error_) {
+    SetDirectOutputsForIter(queue_idx);
+  }
+  if (statistics_enabled_) {
+    std::chrono::duration<double, std::micro> wait_time =
+        std::chrono::steady_clock::now() - wait_start;
+    free_queue_wait_.Record(wait_time.count());
+    ++stats_iterations_;
+  }
 
   // Run the support ops
 
@@ -75,11 +110,9 @@ void Executor::RunCPU() {
     WorkspaceBlob &wsb = wss_[queue_idx];
     for (int i = 0; i < graph_->NumSupportOp(); ++i) {
       OpNode &op_node = graph_->support_node(i);
-      OperatorBase &op = *op_node.op;
       SupportWorkspace &ws = wsb.support_op_data[i];
-      TimeRange tr("[Executor] Run Support op " + op_node.instance_name,
-          TimeRange::kCyan);
-      op.Run(&ws);
+      TimeRange tr(op_trace_names_[op_node.id], TimeRange::kCyan);
+      RunOp(op_node, &ws);
     }
   } catch (std::runtime_error &e) {
     exec_error_ = true;
@@ -91,36 +124,236 @@ void Executor::RunCPU() {
   if (!exec_error_) {
     // Run the cpu-ops in the thread pool
     WorkspaceBlob &wsb = wss_[queue_idx];
-    for (int i = 0; i < batch_size_; ++i) {
+    if (cpu_execution_mode_ == DALI_CPU_STREAMING) {
+      // Completion of the batch is awaited by RunMixed
+      RunCPUStreaming(queue_idx);
+    } else {
+      try {
+        if (cpu_execution_mode_ == DALI_CPU_OPERATOR_MAJOR) {
+          RunCPUOperatorMajor(&wsb);
+        } else if (cpu_scheduling_policy_ == DALI_CPU_SCHEDULE_LONGEST_FIRST) {
+          RunCPULongestFirst(&wsb);
+        } else {
+          RunCPUSampleMajor(&wsb);
+        }
+        thread_pool_.WaitForWork();
+        RecordDirectOutputShapes(queue_idx);
+      }
+      catch (std::runtime_error& e) {
+        exec_error_ = true;
+        std::unique_lock<std::mutex> errors_lock(errors_mutex_);
+        errors_.push_back(e.what());
+        ready_cond_.notify_all();
+      }
+    }
+  }
+  // Pass the work to the mixed stage
+  std::unique_lock<std::mutex> mixed_lock(mixed_mutex_);
+  mixed_work_queue_.push(queue_idx);
+  mixed_lock.unlock();
+}
+
+void Executor::RunCPUSampleMajor(WorkspaceBlob *wsb) {
+  for (int i = 0; i < batch_size_; ++i) {
+    thread_pool_.DoWorkWithID(std::bind(
+          [this, wsb] (int data_idx, int tid) {
+          TimeRange tr("[Executor] RunCPU sample", TimeRange::kBlue, data_idx);
+          SampleWorkspace ws;
+          for (int j = 0; j < graph_->NumCPUOp(); ++j) {
+            OpNode &op_node = graph_->cpu_node(j);
+            wsb->cpu_op_data[j].GetSample(&ws, data_idx, tid, &scratch_arenas_[tid]);
+            TimeRange tr(op_trace_names_[op_node.id], TimeRange::kBlue1, data_idx);
+            RunOp(op_node, &ws);
+          }
+          }, i, std::placeholders::_1));
+  }
+}
+
+void Executor::RunCPULongestFirst(WorkspaceBlob *wsb) {
+  // Run the source ops first, their outputs tell how
+  // much work the rest of the ops has with each sample.
+  // The other ops only depend on the source ops and on
+  // each other, so they can all run in the second phase
+  for (int i = 0; i < batch_size_; ++i) {
+    thread_pool_.DoWorkWithID(std::bind(
+          [this, wsb] (int data_idx, int tid) {
+          SampleWorkspace ws;
+          for (int j : source_ops_) {
+            OpNode &op_node = graph_->cpu_node(j);
+            wsb->cpu_op_data[j].GetSample(&ws, data_idx, tid, &scratch_arenas_[tid]);
+            TimeRange tr(op_trace_names_[op_node.id], TimeRange::kBlue1, data_idx);
+            RunOp(op_node, &ws);
+          }
+          }, i, std::placeholders::_1));
+  }
+  thread_pool_.WaitForWork();
+
+  vector<std::pair<double, int>> order(batch_size_);
+  for (int i = 0; i < batch_size_; ++i) {
+    SampleCostModel::Features &features = sample_features_[i];
+    features.fill(0);
+    for (int j : source_ops_) {
+      HostWorkspace &ws = wsb->cpu_op_data[j];
+      for (int k = 0; k < ws.NumOutput(); ++k) {
+        if (ws.OutputIsType<CPUBackend>(k)) {
+          SampleCostModel::AddFeatures(*ws.Output<CPUBackend>(k, i), &features);
+        }
+      }
+    }
+    order[i] = std::make_pair(-cost_model_.Estimate(features), i);
+  }
+  std::sort(order.begin(), order.end());
+
+  // Each worker runs its share of the work in the order it was
+  // issued, so the most expensive samples are started first and
+  // the cheap ones at the end fill the gaps
+  for (auto &sample : order) {
+    const int data_idx = sample.second;
+    thread_pool_.DoWorkWithID([this, wsb, data_idx] (int tid) {
+          TimeRange tr("[Executor] RunCPU sample", TimeRange::kBlue, data_idx);
+          // Each op is timed, the cost model fits them separately
+          double *op_times = &sample_op_times_[data_idx * dependent_ops_.size()];
+          auto start = std::chrono::steady_clock::now();
+          SampleWorkspace ws;
+          for (size_t k = 0; k < dependent_ops_.size(); ++k) {
+            OpNode &op_node = graph_->cpu_node(dependent_ops_[k]);
+            wsb->cpu_op_data[dependent_ops_[k]].GetSample(
+                &ws, data_idx, tid, &scratch_arenas_[tid]);
+            {
+              TimeRange tr(op_trace_names_[op_node.id], TimeRange::kBlue1, data_idx);
+              RunOp(op_node, &ws);
+            }
+            auto end = std::chrono::steady_clock::now();
+            op_times[k] = std::chrono::duration<double, std::micro>(end - start).count();
+            start = end;
+          }
+          cost_model_.Update(sample_features_[data_idx], op_times);
+        });
+  }
+}
+
+void Executor::RunCPUOperatorMajor(WorkspaceBlob *wsb) {
+  // The batch is split into contiguous chunks of samples. Each task runs
+  // every op of a segment over its whole chunk before moving to the next
+  // op. As the per-sample ops only depend on the same sample of their
+  // parents, the chunk itself tracks all dependencies within a segment
+  // and no synchronization is needed between its ops. Only ops running
+  // on the whole batch at once end a segment, as they need all samples.
+  const int num_chunks = std::min(batch_size_,
+      kOperatorMajorChunksPerThread * thread_pool_.size());
+  int first_op = 0;
+  while (first_op < graph_->NumCPUOp()) {
+    int last_op = first_op;
+    while (last_op < graph_->NumCPUOp() &&
+        !graph_->cpu_node(last_op).op->CanRunBatch()) {
+      ++last_op;
+    }
+
+    for (int chunk = 0; first_op < last_op && chunk < num_chunks; ++chunk) {
+      const int begin = batch_size_ * chunk / num_chunks;
+      const int end = batch_size_ * (chunk + 1) / num_chunks;
       thread_pool_.DoWorkWithID(std::bind(
-            [this, &wsb] (int data_idx, int tid) {
-            TimeRange tr("[Executor] RunCPU on " + to_string(data_idx));
+            [this, wsb, first_op, last_op] (int begin, int end, int tid) {
             SampleWorkspace ws;
-            for (int j = 0; j < graph_->NumCPUOp(); ++j) {
+            for (int j = first_op; j < last_op; ++j) {
               OpNode &op_node = graph_->cpu_node(j);
-              OperatorBase &op = *op_node.op;
-              wsb.cpu_op_data[j].GetSample(&ws, data_idx, tid);
-              TimeRange tr("[Executor] Run CPU op " + op_node.instance_name
-                  + " on " + to_string(data_idx),
-                  TimeRange::kBlue1);
-              op.Run(&ws);
+              TimeRange tr(op_trace_names_[op_node.id], TimeRange::kBlue1, begin);
+              for (int data_idx = begin; data_idx < end; ++data_idx) {
+                wsb->cpu_op_data[j].GetSample(&ws, data_idx, tid, &scratch_arenas_[tid]);
+                RunOp(op_node, &ws);
+              }
             }
-            }, i, std::placeholders::_1));
+            }, begin, end, std::placeholders::_1));
     }
-    try {
+
+    if (last_op < graph_->NumCPUOp()) {
       thread_pool_.WaitForWork();
+      OpNode &op_node = graph_->cpu_node(last_op);
+      TimeRange tr(op_trace_names_[op_node.id], TimeRange::kBlue1);
+      RunOpBatch(op_node, &wsb->cpu_op_data[last_op]);
+      ++last_op;
     }
-    catch (std::runtime_error& e) {
-      exec_error_ = true;
-      std::unique_lock<std::mutex> errors_lock(errors_mutex_);
-      errors_.push_back(e.what());
-      ready_cond_.notify_all();
+    first_op = last_op;
+  }
+}
+
+void Executor::RunCPUStreaming(int queue_idx) {
+  std::unique_lock<std::mutex> lock(streaming_mutex_);
+  StreamingBatch &batch = streaming_batches_[queue_idx];
+  batch.sources_pending = last_source_op_ >= 0 ? batch_size_ : 0;
+  batch.samples_pending = batch_size_;
+
+  // A sample is only started once the same sample of the previous
+  // batch is done, otherwise both would share its intermediate
+  // buffers and the per-sample state of the ops
+  vector<int> ready_samples;
+  for (int i = 0; i < batch_size_; ++i) {
+    if (streaming_samples_[i].busy) {
+      streaming_samples_[i].waiting.push(queue_idx);
+    } else {
+      streaming_samples_[i].busy = true;
+      ready_samples.push_back(i);
     }
   }
-  // Pass the work to the mixed stage
-  std::unique_lock<std::mutex> mixed_lock(mixed_mutex_);
-  mixed_work_queue_.push(queue_idx);
-  mixed_lock.unlock();
+  lock.unlock();
+
+  for (int data_idx : ready_samples) {
+    thread_pool_.DoWorkWithID(std::bind(&Executor::RunCPUStreamingSample,
+          this, queue_idx, data_idx, std::placeholders::_1));
+  }
+
+  // Source ops (e.g. readers) keep per-batch state, so the next batch
+  // may only be issued once all samples of this one went through them
+  lock.lock();
+  streaming_cond_.wait(lock, [&batch] { return batch.sources_pending == 0; });
+}
+
+void Executor::RunCPUStreamingSample(int queue_idx, int data_idx, int tid) {
+  TimeRange tr("[Executor] RunCPU sample", TimeRange::kBlue, data_idx);
+  WorkspaceBlob &wsb = wss_[queue_idx];
+  SampleWorkspace ws;
+  for (int j = 0; j < graph_->NumCPUOp(); ++j) {
+    if (!exec_error_) {
+      OpNode &op_node = graph_->cpu_node(j);
+      try {
+        wsb.cpu_op_data[j].GetSample(&ws, data_idx, tid, &scratch_arenas_[tid]);
+        TimeRange tr(op_trace_names_[op_node.id], TimeRange::kBlue1, data_idx);
+        RunOp(op_node, &ws);
+      } catch (std::runtime_error &e) {
+        exec_error_ = true;
+        std::unique_lock<std::mutex> errors_lock(errors_mutex_);
+        errors_.push_back(e.what());
+        ready_cond_.notify_all();
+        free_cond_.notify_all();
+      }
+    }
+    if (j == last_source_op_) {
+      std::lock_guard<std::mutex> lock(streaming_mutex_);
+      if (--streaming_batches_[queue_idx].sources_pending == 0) {
+        streaming_cond_.notify_all();
+      }
+    }
+  }
+
+  // Hand this sample over to the next batch waiting for it
+  int next_queue_idx = -1;
+  {
+    std::lock_guard<std::mutex> lock(streaming_mutex_);
+    if (--streaming_batches_[queue_idx].samples_pending == 0) {
+      streaming_cond_.notify_all();
+    }
+    auto &sample = streaming_samples_[data_idx];
+    if (sample.waiting.empty()) {
+      sample.busy = false;
+    } else {
+      next_queue_idx = sample.waiting.front();
+      sample.waiting.pop();
+    }
+  }
+  if (next_queue_idx != -1) {
+    thread_pool_.DoWorkWithID(std::bind(&Executor::RunCPUStreamingSample,
+          this, next_queue_idx, data_idx, std::placeholders::_1));
+  }
 }
 
 void Executor::RunMixed() {
@@ -132,16 +365,21 @@ void Executor::RunMixed() {
   mixed_work_queue_.pop();
   lock.unlock();
 
+  if (cpu_execution_mode_ == DALI_CPU_STREAMING) {
+    // Wait for the cpu work of this batch only
+    std::unique_lock<std::mutex> streaming_lock(streaming_mutex_);
+    StreamingBatch &batch = streaming_batches_[queue_idx];
+    streaming_cond_.wait(streaming_lock, [&batch] { return batch.samples_pending == 0; });
+  }
+
   WorkspaceBlob &wsb = wss_[queue_idx];
 
   try {
     for (int i = 0; i < graph_->NumMixedOp(); ++i) {
       OpNode &op_node = graph_->mixed_node(i);
-      OperatorBase &op = *op_node.op;
       MixedWorkspace &ws = wsb.mixed_op_data[i];
-      TimeRange tr("[Executor] Run Mixed op " + op_node.instance_name,
-          TimeRange::kOrange);
-      op.Run(&ws);
+      TimeRange tr(op_trace_names_[op_node.id], TimeRange::kOrange);
+      RunOp(op_node, &ws);
       if (ws.has_stream() && ws.has_event()) {
         CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
       }
@@ -183,7 +421,6 @@ void Executor::RunGPU() {
     WorkspaceBlob &wsb = wss_[queue_idx];
     for (int i = 0; i < graph_->NumGPUOp(); ++i) {
       OpNode &op_node = graph_->gpu_node(i);
-      OperatorBase &op = *op_node.op;
       DeviceWorkspace &ws = wsb.gpu_op_data[i];
       auto parent_events = ws.ParentEvents();
 
@@ -191,9 +428,8 @@ void Executor::RunGPU() {
         CUDA_CALL(cudaStreamWaitEvent(ws.stream(), event, 0));
       }
 
-      TimeRange tr("[Executor] Run GPU op " + op_node.instance_name,
-          TimeRange::knvGreen);
-      op.Run(&ws);
+      TimeRange tr(op_trace_names_[op_node.id], TimeRange::knvGreen);
+      RunOp(op_node, &ws);
       if (ws.has_event()) {
         CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
       }
@@ -267,6 +503,7 @@ void Executor::ShareOutputs(DeviceWorkspace *ws) {
 
   // Block until the work for a batch has been issued.
   // Move the queue id from ready to in_use
+  auto wait_start = std::chrono::steady_clock::now();
   std::unique_lock<std::mutex> lock(ready_mutex_);
   while (ready_queue_.empty() && !exec_error_) {
     ready_cond_.wait(lock);
@@ -283,6 +520,11 @@ void Executor::ShareOutputs(DeviceWorkspace *ws) {
   ready_queue_.pop();
   in_use_queue_.push(output_idx);
   lock.unlock();
+  if (statistics_enabled_) {
+    std::chrono::duration<double, std::micro> wait_time =
+        std::chrono::steady_clock::now() - wait_start;
+    ready_queue_wait_.Record(wait_time.count());
+  }
 
   // Gather the results TensorLists and block on their
   // events to make sure that the computation has completed
@@ -396,10 +638,39 @@ void Executor::SetupDataForGraph(WorkspaceBlob *wsb) {
       // Allocate tensors for output
       shared_ptr<Tensor<CPUBackend>> output(new Tensor<CPUBackend>);
       output->set_pinned(false);
+      output->set_policy(buffer_policy_);
+      output->set_memory_tag(op_memory_tags_[node.id]);
       ws.AddOutput(output);
     }
   }
 
+  // Outputs of the cpu ops share buffers when their lifetimes allow,
+  // ops that allow it get the same Tensor as an input and an output.
+  // The outputs of the source ops are kept, as they are also read
+  // by the executor to schedule the samples.
+  vector<string> persistent_tensors = output_names_;
+  for (int i = 0; i < graph_->NumCPUOp(); ++i) {
+    const OpSpec &spec = graph_->cpu_node(i).spec;
+    if (spec.NumRegularInput() == 0) {
+      for (int j = 0; j < spec.NumOutput(); ++j) {
+        persistent_tensors.push_back(spec.Output(j));
+      }
+    }
+  }
+  buffer_plan_.Plan(graph_, persistent_tensors);
+  vector<vector<shared_ptr<Tensor<CPUBackend>>>> cpu_buffers(buffer_plan_.NumBuffers());
+  for (auto &buffer : cpu_buffers) {
+    // Allocate `batch_size` Tensors for each buffer
+    buffer.resize(batch_size_);
+    for (auto &tensor_ptr : buffer) {
+      tensor_ptr.reset(new Tensor<CPUBackend>);
+      tensor_ptr->set_pinned(false);
+      tensor_ptr->set_policy(buffer_policy_);
+    }
+  }
+
+  std::set<int> shared_buffer_idxs;
+
   // Setup cpu op input and output buffers
   for (int i = 0; i < graph_->NumCPUOp(); ++i) {
     OpNode &node = graph_->cpu_node(i);
@@ -434,16 +705,22 @@ void Executor::SetupDataForGraph(WorkspaceBlob *wsb) {
     }
 
     for (int j = 0; j < node.spec.NumOutput(); ++j) {
-      // Allocate `batch_size` Tensors for this ops
-      // results and add them to the workspace.
-      vector<shared_ptr<Tensor<CPUBackend>>> output(batch_size_, nullptr);
-      for (auto &tensor_ptr : output) {
-        tensor_ptr.reset(new Tensor<CPUBackend>);
-        tensor_ptr->set_pinned(false);
+      ws.AddOutput(cpu_buffers[buffer_plan_.BufferIdx(i, j)]);
+      if (buffer_plan_.IsShared(i, j)) {
+        shared_buffer_idxs.insert(buffer_plan_.BufferIdx(i, j));
       }
+    }
+  }
 
-      ws.AddOutput(output);
+  // Buffers shared by several ops are accounted to the executor
+  auto shared_tag = memory_tracker_->Tag("[Executor] shared cpu outputs");
+  shared_cpu_buffers_.clear();
+  for (int idx : shared_buffer_idxs) {
+    for (auto &tensor : cpu_buffers[idx]) {
+      tensor->set_memory_tag(shared_tag);
     }
+    shared_cpu_buffers_.insert(shared_cpu_buffers_.end(),
+        cpu_buffers[idx].begin(), cpu_buffers[idx].end());
   }
 
   // Setup mixed op input and output buffers
@@ -558,52 +835,113 @@ void Executor::SetupDataForGraph(WorkspaceBlob *wsb) {
   }
 }
 
+void Executor::SetupShapesForGraph() {
+  // The nodes are sorted so that the producers come first
+  inferred_shapes_.clear();
+  for (NodeID id = 0; id < graph_->NumOp(); ++id) {
+    const OpSpec &spec = graph_->node(id).spec;
+    vector<SampleShape> inputs;
+    for (int i = 0; i < spec.NumInput(); ++i) {
+      if (spec.IsArgumentInput(i)) continue;
+      TensorMeta meta = graph_->TensorSourceMeta(spec.Input(i));
+      inputs.push_back(inferred_shapes_[meta.node][meta.index]);
+    }
+    inferred_shapes_.push_back(
+        SchemaRegistry::GetSchema(spec.name()).InferOutputShapes(spec, inputs));
+  }
+}
+
+namespace {
+
+// The TypeInfo of an inferred type, or NoType if it is not a numeric type.
+// The TypeTable only knows the types already in use, so the TypeInfo is
+// created from the C++ type rather than looked up
+TypeInfo InferredTypeInfo(DALIDataType dtype) {
+  TypeInfo type = TypeInfo::Create<NoType>();
+  if (dtype >= DALI_UINT8 && dtype <= DALI_BOOL) {
+    DALI_TYPE_SWITCH_WITH_FP16(dtype, DType, type = TypeInfo::Create<DType>(););
+  }
+  return type;
+}
+
+}  // namespace
+
+size_t Executor::OutputBytesHint(NodeID node, int output_idx) const {
+  const SampleShape &inferred = inferred_shapes_[node][output_idx];
+  const TypeInfo type = InferredTypeInfo(inferred.type);
+  if (!inferred.IsKnown() || !IsValidType(type)) {
+    return bytes_per_sample_hint_;
+  }
+  const size_t bytes = Product(inferred.shape) * type.size();
+  return std::max(bytes, bytes_per_sample_hint_);
+}
+
 void Executor::PresizeData(WorkspaceBlob *wsb) {
   TimeRange tr("[Executor] PresizeData");
   // Note: At some point our graph has source nodes that
   // only have outputs (data readers or external inputs).
   // Thus, the set of all outputs buffers in our workspaces
   // represents all the unique buffers in our graph.
-  for (auto &ws : wsb->cpu_op_data) {
+  // The buffers are accounted to the ops they are allocated for
+  for (int k = 0; k < graph_->NumCPUOp(); ++k) {
+    HostWorkspace &ws = wsb->cpu_op_data[k];
+    const NodeID node_id = graph_->cpu_node(k).id;
+    MemoryTagScope memory_scope(op_memory_tags_[node_id].get());
     for (int i = 0; i < ws.NumOutput(); ++i) {
       DALI_ENFORCE(ws.NumOutputAtIdx(i) == batch_size_, "Executor "
           "encountered cpu op workspace where the number of tensors "
           "is not equal to the batch size.");
       DALI_ENFORCE(ws.OutputIsType<CPUBackend>(i), "Executor "
           "encountered cpu op with non-cpu output.");
+      const Index bytes = OutputBytesHint(node_id, i);
       for (int j = 0; j < ws.NumOutputAtIdx(i); ++j) {
         Tensor<CPUBackend> *tensor = ws.Output<CPUBackend>(i, j);
         // We set the type of the tensor to uint8 temporarily
         tensor->mutable_data<uint8>();
-        tensor->Resize({(Index)bytes_per_sample_hint_});
+        // A buffer shared by several outputs fits the largest of them
+        if (tensor->size() < bytes) {
+          tensor->Resize({bytes});
+        }
       }
     }
   }
 
-  for (auto &ws : wsb->mixed_op_data) {
+  for (int k = 0; k < graph_->NumMixedOp(); ++k) {
+    MixedWorkspace &ws = wsb->mixed_op_data[k];
+    const NodeID node_id = graph_->mixed_node(k).id;
+    MemoryTagScope memory_scope(op_memory_tags_[node_id].get());
     for (int i = 0; i < ws.NumOutput(); ++i) {
+      const Index bytes = OutputBytesHint(node_id, i) * batch_size_;
       if (ws.OutputIsType<CPUBackend>(i)) {
         TensorList<CPUBackend> *tl = ws.Output<CPUBackend>(i);
+        tl->set_policy(buffer_policy_);
         tl->mutable_data<uint8>();
-        tl->Resize({{(Index)bytes_per_sample_hint_*batch_size_}});
+        tl->Resize({{bytes}});
       } else {
         TensorList<GPUBackend> *tl = ws.Output<GPUBackend>(i);
+        tl->set_policy(buffer_policy_);
         tl->mutable_data<uint8>();
-        tl->Resize({{(Index)bytes_per_sample_hint_*batch_size_}});
+        tl->Resize({{bytes}});
       }
     }
   }
 
-  for (auto &ws : wsb->gpu_op_data) {
+  for (int k = 0; k < graph_->NumGPUOp(); ++k) {
+    DeviceWorkspace &ws = wsb->gpu_op_data[k];
+    const NodeID node_id = graph_->gpu_node(k).id;
+    MemoryTagScope memory_scope(op_memory_tags_[node_id].get());
     for (int i = 0; i < ws.NumOutput(); ++i) {
+      const Index bytes = OutputBytesHint(node_id, i) * batch_size_;
       if (ws.OutputIsType<GPUBackend>(i)) {
         TensorList<GPUBackend> *tl = ws.Output<GPUBackend>(i);
+        tl->set_policy(buffer_policy_);
         tl->mutable_data<uint8>();
-        tl->Resize({{(Index)bytes_per_sample_hint_*batch_size_}});
+        tl->Resize({{bytes}});
       } else {
         TensorList<CPUBackend> *tl = ws.Output<CPUBackend>(i);
+        tl->set_policy(buffer_policy_);
         tl->mutable_data<uint8>();
-        tl->Resize({{(Index)bytes_per_sample_hint_*batch_size_}});
+        tl->Resize({{bytes}});
       }
     }
   }
@@ -645,6 +983,7 @@ void Executor::SetupStreamsForGraph(WorkspaceBlob *wsb) {
 }
 
 void Executor::SetupOutputQueuesForGraph() {
+  auto output_queue_tag = memory_tracker_->Tag("[Executor] output queue");
   // Allocate output TensorList pools for each output
   for (auto &name : output_names_) {
     auto tensor_meta = graph_->TensorSourceMeta(name);
@@ -663,7 +1002,8 @@ void Executor::SetupOutputQueuesForGraph() {
       DALI_ENFORCE(!tensor_meta.is_support,
           "Outputs of support ops cannot be outputs.");  // TODO(ptredak): lift this restriction
       cpu_outputs_.push_back(TensorListPool<CPUBackend>(
-              queue_depth_, batch_size_, bytes_per_sample_hint_));
+              queue_depth_, batch_size_, OutputBytesHint(tensor_meta.node, tensor_meta.index),
+              buffer_policy_, output_queue_tag));
       DALI_ENFORCE(type_idx_map_.insert({name, cpu_outputs_.size()-1}).second,
           "Output tensor meta insertion failed. Duplicate output name '" +
           name + "' exists.");
@@ -672,7 +1012,8 @@ void Executor::SetupOutputQueuesForGraph() {
       gpu_output_events_.push_back(EventList());
     } else {
       gpu_outputs_.push_back(TensorListPool<GPUBackend>(
-              queue_depth_, batch_size_, bytes_per_sample_hint_));
+              queue_depth_, batch_size_, OutputBytesHint(tensor_meta.node, tensor_meta.index),
+              buffer_policy_, output_queue_tag));
       DALI_ENFORCE(type_idx_map_.insert({name, gpu_outputs_.size()-1}).second,
           "Output tensor meta insertion failed. Duplicate output name '" +
           name + "' exists.");
@@ -751,4 +1092,363 @@ void Executor::SetOutputBuffersForIter(int queue_idx, WorkspaceBlob *wsb) {
   }
 }
 
+void Executor::CheckStridedOutputsForGraph() {
+  if (AllowsStridedOutputs()) return;
+  for (int i = 0; i < graph_->NumCPUOp(); ++i) {
+    const OpSpec &spec = graph_->cpu_node(i).spec;
+    DALI_ENFORCE(!SchemaRegistry::GetSchema(spec.name()).ProducesStridedOutputs(spec),
+        "Operator \"" + spec.name() + "\" outputs strided views, which the executor does "
+        "not support in the streaming cpu mode. Set its strided_outputs argument to false.");
+  }
+}
+
+void Executor::SetupDirectOutputsForGraph() {
+  direct_outputs_.clear();
+  // The samples of a batch are run at different times
+  if (cpu_execution_mode_ == DALI_CPU_STREAMING) return;
+
+  std::set<std::pair<int, int>> seen;
+  for (size_t i = 0; i < cpu_outputs_.size(); ++i) {
+    NodeID node_id = cpu_output_info_[i].prod_and_idx.first;
+    int output_idx = cpu_output_info_[i].prod_and_idx.second;
+    if (graph_->NodeType(node_id) == DALI_MIXED) {
+      // Look through the MakeContiguous op to the op it gathers
+      const OpSpec &spec = graph_->node(node_id).spec;
+      if (spec.name() != "MakeContiguous") continue;
+      output_idx = graph_->TensorIdxInSource(spec.Input(0));
+      node_id = graph_->TensorSourceID(spec.Input(0));
+    }
+    if (graph_->NodeType(node_id) != DALI_CPU) continue;
+
+    int cpu_op = graph_->NodeIdx(node_id);
+    // Outputs that are not written into their own buffer. All outputs of
+    // ops that can produce strided outputs are planned as views, also when
+    // the op falls back to a dense copy (e.g. a type or layout conversion
+    // in Crop): this is decided per sample at run time, and a sample that
+    // is a view would replace the buffer laid out for it
+    if (buffer_plan_.IsInPlace(cpu_op, output_idx) ||
+        buffer_plan_.IsView(cpu_op, output_idx)) {
+      continue;
+    }
+    // A sample can only be written into one output batch
+    if (!seen.insert(std::make_pair(cpu_op, output_idx)).second) continue;
+
+    DirectOutput direct;
+    direct.cpu_output = i;
+    direct.cpu_op = cpu_op;
+    direct.output_idx = output_idx;
+    // The outputs of an inferred shape are written directly from the start
+    const SampleShape &inferred = inferred_shapes_[node_id][output_idx];
+    const TypeInfo type = InferredTypeInfo(inferred.type);
+    if (inferred.IsKnown() && !inferred.upper_bound && IsValidType(type)) {
+      direct.type = type;
+      direct.shapes.assign(batch_size_, inferred.shape);
+      direct.stable = true;
+    }
+    direct_outputs_.push_back(direct);
+  }
+}
+
+void Executor::SetDirectOutputsForIter(int queue_idx) {
+  for (auto &direct : direct_outputs_) {
+    HostWorkspace &ws = wss_[queue_idx].cpu_op_data[direct.cpu_op];
+    if (!direct.stable) {
+      // The samples may still point into an output batch of an
+      // earlier iteration, which can be in use or reallocated
+      for (int j = 0; j < batch_size_; ++j) {
+        ws.Output<CPUBackend>(direct.output_idx, j)->UnshareData();
+      }
+      continue;
+    }
+    auto output = cpu_outputs_[direct.cpu_output].Get(queue_idx);
+    output->set_type(direct.type);
+    output->Resize(direct.shapes);
+    for (int j = 0; j < batch_size_; ++j) {
+      ws.Output<CPUBackend>(direct.output_idx, j)->ShareData(output.get(), j);
+    }
+  }
+}
+
+void Executor::RecordDirectOutputShapes(int queue_idx) {
+  for (auto &direct : direct_outputs_) {
+    HostWorkspace &ws = wss_[queue_idx].cpu_op_data[direct.cpu_op];
+    const TypeInfo &type = ws.Output<CPUBackend>(direct.output_idx, 0)->type();
+    bool stable = IsValidType(type) && type == direct.type &&
+        static_cast<int>(direct.shapes.size()) == batch_size_;
+    direct.shapes.resize(batch_size_);
+    for (int j = 0; j < batch_size_; ++j) {
+      const Dims &shape = ws.Output<CPUBackend>(direct.output_idx, j)->shape();
+      stable = stable && shape == direct.shapes[j];
+      direct.shapes[j] = shape;
+    }
+    direct.type = type;
+    direct.stable = stable;
+  }
+}
+
+void Executor::SetupSchedulingForGraph() {
+  last_source_op_ = -1;
+  source_ops_.clear();
+  dependent_ops_.clear();
+  for (int i = 0; i < graph_->NumCPUOp(); ++i) {
+    if (graph_->cpu_node(i).spec.NumRegularInput() == 0) {
+      last_source_op_ = i;
+      source_ops_.push_back(i);
+    } else {
+      dependent_ops_.push_back(i);
+    }
+  }
+  cost_model_.Reset(dependent_ops_.size());
+  sample_features_.resize(batch_size_);
+  sample_op_times_.assign(batch_size_ * dependent_ops_.size(), 0);
+}
+
+void Executor::SetupStreamingForGraph() {
+  streaming_batches_.resize(queue_depth_);
+  streaming_samples_.clear();
+  streaming_samples_.resize(batch_size_);
+}
+
+void Executor::SetSupportOutputsForIter(WorkspaceBlob *wsb) {
+  // Give the support ops a fresh set of output buffers, so that
+  // the next batch does not overwrite the tensor arguments still
+  // read by the cpu ops of the previous one
+  for (int i = 0; i < graph_->NumSupportOp(); ++i) {
+    OpNode &node = graph_->support_node(i);
+    for (int j = 0; j < node.spec.NumOutput(); ++j) {
+      shared_ptr<Tensor<CPUBackend>> output(new Tensor<CPUBackend>);
+      output->set_pinned(false);
+      output->set_policy(buffer_policy_);
+      output->set_memory_tag(op_memory_tags_[node.id]);
+      wsb->support_op_data[i].SetOutput(j, output);
+
+      for (auto &meta : graph_->TensorConsumerMeta(node.spec.Output(j))) {
+        int child_op_id = graph_->NodeIdx(meta.node);
+        const OpSpec &spec = graph_->node(meta.node).spec;
+        switch (graph_->NodeType(meta.node)) {
+          case DALI_SUPPORT:
+            wsb->support_op_data[child_op_id].SetInput(meta.index, output);
+            break;
+          case DALI_CPU:
+            wsb->cpu_op_data[child_op_id].SetArgumentInput(
+                output, spec.ArgumentInputName(meta.index));
+            break;
+          case DALI_MIXED:
+            wsb->mixed_op_data[child_op_id].SetArgumentInput(
+                output, spec.ArgumentInputName(meta.index));
+            break;
+          case DALI_GPU:
+            wsb->gpu_op_data[child_op_id].SetArgumentInput(
+                output, spec.ArgumentInputName(meta.index));
+            break;
+          default:
+            DALI_FAIL("Internal error - unknown consumer type");
+        }
+      }
+    }
+  }
+}
+
+namespace {
+
+string OpDeviceName(DALIOpType type) {
+  switch (type) {
+    case DALI_SUPPORT:
+      return "support";
+    case DALI_CPU:
+      return "cpu";
+    case DALI_MIXED:
+      return "mixed";
+    case DALI_GPU:
+      return "gpu";
+    default:
+      DALI_FAIL("Internal error - unknown op type");
+  }
+}
+
+void UpdateMax(std::atomic<size_t> *max, size_t value) {
+  size_t current = max->load(std::memory_order_relaxed);
+  while (value > current &&
+      !max->compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+template <typename Backend>
+size_t MaxSampleBytes(const TensorList<Backend> &tl) {
+  size_t max_bytes = 0;
+  for (int i = 0; i < tl.ntensor(); ++i) {
+    max_bytes = std::max(max_bytes, Product(tl.tensor_shape(i)) * tl.type().size());
+  }
+  return max_bytes;
+}
+
+}  // namespace
+
+void Executor::SetupTracingForGraph() {
+  // Names of the ranges are built once, running the ops
+  // costs no allocation whether tracing is enabled or not
+  op_trace_names_.clear();
+  for (int i = 0; i < graph_->NumOp(); ++i) {
+    op_trace_names_.push_back(Tracer::Get().Intern("[Executor] Run "
+        + OpDeviceName(graph_->NodeType(i)) + " op " + graph_->node(i).instance_name));
+  }
+}
+
+void Executor::SetupMemoryTagsForGraph() {
+  op_memory_tags_.clear();
+  for (int i = 0; i < graph_->NumOp(); ++i) {
+    op_memory_tags_.push_back(memory_tracker_->Tag(graph_->node(i).instance_name));
+  }
+}
+
+void Executor::SetupStatisticsForGraph() {
+  op_stats_.clear();
+  for (int i = 0; i < graph_->NumOp(); ++i) {
+    op_stats_.emplace_back(new OpStats(graph_->node(i).spec.NumOutput()));
+  }
+}
+
+void Executor::RunOpBatch(const OpNode &op_node, HostWorkspace *ws) {
+  MemoryTagScope memory_scope(op_memory_tags_[op_node.id].get());
+  if (!statistics_enabled_) {
+    op_node.op->RunBatch(ws);
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+  op_node.op->RunBatch(ws);
+  std::chrono::duration<double, std::micro> time =
+      std::chrono::steady_clock::now() - start;
+
+  // Accounted as an even share of the time for each sample
+  OpStats &stats = *op_stats_[op_node.id];
+  size_t bytes = 0;
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    size_t max_sample_bytes = 0;
+    for (int j = 0; j < ws->NumOutputAtIdx(i); ++j) {
+      const size_t sample_bytes = ws->Output<CPUBackend>(i, j)->nbytes();
+      max_sample_bytes = std::max(max_sample_bytes, sample_bytes);
+      bytes += sample_bytes;
+    }
+    UpdateMax(&stats.max_sample_bytes[i], max_sample_bytes);
+  }
+  stats.run_time.Record(time.count() / batch_size_, batch_size_);
+  stats.bytes_produced.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+size_t Executor::OutputBytes(SampleWorkspace *ws) {
+  size_t bytes = 0;
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    bytes += ws->Output<CPUBackend>(i)->nbytes();
+  }
+  return bytes;
+}
+
+void Executor::RecordSampleBytes(OpStats *stats, SampleWorkspace *ws) {
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    UpdateMax(&stats->max_sample_bytes[i], ws->Output<CPUBackend>(i)->nbytes());
+  }
+}
+
+void Executor::RecordSampleBytes(OpStats *stats, MixedWorkspace *ws) {
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    UpdateMax(&stats->max_sample_bytes[i], ws->OutputIsType<CPUBackend>(i) ?
+        MaxSampleBytes(*ws->Output<CPUBackend>(i)) : MaxSampleBytes(*ws->Output<GPUBackend>(i)));
+  }
+}
+
+void Executor::RecordSampleBytes(OpStats *stats, DeviceWorkspace *ws) {
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    UpdateMax(&stats->max_sample_bytes[i], ws->OutputIsType<CPUBackend>(i) ?
+        MaxSampleBytes(*ws->Output<CPUBackend>(i)) : MaxSampleBytes(*ws->Output<GPUBackend>(i)));
+  }
+}
+
+size_t Executor::OutputBytes(SupportWorkspace *ws) {
+  size_t bytes = 0;
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    bytes += ws->Output<CPUBackend>(i)->nbytes();
+  }
+  return bytes;
+}
+
+size_t Executor::OutputBytes(MixedWorkspace *ws) {
+  size_t bytes = 0;
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    if (ws->OutputIsType<CPUBackend>(i)) {
+      bytes += ws->Output<CPUBackend>(i)->nbytes();
+    } else {
+      bytes += ws->Output<GPUBackend>(i)->nbytes();
+    }
+  }
+  return bytes;
+}
+
+size_t Executor::OutputBytes(DeviceWorkspace *ws) {
+  size_t bytes = 0;
+  for (int i = 0; i < ws->NumOutput(); ++i) {
+    if (ws->OutputIsType<CPUBackend>(i)) {
+      bytes += ws->Output<CPUBackend>(i)->nbytes();
+    } else {
+      bytes += ws->Output<GPUBackend>(i)->nbytes();
+    }
+  }
+  return bytes;
+}
+
+ExecutorStatistics Executor::GetStatistics() const {
+  DALI_ENFORCE(graph_ != nullptr, "Statistics are only available after Build().");
+  ExecutorStatistics stats;
+  stats.iterations = stats_iterations_;
+  for (int i = 0; i < graph_->NumOp(); ++i) {
+    OpNode &op_node = graph_->node(i);
+    OpStatistics op_stats;
+    op_stats.name = op_node.instance_name;
+    op_stats.device = OpDeviceName(graph_->NodeType(i));
+    op_stats.run_time = op_stats_[i]->run_time.Summary();
+    op_stats.bytes_produced = op_stats_[i]->bytes_produced;
+    if (LatencyHistogram *prefetch_wait = op_node.op->prefetch_wait()) {
+      op_stats.prefetch_wait = prefetch_wait->Summary();
+    }
+    for (int j = 0; j < op_node.spec.NumOutput(); ++j) {
+      op_stats.max_sample_bytes.push_back(op_stats_[i]->max_sample_bytes[j]);
+      stats.max_sample_bytes = std::max<size_t>(stats.max_sample_bytes,
+          op_stats.max_sample_bytes.back());
+    }
+    stats.ops.push_back(op_stats);
+  }
+
+  // Sizes of the shared outputs of the cpu ops and of their buffers
+  vector<vector<size_t>> max_sample_bytes(graph_->NumCPUOp());
+  for (int i = 0; i < graph_->NumCPUOp(); ++i) {
+    const OpNode &op_node = graph_->cpu_node(i);
+    for (int j = 0; j < op_node.spec.NumOutput(); ++j) {
+      max_sample_bytes[i].push_back(op_stats_[op_node.id]->max_sample_bytes[j]);
+    }
+  }
+  stats.planned_peak_bytes = buffer_plan_.PeakBytes(max_sample_bytes) * batch_size_;
+  for (auto &buffer : shared_cpu_buffers_) {
+    stats.allocated_bytes += buffer->capacity();
+  }
+
+  stats.free_queue_wait = free_queue_wait_.Summary();
+  stats.ready_queue_wait = ready_queue_wait_.Summary();
+  return stats;
+}
+
+void Executor::ResetStatistics() {
+  DALI_ENFORCE(graph_ != nullptr, "Statistics are only available after Build().");
+  for (int i = 0; i < graph_->NumOp(); ++i) {
+    op_stats_[i]->run_time.Reset();
+    op_stats_[i]->bytes_produced = 0;
+    for (int j = 0; j < graph_->node(i).spec.NumOutput(); ++j) {
+      op_stats_[i]->max_sample_bytes[j] = 0;
+    }
+    if (LatencyHistogram *prefetch_wait = graph_->node(i).op->prefetch_wait()) {
+      prefetch_wait->Reset();
+    }
+  }
+  free_queue_wait_.Reset();
+  ready_queue_wait_.Reset();
+  stats_iterations_ = 0;
+}
+
 }  // namespace dali
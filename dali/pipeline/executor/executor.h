@@ -15,6 +15,8 @@
 #ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 
+#include <atomic>
+#include <chrono>
 #include <utility>
 #include <vector>
 #include <string>
@@ -29,12 +31,54 @@
 #include "dali/pipeline/workspace/mixed_workspace.h"
 #include "dali/pipeline/workspace/support_workspace.h"
 #include "dali/pipeline/op_graph.h"
+#include "dali/pipeline/executor/buffer_planner.h"
+#include "dali/pipeline/executor/executor_statistics.h"
+#include "dali/pipeline/executor/sample_cost_model.h"
+#include "dali/pipeline/data/memory_tracker.h"
 #include "dali/pipeline/util/event_pool.h"
 #include "dali/pipeline/util/stream_pool.h"
-#include "dali/pipeline/util/thread_pool.h"
+#include "dali/pipeline/util/work_stealing_thread_pool.h"
 
 namespace dali {
 
+/**
+ * @brief Order in which the CPU stage runs ops over the samples of a batch.
+ *
+ * In the sample-major mode each sample is processed by all CPU ops before
+ * the worker moves to the next sample. In the operator-major mode each op
+ * is run over a whole chunk of the batch before the next op starts, which
+ * keeps the code and the data of a single op hot in the caches, and ops
+ * implementing OperatorBase::RunBatch get the whole batch at once.
+ *
+ * The streaming mode schedules samples like the sample-major mode, but
+ * does not wait for the whole batch to finish before the cpu work of the
+ * next batch is issued: samples of the next batch start as soon as the
+ * workers free up, bounded by the number of free output buffers. The
+ * mixed stage waits for the completion of its own batch only.
+ */
+enum CPUExecutionMode {
+  DALI_CPU_SAMPLE_MAJOR = 0,
+  DALI_CPU_OPERATOR_MAJOR = 1,
+  DALI_CPU_STREAMING = 2
+};
+
+/**
+ * @brief Order in which the samples of a batch are issued to the thread
+ * pool in the sample-major mode.
+ *
+ * With the longest-first policy the source ops (e.g. readers) are run
+ * over the batch first. The size of their outputs, or the dimensions
+ * from the header for encoded images, gives an estimate of the cost of
+ * each sample, refined online with the measured run times of each op
+ * (see SampleCostModel). The remaining ops are then issued in the order of
+ * decreasing estimated cost, so a single large sample does not start
+ * last and delay the whole batch.
+ */
+enum CPUSchedulingPolicy {
+  DALI_CPU_SCHEDULE_IN_ORDER = 0,
+  DALI_CPU_SCHEDULE_LONGEST_FIRST = 1
+};
+
 /**
  * @brief Basic executor for dali graphs. This executor enables
  * prefetching of results by maintaining two copies of output
@@ -53,10 +97,21 @@ class DLL_PUBLIC Executor {
     thread_pool_(num_thread, device_id, set_affinity),
     exec_error_(false) {
     DALI_ENFORCE(batch_size_ > 0, "Batch size must be greater than 0.");
-    DALI_ENFORCE(device_id >= 0, "Device id must be non-negative.");
+    DALI_ENFORCE(device_id >= 0 || device_id == CPU_ONLY_DEVICE_ID,
+        "Device id must be non-negative.");
+    // One scratch arena per worker thread, indexed by the thread id
+    scratch_arenas_.resize(num_thread);
+    auto scratch_tag = memory_tracker_->Tag("[Executor] scratch arenas");
+    for (auto &arena : scratch_arenas_) {
+      arena.set_memory_tag(scratch_tag);
+    }
   }
 
-  DLL_PUBLIC virtual ~Executor() = default;
+  DLL_PUBLIC virtual ~Executor() {
+    // In the streaming mode cpu work may still be in flight,
+    // finish it before the state it uses is torn down
+    thread_pool_.WaitForWork(false);
+  }
 
   DLL_PUBLIC virtual void Build(OpGraph *graph, vector<string> output_names);
 
@@ -74,6 +129,96 @@ class DLL_PUBLIC Executor {
 
   DLL_PUBLIC virtual void ReleaseOutputs();
 
+  /**
+   * @brief Selects how the CPU ops are scheduled over the batch.
+   * Must be called before Build(). See CPUExecutionMode.
+   */
+  DLL_PUBLIC inline void SetCPUExecutionMode(CPUExecutionMode mode) {
+    cpu_execution_mode_ = mode;
+  }
+
+  DLL_PUBLIC inline CPUExecutionMode GetCPUExecutionMode() const {
+    return cpu_execution_mode_;
+  }
+
+  /**
+   * @brief Returns whether the cpu ops may output strided views into
+   * their inputs. In the streaming mode, the cpu ops of the next batch
+   * run over a sample while the later stages of this batch may still
+   * read it, and this executor does not queue the inputs of the views,
+   * so they are turned off. Depends on SetCPUExecutionMode().
+   */
+  DLL_PUBLIC virtual bool AllowsStridedOutputs() const {
+    return cpu_execution_mode_ != DALI_CPU_STREAMING;
+  }
+
+  /**
+   * @brief Selects the order the samples are issued in the sample-major
+   * mode. Must be called before Build(). See CPUSchedulingPolicy.
+   */
+  DLL_PUBLIC inline void SetCPUSchedulingPolicy(CPUSchedulingPolicy policy) {
+    cpu_scheduling_policy_ = policy;
+  }
+
+  DLL_PUBLIC inline CPUSchedulingPolicy GetCPUSchedulingPolicy() const {
+    return cpu_scheduling_policy_;
+  }
+
+  /**
+   * @brief Sets the policy for the allocations of the outputs of the
+   * ops and of the queued buffers. Must be called before Build().
+   * See BufferPolicy.
+   */
+  DLL_PUBLIC inline void SetBufferPolicy(const BufferPolicy &policy) {
+    buffer_policy_ = policy;
+  }
+
+  DLL_PUBLIC inline const BufferPolicy &GetBufferPolicy() const {
+    return buffer_policy_;
+  }
+
+  /**
+   * @brief Enables the collection of the execution statistics returned
+   * by GetStatistics(). Every run of an op is timed then, so they are
+   * disabled by default.
+   */
+  DLL_PUBLIC inline void EnableStatistics(bool enabled) {
+    statistics_enabled_ = enabled;
+  }
+
+  DLL_PUBLIC inline bool StatisticsEnabled() const {
+    return statistics_enabled_;
+  }
+
+  /**
+   * @brief Returns the statistics collected since they were enabled or
+   * last reset. Can be called at any time after Build().
+   */
+  DLL_PUBLIC ExecutorStatistics GetStatistics() const;
+
+  DLL_PUBLIC void ResetStatistics();
+
+  /**
+   * @brief Returns the tags the memory of the pipeline is accounted
+   * to: one for every op, with the outputs and the scratch buffers of
+   * the op, and ones for the buffers of the executor.
+   */
+  DLL_PUBLIC inline MemoryTracker &GetMemoryTracker() {
+    return *memory_tracker_;
+  }
+
+  /**
+   * @brief Returns the memory currently allocated for every tag, and
+   * the most allocated at once since Build() or ResetMemoryPeaks().
+   */
+  DLL_PUBLIC inline vector<MemoryUsage> GetMemoryReport() const {
+    return memory_tracker_->Report();
+  }
+
+  DLL_PUBLIC inline void ResetMemoryPeaks() {
+    memory_tracker_->ResetPeaks();
+  }
+
   friend class ExecutorTest;
 
   DISABLE_COPY_MOVE_ASSIGN(Executor);
@@ -91,13 +236,30 @@ class DLL_PUBLIC Executor {
       gpu_op_data.clear();
       support_op_data.clear();
     }
+
+    void SetIteration(int64 iteration) {
+      for (auto &ws : cpu_op_data) ws.set_iteration(iteration);
+      for (auto &ws : mixed_op_data) ws.set_iteration(iteration);
+      for (auto &ws : gpu_op_data) ws.set_iteration(iteration);
+      for (auto &ws : support_op_data) ws.set_iteration(iteration);
+    }
   };
   vector<WorkspaceBlob> wss_;
 
   void PruneUnusedGraphNodes();
 
+  // Enforces that the cpu ops do not output strided views, when
+  // the executor does not allow them (see AllowsStridedOutputs())
+  void CheckStridedOutputsForGraph();
+
   void SetupDataForGraph(WorkspaceBlob *wsb);
 
+  void SetupShapesForGraph();
+
+  // Bytes to preallocate for a sample of the output of the node: the
+  // hint, or more when the inferred shape of the output needs more
+  size_t OutputBytesHint(NodeID node, int output_idx) const;
+
   void PresizeData(WorkspaceBlob *wsb);
 
   void SetupStreamsForGraph(WorkspaceBlob *wsb);
@@ -106,12 +268,81 @@ class DLL_PUBLIC Executor {
 
   void SetOutputBuffersForIter(int queue_idx, WorkspaceBlob *wsb);
 
+  void RunCPUSampleMajor(WorkspaceBlob *wsb);
+
+  void RunCPULongestFirst(WorkspaceBlob *wsb);
+
+  void RunCPUOperatorMajor(WorkspaceBlob *wsb);
+
+  void RunCPUStreaming(int queue_idx);
+
+  void RunCPUStreamingSample(int queue_idx, int data_idx, int tid);
+
+  void SetupSchedulingForGraph();
+
+  void SetupStreamingForGraph();
+
+  void SetSupportOutputsForIter(WorkspaceBlob *wsb);
+
+  void SetupDirectOutputsForGraph();
+
+  void SetDirectOutputsForIter(int queue_idx);
+
+  void RecordDirectOutputShapes(int queue_idx);
+
+  void SetupStatisticsForGraph();
+
+  void SetupTracingForGraph();
+
+  void SetupMemoryTagsForGraph();
+
+  // Runs the op, recording its run time and
+  // output size when the statistics are enabled
+  template <typename Workspace>
+  inline void RunOp(const OpNode &op_node, Workspace *ws) {
+    MemoryTagScope memory_scope(op_memory_tags_[op_node.id].get());
+    if (!statistics_enabled_) {
+      op_node.op->Run(ws);
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    op_node.op->Run(ws);
+    std::chrono::duration<double, std::micro> time =
+        std::chrono::steady_clock::now() - start;
+    OpStats &stats = *op_stats_[op_node.id];
+    stats.run_time.Record(time.count());
+    stats.bytes_produced.fetch_add(OutputBytes(ws), std::memory_order_relaxed);
+    RecordSampleBytes(&stats, ws);
+  }
+
+  void RunOpBatch(const OpNode &op_node, HostWorkspace *ws);
+
+  static size_t OutputBytes(SampleWorkspace *ws);
+  static size_t OutputBytes(SupportWorkspace *ws);
+  static size_t OutputBytes(MixedWorkspace *ws);
+  static size_t OutputBytes(DeviceWorkspace *ws);
+
+  struct OpStats;
+  // Keeps the largest size of a sample of each output of the ops
+  static void RecordSampleBytes(OpStats *stats, SampleWorkspace *ws);
+  static void RecordSampleBytes(OpStats *stats, MixedWorkspace *ws);
+  static void RecordSampleBytes(OpStats *stats, DeviceWorkspace *ws);
+  template <typename Workspace>
+  static inline void RecordSampleBytes(OpStats *, Workspace *) {}
+
+  // Number of chunks per thread the batch is split into in the
+  // operator-major mode, more than one to balance uneven samples
+  static const int kOperatorMajorChunksPerThread = 2;
+
   template <typename Backend>
   class TensorListPool {
    public:
-    inline TensorListPool(int size, int batch_size, size_t bytes_hint) {
+    inline TensorListPool(int size, int batch_size, size_t bytes_hint,
+                          const BufferPolicy &policy, const shared_ptr<MemoryTag> &tag) {
       for (int i = 0; i < size; ++i) {
         tls_.push_back(std::make_shared<TensorList<Backend>>());
+        tls_.back()->set_policy(policy);
+        tls_.back()->set_memory_tag(tag);
         tls_.back()->Resize({{batch_size*(Index)bytes_hint}});
       }
     }
@@ -142,8 +373,13 @@ class DLL_PUBLIC Executor {
 
   int batch_size_, device_id_;
   size_t bytes_per_sample_hint_;
+  BufferPolicy buffer_policy_;
   int queue_depth_;
   int previous_gpu_queue_idx_ = -1;
+  // Index of the next iteration to run, RunCPU is not reentrant
+  int64 iteration_ = 0;
+  CPUExecutionMode cpu_execution_mode_ = DALI_CPU_SAMPLE_MAJOR;
+  CPUSchedulingPolicy cpu_scheduling_policy_ = DALI_CPU_SCHEDULE_IN_ORDER;
 
   vector<string> output_names_;
   std::map<string, int> type_idx_map_;
@@ -190,10 +426,86 @@ class DLL_PUBLIC Executor {
   std::queue<int> mixed_work_queue_, gpu_work_queue_;
   std::mutex mixed_mutex_, gpu_mutex_;
 
+  // In the streaming mode the cpu work of a batch is tracked with
+  // counters of its samples still to go through the source ops and
+  // through all the ops. Each sample is run by one batch at a time,
+  // the other batches wait in its queue and are issued in order.
+  struct StreamingBatch {
+    int sources_pending = 0;
+    int samples_pending = 0;
+  };
+  struct StreamingSample {
+    bool busy = false;
+    std::queue<int> waiting;
+  };
+  vector<StreamingBatch> streaming_batches_;
+  vector<StreamingSample> streaming_samples_;
+  std::mutex streaming_mutex_;
+  std::condition_variable streaming_cond_;
+
+  // Index of the last cpu op without regular inputs. Once a sample
+  // went through it, all source ops are done with that sample.
+  int last_source_op_ = -1;
+  // Indices of the cpu ops without and with regular inputs, in
+  // topological order. Used by the longest-first scheduling
+  vector<int> source_ops_, dependent_ops_;
+  SampleCostModel cost_model_;
+  // Features of each sample of the batch, and the
+  // run times of each of the dependent ops on it
+  vector<SampleCostModel::Features> sample_features_;
+  vector<double> sample_op_times_;
+
+  // Statistics of each op, indexed by NodeID
+  struct OpStats {
+    explicit OpStats(int num_output)
+      : max_sample_bytes(new std::atomic<size_t>[num_output]) {
+      for (int i = 0; i < num_output; ++i) max_sample_bytes[i] = 0;
+    }
+
+    LatencyHistogram run_time;
+    std::atomic<uint64_t> bytes_produced{0};
+    std::unique_ptr<std::atomic<size_t>[]> max_sample_bytes;
+  };
+  vector<std::unique_ptr<OpStats>> op_stats_;
+  LatencyHistogram free_queue_wait_, ready_queue_wait_;
+  std::atomic<int64> stats_iterations_{0};
+  std::atomic<bool> statistics_enabled_{false};
+
+  // Shapes of the samples of the outputs of each op, indexed by NodeID,
+  // as far as the schemas can infer them when the graph is built
+  vector<vector<SampleShape>> inferred_shapes_;
+
+  // The cpu outputs that the cpu ops write directly into their slot of
+  // the output batch, so that gathering them copies nothing. Their
+  // shapes are the inferred ones, or are predicted from the previous
+  // iterations: once two iterations in a row agree, the output batch is
+  // laid out before the cpu ops run and each sample of the op output is
+  // a view into it.
+  struct DirectOutput {
+    int cpu_output;  // index in cpu_outputs_
+    int cpu_op, output_idx;
+    TypeInfo type;
+    vector<Dims> shapes;
+    bool stable = false;
+  };
+  vector<DirectOutput> direct_outputs_;
+
+  // Shared buffers of the outputs of the cpu ops
+  BufferPlanner buffer_plan_;
+  vector<shared_ptr<Tensor<CPUBackend>>> shared_cpu_buffers_;
+
+  // Interned names of the trace ranges of the ops, indexed by NodeID
+  vector<const char*> op_trace_names_;
+
+  // Memory accounting, with the tags of the ops indexed by NodeID
+  std::shared_ptr<MemoryTracker> memory_tracker_ = std::make_shared<MemoryTracker>();
+  vector<std::shared_ptr<MemoryTag>> op_memory_tags_;
+  vector<ScratchArena> scratch_arenas_;
+
   OpGraph *graph_ = nullptr;
   StreamPool stream_pool_;
   EventPool event_pool_;
-  ThreadPool thread_pool_;
+  WorkStealingThreadPool thread_pool_;
   std::vector<std::string> errors_;
   std::mutex errors_mutex_;
   bool exec_error_;
@@ -206,6 +518,8 @@ class DLL_PUBLIC Executor {
   using Executor::batch_size_;                             \
   using Executor::device_id_;                              \
   using Executor::bytes_per_sample_hint_;                  \
+  using Executor::buffer_policy_;                          \
+  using Executor::memory_tracker_;                         \
   using Executor::queue_depth_;                            \
   using Executor::output_names_;                           \
   using Executor::type_idx_map_;                           \
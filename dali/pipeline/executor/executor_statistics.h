@@ -0,0 +1,69 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR_STATISTICS_H_
+#define DALI_PIPELINE_EXECUTOR_EXECUTOR_STATISTICS_H_
+
+#include <string>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/pipeline/util/latency_histogram.h"
+
+namespace dali {
+
+/**
+ * @brief Execution statistics of an op
+ */
+struct OpStatistics {
+  std::string name;
+  std::string device;
+  // Run times, per sample for cpu ops and per batch for the other ops.
+  // For mixed and gpu ops it is the time taken to issue the work.
+  TimingStatistics run_time;
+  uint64_t bytes_produced = 0;
+  // Time spent waiting for the data loaded by the prefetch thread,
+  // per batch, for readers only
+  TimingStatistics prefetch_wait;
+  // Size of the largest sample of each output, not collected
+  // for the support ops
+  std::vector<size_t> max_sample_bytes;
+};
+
+/**
+ * @brief Execution statistics of a pipeline, collected since the
+ * statistics were enabled or last reset
+ */
+struct ExecutorStatistics {
+  int64 iterations = 0;
+  std::vector<OpStatistics> ops;
+  // Time the cpu stage waited for a free output buffer, i.e. for the
+  // user to release the outputs
+  TimingStatistics free_queue_wait;
+  // Time the user waited for the outputs to be ready
+  TimingStatistics ready_queue_wait;
+  // Per-sample outputs of the cpu ops that share buffers: the most
+  // memory they need at once, from the largest size of each output
+  // seen while collecting statistics, and the memory allocated for
+  // their buffers
+  size_t planned_peak_bytes = 0;
+  size_t allocated_bytes = 0;
+  // Size of the largest sample of any output. A `bytes_per_sample_hint`
+  // of at least this presizes the buffers so that they never grow.
+  size_t max_sample_bytes = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_EXECUTOR_STATISTICS_H_
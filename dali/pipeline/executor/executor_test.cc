@@ -391,6 +391,513 @@ TEST_F(ExecutorTest, TestRunBasicGraph) {
   ASSERT_TRUE(ws.OutputIsType<CPUBackend>(0));
 }
 
+TEST_F(ExecutorTest, TestRunOperatorMajor) {
+  Executor exe(this->batch_size_, 2, 0, 1);
+  exe.SetCPUExecutionMode(DALI_CPU_OPERATOR_MAJOR);
+
+  // Build a basic cpu->gpu graph
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("HostDecoder")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("images", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("images", "cpu")
+          .AddOutput("final_images", "gpu")), "");
+
+  vector<string> outputs = {"final_images_gpu"};
+  exe.Build(&graph, outputs);
+
+  // Set the data for the external source
+  auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  this->MakeJPEGBatch(&tl, this->batch_size_);
+  src_op->SetDataSource(tl);
+
+  exe.RunCPU();
+  exe.RunMixed();
+  exe.RunGPU();
+
+  DeviceWorkspace ws;
+  exe.Outputs(&ws);
+  ASSERT_EQ(ws.NumOutput(), 1);
+  ASSERT_TRUE(ws.OutputIsType<GPUBackend>(0));
+  TensorList<GPUBackend> *res = ws.Output<GPUBackend>(0);
+  for (int i = 0; i < this->batch_size_; ++i) {
+    this->VerifyDecode(
+        res->template tensor<uint8>(i),
+        res->tensor_shape(i)[0],
+        res->tensor_shape(i)[1], i);
+  }
+}
+
+TEST_F(ExecutorTest, TestRunLongestFirst) {
+  Executor exe(this->batch_size_, 2, 0, 1);
+  exe.SetCPUSchedulingPolicy(DALI_CPU_SCHEDULE_LONGEST_FIRST);
+
+  // Build a basic cpu->gpu graph
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("HostDecoder")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("images", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("images", "cpu")
+          .AddOutput("final_images", "gpu")), "");
+
+  vector<string> outputs = {"final_images_gpu"};
+  exe.Build(&graph, outputs);
+
+  // Set the data for the external source
+  auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  this->MakeJPEGBatch(&tl, this->batch_size_);
+
+  // Run twice, the second time with the estimates refined by the first
+  DeviceWorkspace ws;
+  for (int iter = 0; iter < 2; ++iter) {
+    src_op->SetDataSource(tl);
+    exe.RunCPU();
+    exe.RunMixed();
+    exe.RunGPU();
+    exe.Outputs(&ws);
+  }
+  ASSERT_EQ(ws.NumOutput(), 1);
+  ASSERT_TRUE(ws.OutputIsType<GPUBackend>(0));
+  TensorList<GPUBackend> *res = ws.Output<GPUBackend>(0);
+  for (int i = 0; i < this->batch_size_; ++i) {
+    this->VerifyDecode(
+        res->template tensor<uint8>(i),
+        res->tensor_shape(i)[0],
+        res->tensor_shape(i)[1], i);
+  }
+}
+
+TEST_F(ExecutorTest, TestRunLongestFirstLateSource) {
+  Executor exe(this->batch_size_, this->num_threads_, 0, 1);
+  exe.SetCPUSchedulingPolicy(DALI_CPU_SCHEDULE_LONGEST_FIRST);
+
+  // The first Copy sorts before the second source op,
+  // but only runs once all the source ops are done
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("copy", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data2", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("data2", "cpu")
+          .AddOutput("copy2", "cpu")), "");
+
+  for (const char *name : {"copy", "copy2"}) {
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("MakeContiguous")
+            .AddArg("device", "mixed")
+            .AddInput(name, "cpu")
+            .AddOutput(string("final_") + name, "cpu")), "");
+  }
+
+  vector<string> outputs = {"final_copy_cpu", "final_copy2_cpu"};
+  exe.Build(&graph, outputs);
+
+  // The samples of the second source are the largest ones first
+  TensorList<CPUBackend> tl[2];
+  for (int i = 0; i < 2; ++i) {
+    auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(2 * i));
+    ASSERT_NE(src_op, nullptr);
+    vector<Dims> shapes;
+    for (int j = 0; j < this->batch_size_; ++j) {
+      shapes.push_back({i == 0 ? j + 1 : this->batch_size_ - j});
+    }
+    tl[i].set_type(TypeInfo::Create<uint8>());
+    tl[i].Resize(shapes);
+    for (int j = 0; j < this->batch_size_; ++j) {
+      for (int k = 0; k < shapes[j][0]; ++k) {
+        tl[i].template mutable_tensor<uint8>(j)[k] = i + j + k;
+      }
+    }
+    src_op->SetDataSource(tl[i]);
+  }
+
+  exe.RunCPU();
+  exe.RunMixed();
+  exe.RunGPU();
+
+  DeviceWorkspace ws;
+  exe.Outputs(&ws);
+  ASSERT_EQ(ws.NumOutput(), 2);
+  for (int i = 0; i < 2; ++i) {
+    TensorList<CPUBackend> *res = ws.Output<CPUBackend>(i);
+    for (int j = 0; j < this->batch_size_; ++j) {
+      ASSERT_EQ(res->tensor_shape(j), tl[i].tensor_shape(j));
+      for (int k = 0; k < tl[i].tensor_shape(j)[0]; ++k) {
+        ASSERT_EQ(res->template tensor<uint8>(j)[k], i + j + k);
+      }
+    }
+  }
+}
+
+TEST_F(ExecutorTest, TestRunInPlace) {
+  const int H = 4, W = 5, C = 3;
+  TensorList<CPUBackend> tl;
+  tl.set_type(TypeInfo::Create<uint8>());
+  tl.Resize(vector<Dims>(this->batch_size_, {H, W, C}));
+  for (int j = 0; j < this->batch_size_; ++j) {
+    for (int k = 0; k < H * W * C; ++k) {
+      tl.template mutable_tensor<uint8>(j)[k] = (j * 31 + k * 17) % 256;
+    }
+  }
+
+  // ColorTwist runs in place when it is the only reader of the output
+  // of the first Copy, and out of place when that output is also kept
+  TensorList<CPUBackend> res[2];
+  for (bool keep_copy : {false, true}) {
+    Executor exe(this->batch_size_, this->num_threads_, 0, 1);
+    OpGraph graph;
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("ExternalSource")
+            .AddArg("device", "cpu")
+            .AddOutput("data", "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("Copy")
+            .AddArg("device", "cpu")
+            .AddInput("data", "cpu")
+            .AddOutput("copy", "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("ColorTwist")
+            .AddArg("device", "cpu")
+            .AddArg("hue", 40.f)
+            .AddArg("saturation", 0.5f)
+            .AddArg("contrast", 1.5f)
+            .AddArg("brightness", 0.8f)
+            .AddInput("copy", "cpu")
+            .AddOutput("twisted", "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("Copy")
+            .AddArg("device", "cpu")
+            .AddInput("twisted", "cpu")
+            .AddOutput("copy_twisted", "cpu")), "");
+
+    vector<string> outputs;
+    for (string name : {"copy_twisted", "copy"}) {
+      if (name == "copy" && !keep_copy) continue;
+      graph.AddOp(this->PrepareSpec(
+              OpSpec("MakeContiguous")
+              .AddArg("device", "mixed")
+              .AddInput(name, "cpu")
+              .AddOutput("final_" + name, "cpu")), "");
+      outputs.push_back("final_" + name + "_cpu");
+    }
+    exe.Build(&graph, outputs);
+
+    auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+    ASSERT_NE(src_op, nullptr);
+    src_op->SetDataSource(tl);
+
+    exe.RunCPU();
+    exe.RunMixed();
+    exe.RunGPU();
+
+    DeviceWorkspace ws;
+    exe.Outputs(&ws);
+    res[keep_copy].Copy(*ws.Output<CPUBackend>(0), 0);
+
+    vector<HostWorkspace> cpu_data = this->CPUData(&exe, 0);
+    for (int j = 0; j < this->batch_size_; ++j) {
+      ASSERT_EQ(cpu_data[2].Output<CPUBackend>(0, j)->raw_data() ==
+                cpu_data[1].Output<CPUBackend>(0, j)->raw_data(), !keep_copy);
+    }
+  }
+
+  for (int j = 0; j < this->batch_size_; ++j) {
+    ASSERT_EQ(res[0].tensor_shape(j), Dims({H, W, C}));
+    for (int k = 0; k < H * W * C; ++k) {
+      ASSERT_EQ(res[0].template tensor<uint8>(j)[k], res[1].template tensor<uint8>(j)[k]);
+    }
+  }
+}
+
+TEST_F(ExecutorTest, TestStridedOutputsAcrossStages) {
+  const int batch_size = this->batch_size_;
+  const int iters = 3;
+
+  // The crop is a view into the decoded images when it is passed to the
+  // mixed stage, and a dense copy when it goes through Copy. The cpu
+  // stage runs all iterations before the mixed stage reads the views
+  for (bool async : {false, true}) {
+    std::unique_ptr<Executor> exe;
+    if (async) {
+      exe.reset(new AsyncPipelinedExecutor(batch_size, this->num_threads_, 0, 1));
+    } else {
+      exe.reset(new PipelinedExecutor(batch_size, this->num_threads_, 0, 1));
+    }
+    exe->Init();
+
+    OpGraph graph;
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("ExternalSource")
+            .AddArg("device", "cpu")
+            .AddOutput("data", "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("HostDecoder")
+            .AddArg("device", "cpu")
+            .AddInput("data", "cpu")
+            .AddOutput("images", "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("Crop")
+            .AddArg("device", "cpu")
+            .AddArg("crop", vector<int>{32, 32})
+            .AddInput("images", "cpu")
+            .AddOutput("crop", "cpu")), "");
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("Copy")
+            .AddArg("device", "cpu")
+            .AddInput("crop", "cpu")
+            .AddOutput("dense_crop", "cpu")), "");
+
+    vector<string> outputs;
+    for (const char *name : {"crop", "dense_crop"}) {
+      graph.AddOp(this->PrepareSpec(
+              OpSpec("MakeContiguous")
+              .AddArg("device", "mixed")
+              .AddInput(name, "cpu")
+              .AddOutput(string("final_") + name, "cpu")), "");
+      outputs.push_back(string("final_") + name + "_cpu");
+    }
+    exe->Build(&graph, outputs);
+
+    auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+    ASSERT_NE(src_op, nullptr);
+    for (int i = 0; i < iters; ++i) {
+      // Each iteration decodes the images in a different order
+      vector<Tensor<CPUBackend>> jpegs;
+      this->MakeJPEGBatch(&jpegs, batch_size + i);
+      jpegs.erase(jpegs.begin(), jpegs.begin() + i);
+      src_op->SetDataSource(jpegs);
+      exe->RunCPU();
+    }
+    for (int i = 0; i < iters; ++i) {
+      exe->RunMixed();
+      exe->RunGPU();
+    }
+
+    for (int i = 0; i < iters; ++i) {
+      DeviceWorkspace ws;
+      exe->Outputs(&ws);
+      ASSERT_EQ(ws.NumOutput(), 2);
+      const TensorList<CPUBackend> *crop = ws.Output<CPUBackend>(0);
+      const TensorList<CPUBackend> *dense_crop = ws.Output<CPUBackend>(1);
+      for (int j = 0; j < batch_size; ++j) {
+        ASSERT_EQ(crop->tensor_shape(j), Dims({32, 32, 3}));
+        ASSERT_EQ(dense_crop->tensor_shape(j), Dims({32, 32, 3}));
+        for (int k = 0; k < 32 * 32 * 3; ++k) {
+          ASSERT_EQ(crop->template tensor<uint8>(j)[k], dense_crop->template tensor<uint8>(j)[k]);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(ExecutorTest, TestStreamingWithoutStridedOutputs) {
+  const int batch_size = this->batch_size_;
+  const int iters = 2;
+
+  // The crop is only read by the mixed stage. In the streaming mode the
+  // decoder of the next batch overwrites the images before that, so the
+  // crop can not be a view into them
+  auto build = [this](Executor *exe, OpGraph *graph, bool strided) {
+    graph->AddOp(this->PrepareSpec(
+            OpSpec("ExternalSource")
+            .AddArg("device", "cpu")
+            .AddOutput("data", "cpu")), "");
+
+    graph->AddOp(this->PrepareSpec(
+            OpSpec("HostDecoder")
+            .AddArg("device", "cpu")
+            .AddInput("data", "cpu")
+            .AddOutput("images", "cpu")), "");
+
+    graph->AddOp(this->PrepareSpec(
+            OpSpec("Crop")
+            .AddArg("device", "cpu")
+            .AddArg("crop", vector<int>{32, 32})
+            .AddArg("strided_outputs", strided)
+            .AddInput("images", "cpu")
+            .AddOutput("crop", "cpu")), "");
+
+    graph->AddOp(this->PrepareSpec(
+            OpSpec("MakeContiguous")
+            .AddArg("device", "mixed")
+            .AddInput("crop", "cpu")
+            .AddOutput("final_crop", "cpu")), "");
+    exe->Build(graph, {"final_crop_cpu"});
+  };
+
+  {
+    Executor exe(batch_size, this->num_threads_, 0, 1);
+    exe.SetCPUExecutionMode(DALI_CPU_STREAMING);
+    ASSERT_FALSE(exe.AllowsStridedOutputs());
+    OpGraph graph;
+    ASSERT_THROW(build(&exe, &graph, true), std::runtime_error);
+  }
+
+  Executor exe(batch_size, this->num_threads_, 0, 1);
+  exe.SetCPUExecutionMode(DALI_CPU_STREAMING);
+  OpGraph graph;
+  build(&exe, &graph, false);
+  // The same crops, one iteration at a time
+  Executor ref_exe(batch_size, this->num_threads_, 0, 1);
+  OpGraph ref_graph;
+  build(&ref_exe, &ref_graph, true);
+
+  auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+  auto *ref_src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&ref_graph.cpu_op(0));
+  ASSERT_NE(src_op, nullptr);
+  ASSERT_NE(ref_src_op, nullptr);
+  vector<TensorList<CPUBackend>> ref_crops(iters);
+  for (int i = 0; i < iters; ++i) {
+    // Each iteration decodes the images in a different order
+    vector<Tensor<CPUBackend>> jpegs;
+    this->MakeJPEGBatch(&jpegs, batch_size + i);
+    jpegs.erase(jpegs.begin(), jpegs.begin() + i);
+    src_op->SetDataSource(jpegs);
+    exe.RunCPU();
+
+    ref_src_op->SetDataSource(jpegs);
+    ref_exe.RunCPU();
+    ref_exe.RunMixed();
+    ref_exe.RunGPU();
+    DeviceWorkspace ws;
+    ref_exe.Outputs(&ws);
+    ref_crops[i].Copy(*ws.Output<CPUBackend>(0), 0);
+  }
+  for (int i = 0; i < iters; ++i) {
+    exe.RunMixed();
+    exe.RunGPU();
+  }
+
+  for (int i = 0; i < iters; ++i) {
+    DeviceWorkspace ws;
+    exe.Outputs(&ws);
+    const TensorList<CPUBackend> *crop = ws.Output<CPUBackend>(0);
+    for (int j = 0; j < batch_size; ++j) {
+      ASSERT_EQ(crop->tensor_shape(j), Dims({32, 32, 3}));
+      for (int k = 0; k < 32 * 32 * 3; ++k) {
+        ASSERT_EQ(crop->template tensor<uint8>(j)[k], ref_crops[i].template tensor<uint8>(j)[k]);
+      }
+    }
+  }
+}
+
+TEST_F(ExecutorTest, TestStatistics) {
+  Executor exe(this->batch_size_, 2, 0, 1);
+  exe.EnableStatistics(true);
+
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "src");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("HostDecoder")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("images", "cpu")), "decoder");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("images", "cpu")
+          .AddOutput("final_images", "gpu")), "contiguous");
+
+  vector<string> outputs = {"final_images_gpu"};
+  exe.Build(&graph, outputs);
+
+  auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  this->MakeJPEGBatch(&tl, this->batch_size_);
+
+  const int iters = 3;
+  DeviceWorkspace ws;
+  for (int iter = 0; iter < iters; ++iter) {
+    src_op->SetDataSource(tl);
+    exe.RunCPU();
+    exe.RunMixed();
+    exe.RunGPU();
+    exe.Outputs(&ws);
+  }
+
+  ExecutorStatistics stats = exe.GetStatistics();
+  ASSERT_EQ(stats.iterations, iters);
+  ASSERT_EQ(stats.ops.size(), 3u);
+  ASSERT_EQ(stats.ready_queue_wait.count, iters);
+  for (auto &op_stats : stats.ops) {
+    ASSERT_GT(op_stats.bytes_produced, 0u);
+    ASSERT_EQ(op_stats.prefetch_wait.count, 0);
+    ASSERT_EQ(op_stats.max_sample_bytes.size(), 1u);
+    ASSERT_GT(op_stats.max_sample_bytes[0], 0u);
+    ASSERT_LE(op_stats.max_sample_bytes[0], stats.max_sample_bytes);
+  }
+  // The cpu ops are timed per sample, the other ones per batch
+  ASSERT_EQ(stats.ops[0].name, "src");
+  ASSERT_EQ(stats.ops[0].device, "cpu");
+  ASSERT_EQ(stats.ops[0].run_time.count, iters * this->batch_size_);
+  ASSERT_EQ(stats.ops[1].name, "decoder");
+  ASSERT_EQ(stats.ops[1].run_time.count, iters * this->batch_size_);
+  ASSERT_EQ(stats.ops[2].name, "contiguous");
+  ASSERT_EQ(stats.ops[2].device, "mixed");
+  ASSERT_EQ(stats.ops[2].run_time.count, iters);
+
+  exe.ResetStatistics();
+  stats = exe.GetStatistics();
+  ASSERT_EQ(stats.iterations, 0);
+  ASSERT_EQ(stats.ops[1].run_time.count, 0);
+  ASSERT_EQ(stats.ops[1].bytes_produced, 0u);
+  ASSERT_EQ(stats.ops[1].max_sample_bytes[0], 0u);
+  ASSERT_EQ(stats.max_sample_bytes, 0u);
+}
+
 TEST_F(ExecutorTest, TestPrefetchedExecution) {
   int batch_size = this->batch_size_ / 2;
   this->set_batch_size(batch_size);
@@ -492,4 +999,231 @@ TEST_F(ExecutorTest, TestPrefetchedExecution) {
   }
 }
 
+TEST_F(ExecutorTest, TestStreamingPrefetchedExecution) {
+  int batch_size = this->batch_size_ / 2;
+  this->set_batch_size(batch_size);
+  this->SetEps(1.6);
+
+  Executor exe(this->batch_size_, this->num_threads_, 0, 1);
+  exe.SetCPUExecutionMode(DALI_CPU_STREAMING);
+
+  // Build a basic cpu->gpu graph
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("HostDecoder")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("images", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("images", "cpu")
+          .AddOutput("images", "gpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "gpu")
+          .AddInput("images", "gpu")
+          .AddOutput("final_images", "gpu")), "");
+
+  vector<string> outputs = {"final_images_gpu"};
+  exe.Build(&graph, outputs);
+
+  // Set the data for the external source
+  auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  this->MakeJPEGBatch(&tl, this->batch_size_*2);
+
+  // Split the batch into two
+  TensorList<CPUBackend> tl2;
+  TensorList<CPUBackend> tl1;
+  vector<Dims> shape1(batch_size), shape2(batch_size);
+  for (int i = 0; i < batch_size; ++i) {
+    shape1[i] = tl.tensor_shape(i);
+    shape2[i] = tl.tensor_shape(i+batch_size);
+  }
+  tl1.Resize(shape1);
+  tl2.Resize(shape2);
+  for (int i = 0; i < batch_size; ++i) {
+    std::memcpy(
+        tl1.template mutable_tensor<uint8>(i),
+        tl.template tensor<uint8>(i),
+        Product(tl.tensor_shape(i)));
+    std::memcpy(
+        tl2.template mutable_tensor<uint8>(i),
+        tl.template tensor<uint8>(i+batch_size),
+        Product(tl.tensor_shape(i+batch_size)));
+  }
+
+  // Run twice without getting the results, in the streaming mode
+  // the samples of the second batch may start before the first
+  // batch is done
+  src_op->SetDataSource(tl1);
+  exe.RunCPU();
+  exe.RunMixed();
+  exe.RunGPU();
+
+  src_op->SetDataSource(tl2);
+  exe.RunCPU();
+  exe.RunMixed();
+  exe.RunGPU();
+
+  // Verify that both sets of results are correct
+  DeviceWorkspace ws;
+  exe.Outputs(&ws);
+  ASSERT_EQ(ws.NumOutput(), 1);
+  ASSERT_EQ(ws.NumInput(), 0);
+  ASSERT_TRUE(ws.OutputIsType<GPUBackend>(0));
+  TensorList<GPUBackend> *res1 = ws.Output<GPUBackend>(0);
+  for (int i = 0; i < batch_size; ++i) {
+    this->VerifyDecode(
+        res1->template tensor<uint8>(i),
+        res1->tensor_shape(i)[0],
+        res1->tensor_shape(i)[1], i);
+  }
+
+  exe.Outputs(&ws);
+  ASSERT_EQ(ws.NumOutput(), 1);
+  ASSERT_EQ(ws.NumInput(), 0);
+  ASSERT_TRUE(ws.OutputIsType<GPUBackend>(0));
+  TensorList<GPUBackend> *res2 = ws.Output<GPUBackend>(0);
+  for (int i = 0; i < batch_size; ++i) {
+    this->VerifyDecode(
+        res2->template tensor<uint8>(i),
+        res2->tensor_shape(i)[0],
+        res2->tensor_shape(i)[1],
+        i+batch_size);
+  }
+}
+
+TEST_F(ExecutorTest, TestDirectOutputs) {
+  Executor exe(this->batch_size_, this->num_threads_, 0, 1);
+
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("copy", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("copy", "cpu")
+          .AddOutput("final_copy", "cpu")), "");
+
+  vector<string> outputs = {"final_copy_cpu"};
+  exe.Build(&graph, outputs);
+
+  auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+  ASSERT_NE(src_op, nullptr);
+
+  // The shapes change after 3 iterations
+  const Index heights[] = {2, 2, 2, 4, 4, 4};
+  for (int it = 0; it < 6; ++it) {
+    TensorList<CPUBackend> tl;
+    tl.set_type(TypeInfo::Create<uint8>());
+    tl.Resize(vector<Dims>(this->batch_size_, {heights[it], 3}));
+    for (int j = 0; j < this->batch_size_; ++j) {
+      for (int k = 0; k < heights[it] * 3; ++k) {
+        tl.template mutable_tensor<uint8>(j)[k] = it + j + k;
+      }
+    }
+    src_op->SetDataSource(tl);
+
+    exe.RunCPU();
+    exe.RunMixed();
+    exe.RunGPU();
+
+    DeviceWorkspace ws;
+    exe.Outputs(&ws);
+    ASSERT_EQ(ws.NumOutput(), 1);
+    TensorList<CPUBackend> *res = ws.Output<CPUBackend>(0);
+    vector<HostWorkspace> cpu_data = this->CPUData(&exe, 0);
+    for (int j = 0; j < this->batch_size_; ++j) {
+      ASSERT_EQ(res->tensor_shape(j), Dims({heights[it], 3}));
+      for (int k = 0; k < heights[it] * 3; ++k) {
+        ASSERT_EQ(res->template tensor<uint8>(j)[k], it + j + k);
+      }
+      // Once the shapes were the same twice, Copy writes into the output
+      const bool direct = it == 2 || it == 5;
+      ASSERT_EQ(res->raw_tensor(j) == cpu_data[1].Output<CPUBackend>(0, j)->raw_data(), direct);
+    }
+  }
+}
+
+TEST_F(ExecutorTest, TestInferredShapes) {
+  Executor exe(this->batch_size_, this->num_threads_, 0, 1);
+
+  OpGraph graph;
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("NormalizePermute")
+          .AddArg("device", "cpu")
+          .AddArg("height", 2)
+          .AddArg("width", 3)
+          .AddArg("mean", vector<float>{0.f})
+          .AddArg("std", vector<float>{1.f})
+          .AddInput("data", "cpu")
+          .AddOutput("normalized", "cpu")), "");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("MakeContiguous")
+          .AddArg("device", "mixed")
+          .AddInput("normalized", "cpu")
+          .AddOutput("final_normalized", "cpu")), "");
+
+  vector<string> outputs = {"final_normalized_cpu"};
+  exe.Build(&graph, outputs);
+
+  auto *src_op = dynamic_cast<ExternalSource<CPUBackend>*>(&graph.cpu_op(0));
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  tl.set_type(TypeInfo::Create<uint8>());
+  tl.Resize(vector<Dims>(this->batch_size_, {2, 3, 3}));
+  for (int j = 0; j < this->batch_size_; ++j) {
+    for (int k = 0; k < 2 * 3 * 3; ++k) {
+      tl.template mutable_tensor<uint8>(j)[k] = j + k;
+    }
+  }
+  src_op->SetDataSource(tl);
+
+  exe.RunCPU();
+  exe.RunMixed();
+  exe.RunGPU();
+
+  // The shape is known before the first iteration, so
+  // NormalizePermute writes into the output right away
+  DeviceWorkspace ws;
+  exe.Outputs(&ws);
+  TensorList<CPUBackend> *res = ws.Output<CPUBackend>(0);
+  vector<HostWorkspace> cpu_data = this->CPUData(&exe, 0);
+  ASSERT_TRUE(IsType<float>(res->type()));
+  for (int j = 0; j < this->batch_size_; ++j) {
+    ASSERT_EQ(res->tensor_shape(j), Dims({3, 2, 3}));
+    ASSERT_EQ(res->raw_tensor(j), cpu_data[1].Output<CPUBackend>(0, j)->raw_data());
+    for (int c = 0; c < 3; ++c) {
+      for (int k = 0; k < 2 * 3; ++k) {
+        ASSERT_EQ(res->template tensor<float>(j)[c * 6 + k], j + k * 3 + c);
+      }
+    }
+  }
+}
+
 }  // namespace dali
@@ -37,6 +37,7 @@ void PipelinedExecutor::Build(OpGraph *graph, vector<string> output_names) {
 void PipelinedExecutor::SetupStageOutputsForGraph() {
   // Make a set of the outputs names for quick lookup
   std::set<string> output_set(output_names_.begin(), output_names_.end());
+  auto stage_queue_tag = memory_tracker_->Tag("[Executor] stage queues");
 
   for (int i = 0; i < graph_->NumSupportOp(); ++i) {
     // Find all outputs of the support stage. An output is
@@ -69,7 +70,8 @@ void PipelinedExecutor::SetupStageOutputsForGraph() {
         support_stage_output_info_.push_back(info);
         support_stage_outputs_.push_back(
             TensorPool<CPUBackend>(
-                queue_depth_, batch_size_, bytes_per_sample_hint_));
+                queue_depth_, batch_size_, OutputBytesHint(node.id, j), buffer_policy_,
+                stage_queue_tag));
         for (auto &meta : consumer_meta) {
           OutputInfo &info = support_stage_output_info_.back();
           auto tmp = std::make_pair(meta.node, meta.index);
@@ -79,6 +81,29 @@ void PipelinedExecutor::SetupStageOutputsForGraph() {
     }
   }
 
+  // Outputs of the cpu stage can be views into the inputs of their op.
+  // The next iteration must not overwrite these inputs either while the
+  // later stages read the views, so they are queued like the outputs
+  std::set<string> view_inputs;
+  for (int i = graph_->NumCPUOp() - 1; i >= 0; --i) {
+    OpNode &node = graph_->cpu_node(i);
+    bool view_output = false;
+    for (int j = 0; j < node.spec.NumOutput(); ++j) {
+      if (!buffer_plan_.IsView(i, j)) continue;
+      const string &tensor_name = node.spec.Output(j);
+      if (view_inputs.count(tensor_name) != 0) view_output = true;
+      for (auto &meta : graph_->TensorConsumerMeta(tensor_name)) {
+        if (graph_->NodeType(meta.node) != DALI_CPU) view_output = true;
+      }
+    }
+    if (!view_output) continue;
+    for (int k = 0; k < node.spec.NumRegularInput(); ++k) {
+      if (graph_->NodeType(graph_->TensorSourceID(node.spec.Input(k))) == DALI_CPU) {
+        view_inputs.insert(node.spec.Input(k));
+      }
+    }
+  }
+
   for (int i = 0; i < graph_->NumCPUOp(); ++i) {
     // Find all outputs of the cpu stage. An output is
     // a tensor that is used by an op in a later stage.
@@ -92,7 +117,7 @@ void PipelinedExecutor::SetupStageOutputsForGraph() {
 
       vector<TensorMeta> consumer_meta =
         graph_->TensorConsumerMeta(tensor_name);
-      bool found_stage_boundary = false;
+      bool found_stage_boundary = view_inputs.count(tensor_name) != 0;
       for (auto &meta : consumer_meta) {
         if (graph_->NodeType(meta.node) != DALI_CPU) {
           // We've located a tensor that is an output of
@@ -106,7 +131,8 @@ void PipelinedExecutor::SetupStageOutputsForGraph() {
         cpu_stage_output_info_.push_back(info);
         cpu_stage_outputs_.push_back(
             TensorVectorPool<CPUBackend>(
-                queue_depth_, batch_size_, bytes_per_sample_hint_));
+                queue_depth_, batch_size_, OutputBytesHint(node.id, j), buffer_policy_,
+                stage_queue_tag));
         for (auto &meta : consumer_meta) {
           OutputInfo &info = cpu_stage_output_info_.back();
           auto tmp = std::make_pair(meta.node, meta.index);
@@ -139,7 +165,8 @@ void PipelinedExecutor::SetupStageOutputsForGraph() {
               mixed_stage_cpu_output_info_.push_back(info);
               mixed_stage_cpu_outputs_.push_back(
                   TensorListPool<CPUBackend>(
-                      queue_depth_, batch_size_, bytes_per_sample_hint_));
+                      queue_depth_, batch_size_, OutputBytesHint(node.id, j), buffer_policy_,
+                      stage_queue_tag));
               has_info_object = true;
             }
 
@@ -158,7 +185,8 @@ void PipelinedExecutor::SetupStageOutputsForGraph() {
               mixed_stage_gpu_output_info_.push_back(info);
               mixed_stage_gpu_outputs_.push_back(
                   TensorListPool<GPUBackend>(
-                      queue_depth_, batch_size_, bytes_per_sample_hint_));
+                      queue_depth_, batch_size_, OutputBytesHint(node.id, j), buffer_policy_,
+                      stage_queue_tag));
               has_info_object = true;
             }
 
@@ -49,6 +49,11 @@ class DLL_PUBLIC PipelinedExecutor : public Executor {
 
   DLL_PUBLIC void Build(OpGraph *graph, vector<string> output_names) override;
 
+  // The inputs of the views read by the later stages are queued
+  DLL_PUBLIC bool AllowsStridedOutputs() const override {
+    return true;
+  }
+
   DISABLE_COPY_MOVE_ASSIGN(PipelinedExecutor);
 
  protected:
@@ -59,11 +64,14 @@ class DLL_PUBLIC PipelinedExecutor : public Executor {
   template <typename Backend>
   class TensorVectorPool {
    public:
-    inline TensorVectorPool(int size, int batch_size, size_t bytes_hint) {
+    inline TensorVectorPool(int size, int batch_size, size_t bytes_hint,
+                            const BufferPolicy &policy, const shared_ptr<MemoryTag> &tag) {
       tvs_.resize(size);
       for (int i = 0; i < size; ++i) {
         for (int j = 0; j < batch_size; ++j) {
           tvs_[i].push_back(std::make_shared<Tensor<Backend>>());
+          tvs_[i].back()->set_policy(policy);
+          tvs_[i].back()->set_memory_tag(tag);
           tvs_[i].back()->Resize({(Index)bytes_hint});
           tvs_[i].back()->set_pinned(false);
         }
@@ -80,9 +88,12 @@ class DLL_PUBLIC PipelinedExecutor : public Executor {
   template <typename Backend>
   class TensorPool {
    public:
-    inline TensorPool(int size, int, size_t bytes_hint) {
+    inline TensorPool(int size, int, size_t bytes_hint, const BufferPolicy &policy,
+                      const shared_ptr<MemoryTag> &tag) {
       for (int i = 0; i < size; ++i) {
         ts_.push_back(std::make_shared<Tensor<Backend>>());
+        ts_.back()->set_policy(policy);
+        ts_.back()->set_memory_tag(tag);
         ts_.back()->Resize({(Index)bytes_hint});
       }
     }
@@ -101,7 +112,9 @@ class DLL_PUBLIC PipelinedExecutor : public Executor {
   // be in use. To do this, we find all outputs of the
   // cpu & mixed stages of the pipeline that aren't
   // outputs requested by the user and setup `queue_depth`
-  // extra buffers that we will rotate between. Note that
+  // extra buffers that we will rotate between. The inputs
+  // of the cpu ops whose outputs are views read by a later
+  // stage are queued the same way. Note that
   // we do not worry about CPU outputs of the mixed
   // stage, as these will only be created as outputs
   // requested by the user.
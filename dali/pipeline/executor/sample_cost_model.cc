@@ -0,0 +1,208 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/executor/sample_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "dali/image/generic_image.h"
+#include "dali/image/jpeg.h"
+
+namespace dali {
+
+namespace {
+
+// Smaller tensors are too short to hold any of the image headers
+const Index kMinImageBytes = 32;
+
+}  // namespace
+
+constexpr double SampleCostModel::kDefaultDecay;
+const int SampleCostModel::kNumFeatures;
+const int SampleCostModel::kNumCoeffs;
+
+SampleCostModel::SampleCostModel(int num_ops, double decay) : decay_(decay) {
+  DALI_ENFORCE(decay > 0 && decay <= 1, "Decay of the cost model must be in (0, 1]");
+  Reset(num_ops);
+}
+
+double SampleCostModel::SampleSize(const Tensor<CPUBackend> &sample) {
+  const double bytes = sample.nbytes();
+  if (sample.type().id() != DALI_UINT8 || sample.ndim() != 1 ||
+      sample.size() < kMinImageBytes) {
+    return bytes;
+  }
+
+  // The header only gives the dimensions of the image, but the cost of
+  // decoding and of the ops that follow scales with the pixels
+  const uint8 *data = sample.data<uint8>();
+  const int size = sample.size();
+  int h = 0, w = 0;
+  try {
+    if (CheckIsJPEG(data, size)) {
+      GetJPEGImageDims(data, size, &h, &w);
+    } else if (GetImageDims(data, size, &h, &w) != DALISuccess) {
+      return bytes;
+    }
+  } catch (std::runtime_error &) {
+    return bytes;
+  }
+  return h > 0 && w > 0 ? static_cast<double>(h) * w : bytes;
+}
+
+void SampleCostModel::AddFeatures(const Tensor<CPUBackend> &sample, Features *features) {
+  (*features)[0] += SampleSize(sample);
+  (*features)[1] += sample.nbytes();
+}
+
+double SampleCostModel::Estimate(const Features &features) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (dirty_) Refit();
+  if (!fitted_) return features[0];
+  double estimate = coeffs_[0];
+  for (int f = 0; f < kNumFeatures; ++f) {
+    estimate += coeffs_[f + 1] * features[f];
+  }
+  return estimate;
+}
+
+void SampleCostModel::Update(const Features &features, const double *op_times_us) {
+  Coeffs x;
+  x[0] = 1;
+  std::copy(features.begin(), features.end(), x.begin() + 1);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int i = 0; i < kNumCoeffs; ++i) {
+    for (int j = 0; j < kNumCoeffs; ++j) {
+      sxx_[i][j] = decay_ * sxx_[i][j] + x[i] * x[j];
+    }
+  }
+  for (int op = 0; op < num_ops_; ++op) {
+    const double y = op_times_us[op];
+    for (int i = 0; i < kNumCoeffs; ++i) {
+      sxy_[op][i] = decay_ * sxy_[op][i] + x[i] * y;
+    }
+    syy_[op] = decay_ * syy_[op] + y * y;
+  }
+  dirty_ = true;
+}
+
+SampleCostModel::Coeffs SampleCostModel::FitOp(int op) const {
+  // Tries the fits with every subset of the features and keeps the best
+  // one with no negative coefficient: the time of an op never decreases
+  // with the size of its sample, noise should not reverse the order
+  Coeffs best{};
+  double best_error = std::numeric_limits<double>::infinity();
+  for (int mask = (1 << kNumFeatures) - 1; mask >= 0; --mask) {
+    // The intercept is always fitted
+    int idx[kNumCoeffs];
+    int n = 0;
+    idx[n++] = 0;
+    for (int f = 0; f < kNumFeatures; ++f) {
+      if (mask & (1 << f)) idx[n++] = f + 1;
+    }
+
+    // Solves the normal equations by Gaussian elimination
+    double a[kNumCoeffs][kNumCoeffs + 1];
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        a[i][j] = sxx_[idx[i]][idx[j]];
+      }
+      a[i][n] = sxy_[op][idx[i]];
+    }
+    bool singular = false;
+    for (int c = 0; c < n && !singular; ++c) {
+      int pivot = c;
+      for (int r = c + 1; r < n; ++r) {
+        if (std::abs(a[r][c]) > std::abs(a[pivot][c])) pivot = r;
+      }
+      // Features (almost) constant or proportional to each other so far
+      if (std::abs(a[pivot][c]) <= 1e-9 * sxx_[idx[c]][idx[c]] || a[pivot][c] == 0) {
+        singular = true;
+        break;
+      }
+      std::swap(a[c], a[pivot]);
+      for (int r = 0; r < n; ++r) {
+        if (r == c) continue;
+        const double m = a[r][c] / a[c][c];
+        for (int k = c; k <= n; ++k) {
+          a[r][k] -= m * a[c][k];
+        }
+      }
+    }
+    if (singular) continue;
+
+    Coeffs beta{};
+    bool feasible = true;
+    for (int i = 0; i < n; ++i) {
+      beta[idx[i]] = a[i][n] / a[i][i];
+      if (i > 0 && beta[idx[i]] < 0) feasible = false;
+    }
+    if (!feasible) continue;
+
+    // Weighted sum of the squared errors
+    double error = syy_[op];
+    for (int i = 0; i < kNumCoeffs; ++i) {
+      error -= 2 * beta[i] * sxy_[op][i];
+      for (int j = 0; j < kNumCoeffs; ++j) {
+        error += beta[i] * sxx_[i][j] * beta[j];
+      }
+    }
+    if (error < best_error) {
+      best_error = error;
+      best = beta;
+    }
+  }
+  return best;
+}
+
+void SampleCostModel::Refit() const {
+  coeffs_.fill(0);
+  for (int op = 0; op < num_ops_; ++op) {
+    const Coeffs op_coeffs = FitOp(op);
+    for (int i = 0; i < kNumCoeffs; ++i) {
+      coeffs_[i] += op_coeffs[i];
+    }
+  }
+  fitted_ = false;
+  for (int f = 0; f < kNumFeatures; ++f) {
+    if (coeffs_[f + 1] > 0) fitted_ = true;
+  }
+  dirty_ = false;
+}
+
+void SampleCostModel::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &row : sxx_) row.fill(0);
+  for (auto &row : sxy_) row.fill(0);
+  std::fill(syy_.begin(), syy_.end(), 0);
+  coeffs_.fill(0);
+  dirty_ = fitted_ = false;
+}
+
+void SampleCostModel::Reset(int num_ops) {
+  DALI_ENFORCE(num_ops >= 0, "Number of ops of the cost model must not be negative");
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_ops_ = num_ops;
+    sxy_.resize(num_ops);
+    syy_.resize(num_ops);
+  }
+  Reset();
+}
+
+}  // namespace dali
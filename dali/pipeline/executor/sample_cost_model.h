@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_SAMPLE_COST_MODEL_H_
+#define DALI_PIPELINE_EXECUTOR_SAMPLE_COST_MODEL_H_
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/tensor.h"
+
+namespace dali {
+
+/**
+ * @brief Estimates the time the cpu ops need for a sample from cheap
+ * features of the outputs of the source ops, so the executor can issue
+ * the longest samples of a batch first.
+ *
+ * The features are the size measure of SampleSize() and the number of
+ * bytes. The time of each op is a linear function of them, fitted online
+ * with exponentially weighted least squares to the measured run times of
+ * that op, so it follows the pipeline when the data or the load of the
+ * machine change. As the ops weigh the features differently (e.g. a
+ * decoder the pixels, a parser the bytes), the fitted estimate can order
+ * the samples differently than any of the features alone.
+ * All methods are thread-safe.
+ */
+class DLL_PUBLIC SampleCostModel {
+ public:
+  static const int kNumFeatures = 2;
+  typedef std::array<double, kNumFeatures> Features;
+
+  DLL_PUBLIC explicit SampleCostModel(int num_ops = 1, double decay = kDefaultDecay);
+
+  /**
+   * @brief Returns the size measure of a sample produced by a source op:
+   * the number of pixels if the tensor holds an encoded image with a
+   * readable header, the number of bytes otherwise.
+   */
+  DLL_PUBLIC static double SampleSize(const Tensor<CPUBackend> &sample);
+
+  /**
+   * @brief Adds the features of a sample produced by a source op to
+   * `features`: its SampleSize() and its number of bytes.
+   */
+  DLL_PUBLIC static void AddFeatures(const Tensor<CPUBackend> &sample, Features *features);
+
+  /**
+   * @brief Returns the estimated run time, in microseconds, of the ops
+   * on a sample with the given features. As long as the measured times
+   * show no dependence on the features, it is the size measure itself,
+   * which gives the same order.
+   */
+  DLL_PUBLIC double Estimate(const Features &features) const;
+
+  /**
+   * @brief Refines the estimate with the measured run times
+   * of each of the ops on a sample
+   */
+  DLL_PUBLIC void Update(const Features &features, const double *op_times_us);
+
+  /**
+   * @brief Forgets all measurements
+   */
+  DLL_PUBLIC void Reset();
+
+  /**
+   * @brief Forgets all measurements and sets the number of ops timed
+   */
+  DLL_PUBLIC void Reset(int num_ops);
+
+  static constexpr double kDefaultDecay = 0.99;
+
+ private:
+  // Coefficients of the intercept and of each feature
+  static const int kNumCoeffs = kNumFeatures + 1;
+  typedef std::array<double, kNumCoeffs> Coeffs;
+
+  // Fits the times of the op with non-negative coefficients of
+  // the features, and returns them
+  Coeffs FitOp(int op) const;
+
+  // Refits the coefficients of all ops after new measurements
+  void Refit() const;
+
+  const double decay_;
+  int num_ops_;
+  mutable std::mutex mutex_;
+  // Decayed sums of the products of the coefficients' inputs (1 and the
+  // features), shared by all ops as they are measured on the same samples
+  std::array<Coeffs, kNumCoeffs> sxx_;
+  // Decayed sums of the products of the inputs and the times of each op,
+  // and of the squared times of each op
+  vector<Coeffs> sxy_;
+  vector<double> syy_;
+  // Sum of the coefficients fitted for all ops
+  mutable Coeffs coeffs_;
+  mutable bool dirty_, fitted_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_SAMPLE_COST_MODEL_H_
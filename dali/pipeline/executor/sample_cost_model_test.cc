@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "dali/pipeline/executor/sample_cost_model.h"
+
+namespace dali {
+
+TEST(SampleCostModelTest, SizeOfRawData) {
+  Tensor<CPUBackend> t;
+  t.set_pinned(false);
+  t.Resize({10, 20});
+  t.mutable_data<float>();
+  ASSERT_EQ(SampleCostModel::SampleSize(t), 10 * 20 * sizeof(float));
+
+  // Not an image header
+  t.Resize({1000});
+  std::memset(t.mutable_data<uint8>(), 0, 1000);
+  ASSERT_EQ(SampleCostModel::SampleSize(t), 1000);
+}
+
+TEST(SampleCostModelTest, SizeOfEncodedImage) {
+  // BMP with a BITMAPINFOHEADER, only the header is needed
+  Tensor<CPUBackend> t;
+  t.set_pinned(false);
+  t.Resize({64});
+  uint8 *bmp = t.mutable_data<uint8>();
+  std::memset(bmp, 0, 64);
+  bmp[0] = 'B';
+  bmp[1] = 'M';
+  bmp[14] = 40;
+  const int w = 640, h = 480;
+  bmp[18] = w & 0xFF;
+  bmp[19] = w >> 8;
+  bmp[22] = h & 0xFF;
+  bmp[23] = h >> 8;
+  ASSERT_EQ(SampleCostModel::SampleSize(t), w * h);
+}
+
+TEST(SampleCostModelTest, FeaturesOfEncodedImage) {
+  Tensor<CPUBackend> t;
+  t.set_pinned(false);
+  t.Resize({64});
+  uint8 *bmp = t.mutable_data<uint8>();
+  std::memset(bmp, 0, 64);
+  bmp[0] = 'B';
+  bmp[1] = 'M';
+  bmp[14] = 40;
+  bmp[18] = 10;
+  bmp[22] = 20;
+
+  // The features of all outputs of a sample are summed
+  SampleCostModel::Features features{};
+  SampleCostModel::AddFeatures(t, &features);
+  SampleCostModel::AddFeatures(t, &features);
+  ASSERT_EQ(features[0], 2 * 10 * 20);
+  ASSERT_EQ(features[1], 2 * 64);
+}
+
+TEST(SampleCostModelTest, FitsMeasuredTimes) {
+  SampleCostModel model;
+  // No measurements, the size itself is the estimate
+  ASSERT_EQ(model.Estimate({100, 10}), 100);
+
+  for (int i = 0; i < 100; ++i) {
+    double size = 1000 * (i % 10 + 1);
+    double time = 50 + 0.01 * size;
+    model.Update({size, size}, &time);
+  }
+  ASSERT_NEAR(model.Estimate({0, 0}), 50, 1e-3);
+  ASSERT_NEAR(model.Estimate({20000, 20000}), 250, 1e-3);
+
+  model.Reset();
+  ASSERT_EQ(model.Estimate({100, 10}), 100);
+}
+
+TEST(SampleCostModelTest, KeepsOrderWithoutSizeDependence) {
+  SampleCostModel model;
+  for (int i = 0; i < 100; ++i) {
+    // Larger samples measured as slightly faster
+    double size = 1000 * (i % 10 + 1);
+    double time = 100 - 0.001 * size;
+    model.Update({size, size}, &time);
+  }
+  ASSERT_LE(model.Estimate({1000, 1000}), model.Estimate({10000, 10000}));
+}
+
+TEST(SampleCostModelTest, ReordersBySumOfOps) {
+  // The first op scales with the pixels, the second with the bytes
+  SampleCostModel model(2);
+  for (int i = 0; i < 200; ++i) {
+    const double pixels = 1000 * (i % 10 + 1);
+    const double bytes = 100 * ((i * 7) % 13 + 1);
+    const double times[2] = {0.01 * pixels, 1 + 0.5 * bytes};
+    model.Update({pixels, bytes}, times);
+  }
+  ASSERT_NEAR(model.Estimate({5000, 300}), 50 + 151, 1e-3);
+
+  // More pixels, but the bytes dominate the measured times
+  ASSERT_GT(model.Estimate({2000, 1300}), model.Estimate({10000, 100}));
+}
+
+}  // namespace dali
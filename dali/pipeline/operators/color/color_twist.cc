@@ -26,6 +26,7 @@ DALI_SCHEMA(Brightness)
     .DocStr(R"code(Changes the brightness of an image)code")
     .NumInput(1)
     .NumOutput(1)
+    .AllowInPlace()
     .AddOptionalArg("brightness",
         R"code(Brightness change factor.
 Values >= 0 are accepted. For example:
@@ -40,6 +41,7 @@ DALI_SCHEMA(Contrast)
     .DocStr(R"code(Changes the color contrast of the image.)code")
     .NumInput(1)
     .NumOutput(1)
+    .AllowInPlace()
     .AddOptionalArg("contrast",
         R"code(Contrast change factor.
 Values >= 0 are accepted. For example:
@@ -54,6 +56,7 @@ DALI_SCHEMA(Hue)
     .DocStr(R"code(Changes the hue level of the image.)code")
     .NumInput(1)
     .NumOutput(1)
+    .AllowInPlace()
     .AddOptionalArg("hue",
         R"code(Hue change in angles.)code", 0.f, true)
     .AddParent("ColorTransformBase");
@@ -62,6 +65,7 @@ DALI_SCHEMA(Saturation)
     .DocStr(R"code(Changes saturation level of the image.)code")
     .NumInput(1)
     .NumOutput(1)
+    .AllowInPlace()
     .AddOptionalArg("saturation",
         R"code(Saturation change factor.
 Values >= 0 are supported. For example:
@@ -75,6 +79,7 @@ DALI_SCHEMA(ColorTwist)
     .DocStr(R"code(Combination of hue, saturation, contrast and brightness.)code")
     .NumInput(1)
     .NumOutput(1)
+    .AllowInPlace()
     .AddOptionalArg("hue",
         R"code(Hue change in angles.)code", 0.f, true)
     .AddOptionalArg("saturation",
@@ -130,7 +135,7 @@ void ColorTwistBase<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
     }
 
     MakeColorTransformation(pImgInp, H, W, C, m, pImgOut);
-  } else {
+  } else if (pImgOut != pImgInp) {
     memcpy(pImgOut, pImgInp, H * W * C);
   }
 }
@@ -34,12 +34,19 @@ DALI_SCHEMA(Crop)
     .AddArg("crop",
             R"code(Size of the cropped image. If only a single value `c` is provided,
  the resulting crop will be square with size `(c,c)`)code", DALI_INT_VEC)
-    .EnforceInputLayout(DALI_NHWC);
+    .EnforceInputLayout(DALI_NHWC)
+    .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                      vector<SampleShape> *outputs) {
+      // The op keeps the layout of its input
+      CropOutputShapes(spec, DALI_SAME, DALI_NO_TYPE, inputs, outputs);
+    })
+    .AllowStridedOutputs();
 
 
 template<>
 Crop<CPUBackend>::Crop(const OpSpec &spec) : Operator<CPUBackend>(spec), CropAttr(spec) {
   Init(num_threads_);
+  strided_output_ = SchemaRegistry::GetSchema(spec.name()).ProducesStridedOutputs(spec);
 }
 
 template<typename Out>
@@ -126,10 +133,21 @@ void Crop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
   auto output = ws->Output<CPUBackend>(idx);
 
   DALITensorLayout outLayout;
-  output->Resize(GetOutShape(input.GetLayout(), &outLayout));
+  const Dims out_shape = GetOutShape(input.GetLayout(), &outLayout);
+  CheckParam(input, "CropCPUBackend");
+
+  if (strided_output_ && outLayout == DALI_NHWC && output_type_ == input.type().id()) {
+    // Nothing to convert, the output is a view of the crop window
+    const int dataIdx = ws->thread_idx();
+    output->ShareSlice(input,
+        {per_sample_crop_[dataIdx].first, per_sample_crop_[dataIdx].second, 0}, out_shape);
+    output->SetLayout(outLayout);
+    return;
+  }
+
+  output->Resize(out_shape);
   output->SetLayout(outLayout);
 
-  CheckParam(input, "CropCPUBackend");
   if (output_type_ == DALI_FLOAT16)
     RunHelper<half_float::half>(ws, idx);
   else
@@ -58,7 +58,7 @@ class CropAttr {
     return std::make_pair(crop_y, crop_x);
   }
 
-  const vector<Index> CheckShapes(const SampleWorkspace *ws) {
+  const Dims &CheckShapes(const SampleWorkspace *ws) {
     const auto &input = ws->Input<CPUBackend>(0);
 
     // enforce that all shapes match
@@ -79,6 +79,44 @@ class CropAttr {
   const int C_;
 };
 
+/**
+ * @brief Infers the shapes of the crops of NHWC images, see
+ * OpSchema::OutputShapeFn(). Like the op, the crops are laid out as
+ * `output_layout`, or as the input for DALI_SAME, and are unknown for
+ * layouts other than NHWC and NCHW. The output type is `type`, or
+ * the type of the input for DALI_NO_TYPE.
+ */
+inline void CropOutputShapes(const OpSpec &spec, DALITensorLayout output_layout,
+                             DALIDataType type, const vector<SampleShape> &inputs,
+                             vector<SampleShape> *outputs) {
+  DALITensorLayout layout = output_layout;
+  if (layout == DALI_SAME) {
+    // The input layout is only known when the schema enforces it
+    const OpSchema &schema = SchemaRegistry::GetSchema(spec.name());
+    layout = schema.EnforceInputLayout() ? schema.InputLayout() : DALI_SAME;
+  }
+  if (layout != DALI_NHWC && layout != DALI_NCHW) return;
+  vector<int> crop;
+  GetSingleOrRepeatedArg(spec, &crop, "crop", 2);
+  const Index C = IsColor(spec.GetArgument<DALIImageType>("image_type")) ? 3 : 1;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const SampleShape &input = inputs[i];
+    if (!input.shape.empty() && !input.upper_bound) {
+      DALI_ENFORCE(input.shape.size() == 3, "Expects 3-dimensional image input.");
+      DALI_ENFORCE(input.shape[2] == SampleShape::kUnknownDim || input.shape[2] == C,
+          "Input channel dimension does not match the output image type. Expected "
+          "input with " + to_string(C) + " channels, got " + to_string(input.shape[2]) + ".");
+    }
+    SampleShape &output = (*outputs)[i];
+    if (layout == DALI_NCHW) {
+      output.shape = {C, crop[0], crop[1]};
+    } else {
+      output.shape = {crop[0], crop[1], C};
+    }
+    output.type = type == DALI_NO_TYPE ? input.type : type;
+  }
+}
+
 template <typename Backend>
 class Crop : public Operator<Backend>, protected CropAttr {
  public:
@@ -112,7 +150,7 @@ class Crop : public Operator<Backend>, protected CropAttr {
       return {crop_[0], crop_[1], C_};
   }
 
-  void SetupSharedSampleParams(const ArgumentWorkspace *ws, const vector<Index> &inputShape,
+  void SetupSharedSampleParams(const ArgumentWorkspace *ws, const Dims &inputShape,
                                 int threaIdx, int dataIdx) {
     DALI_ENFORCE(inputShape.size() == 3, "Expects 3-dimensional image input.");
 
@@ -167,6 +205,9 @@ class Crop : public Operator<Backend>, protected CropAttr {
   // Output data layout
   DALITensorLayout output_layout_;
 
+  // Whether the cpu op outputs views of the input when it only crops
+  bool strided_output_ = false;
+
   USE_OPERATOR_MEMBERS();
 };
 
@@ -33,4 +33,39 @@ TYPED_TEST(CropTest, CropVector) {
   this->RunTest({"Crop", {"crop", "224, 256", DALI_INT_VEC}}, addImageType);
 }
 
+TEST(CropShapeTest, InferOutputShapes) {
+  vector<SampleShape> inputs = {
+    SampleShape({SampleShape::kUnknownDim, SampleShape::kUnknownDim, 3}, DALI_UINT8)};
+
+  auto crop = OpSpec("Crop")
+    .AddArg("crop", vector<int>{224, 256})
+    .AddInput("images", "cpu")
+    .AddOutput("crops", "cpu");
+  auto outputs = SchemaRegistry::GetSchema("Crop").InferOutputShapes(crop, inputs);
+  ASSERT_TRUE(outputs[0].IsKnown());
+  ASSERT_EQ(outputs[0].shape, Dims({224, 256, 3}));
+  ASSERT_EQ(outputs[0].type, DALI_UINT8);
+
+  // Laid out as NCHW and cast to float by default
+  auto crop_cast_permute = OpSpec("CropCastPermute")
+    .AddArg("crop", 224)
+    .AddInput("images", "cpu")
+    .AddOutput("crops", "cpu");
+  outputs = SchemaRegistry::GetSchema("CropCastPermute").InferOutputShapes(
+      crop_cast_permute, inputs);
+  ASSERT_EQ(outputs[0].shape, Dims({3, 224, 224}));
+  ASSERT_EQ(outputs[0].type, DALI_FLOAT);
+
+  // Or as the input, which the op requires to be NHWC
+  crop_cast_permute.AddArg("output_layout", DALI_SAME);
+  outputs = SchemaRegistry::GetSchema("CropCastPermute").InferOutputShapes(
+      crop_cast_permute, inputs);
+  ASSERT_EQ(outputs[0].shape, Dims({224, 224, 3}));
+
+  // The number of channels must match the image type
+  crop.AddArg("image_type", DALI_GRAY);
+  ASSERT_THROW(SchemaRegistry::GetSchema("Crop").InferOutputShapes(crop, inputs),
+               std::runtime_error);
+}
+
 }  // namespace dali
@@ -14,6 +14,8 @@
 
 #include "dali/pipeline/operators/decoder/host_decoder.h"
 
+#include <vector>
+
 namespace dali {
 
 DALI_REGISTER_OPERATOR(HostDecoder, HostDecoder, CPU);
@@ -24,6 +26,13 @@ When applicable, it will pass execution to faster, format-specific decoders (lik
 Output of the decoder is in `HWC` ordering.)code")
   .NumInput(1)
   .NumOutput(1)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    // Only the number of channels is known before decoding
+    const Index C = IsColor(spec.GetArgument<DALIImageType>("output_type")) ? 3 : 1;
+    (*outputs)[0] = SampleShape({SampleShape::kUnknownDim, SampleShape::kUnknownDim, C},
+        DALI_UINT8);
+  })
   .AddOptionalArg("output_type",
       R"code(The color space of output image.)code",
       DALI_RGB);
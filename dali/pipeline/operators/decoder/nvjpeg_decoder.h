@@ -48,11 +48,10 @@ namespace dali {
 #define NVJPEG_CALL_EX(code, extra)                          \
   do {                                                       \
     nvjpegStatus_t status = code;                            \
-    string extra_info = extra;                               \
     if (status != NVJPEG_STATUS_SUCCESS) {                   \
       dali::string error = dali::string("NVJPEG error \"") + \
         std::to_string(static_cast<int>(status)) + "\"" +    \
-        " " + extra_info;                                    \
+        " " + extra;                                         \
       DALI_FAIL(error);                                      \
     }                                                        \
   } while (0)
@@ -242,7 +241,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
 
       for (int i = 0; i < batch_size_; ++i) {
         auto& in = ws->Input<CPUBackend>(0, i);
-        auto file_name = in.GetSourceInfo();
+        const auto &source_info = in.source_info();
         auto in_size = in.size();
         const auto *data = in.data<uint8_t>();
         auto *output_data = output->mutable_tensor<uint8_t>(i);
@@ -258,7 +257,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
         }
 
         thread_pool_.DoWorkWithID(std::bind(
-              [this, info, data, in_size, output_data, file_name](int idx, int tid) {
+              [this, info, data, in_size, output_data, source_info](int idx, int tid) {
                 DecodeSingleSampleHost(idx,
                                        batched_image_idx_[idx],
                                        tid,
@@ -268,7 +267,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
                                        data, in_size,
                                        output_data,
                                        streams_[0],
-                                       file_name);
+                                       source_info);
               }, i, std::placeholders::_1));
       }
       // Sync thread-based work, assemble outputs and call batched
@@ -293,7 +292,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
       for (int i = 0; i < batch_size_; ++i) {
         size_t j = image_order[i].second;
         auto& in = ws->Input<CPUBackend>(0, j);
-        auto file_name = in.GetSourceInfo();
+        const auto &source_info = in.source_info();
         auto in_size = in.size();
         const auto *data = in.data<uint8_t>();
         auto *output_data = output->mutable_tensor<uint8_t>(j);
@@ -301,7 +300,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
         auto info = output_info_[j];
 
         thread_pool_.DoWorkWithID(std::bind(
-              [this, info, data, in_size, output_data, file_name](int idx, int tid) {
+              [this, info, data, in_size, output_data, source_info](int idx, int tid) {
                 const int stream_idx = tid;
                 DecodeSingleSample(idx,
                              stream_idx,
@@ -311,7 +310,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
                              data, in_size,
                              output_data,
                              streams_[stream_idx],
-                             file_name);
+                             source_info);
               }, j, std::placeholders::_1));
       }
       // Make sure work is finished being submitted
@@ -347,7 +346,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
                     const size_t in_size,
                     uint8 *output,
                     cudaStream_t stream,
-                    string file_name) {
+                    const SourceInfo &source_info) {
     if (!info.nvjpeg_support) {
       OCVFallback(data, in_size, output, stream);
       CUDA_CALL(cudaStreamSynchronize(stream));
@@ -365,16 +364,16 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
           data,
           in_size,
           GetFormat(output_type_),
-          stream), file_name);
+          stream), source_info.str());
 
     // Ensure previous GPU work is finished
     CUDA_CALL(cudaStreamSynchronize(stream));
 
     // Memcpy of Huffman co-efficients to device
-    NVJPEG_CALL_EX(nvjpegDecodePhaseTwo(handle, state, stream), file_name);
+    NVJPEG_CALL_EX(nvjpegDecodePhaseTwo(handle, state, stream), source_info.str());
 
     // iDCT and output
-    NVJPEG_CALL_EX(nvjpegDecodePhaseThree(handle, state, &out_desc, stream), file_name);
+    NVJPEG_CALL_EX(nvjpegDecodePhaseThree(handle, state, &out_desc, stream), source_info.str());
   }
 
   // Perform the CPU part of a batched decode on a single thread
@@ -388,7 +387,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
                               const size_t in_size,
                               uint8 *output,
                               cudaStream_t stream,
-                              string file_name) {
+                              const SourceInfo &source_info) {
     if (!info.nvjpeg_support) {
       OCVFallback(data, in_size, output, stream);
       CUDA_CALL(cudaStreamSynchronize(stream));
@@ -401,7 +400,7 @@ class nvJPEGDecoder : public Operator<MixedBackend> {
                                        in_size,
                                        nvjpeg_image_idx,
                                        thread_idx,
-                                       stream), file_name);
+                                       stream), source_info.str());
   }
 
   /**
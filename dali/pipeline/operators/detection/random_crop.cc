@@ -20,6 +20,7 @@
 
 #include "dali/pipeline/operators/detection/random_crop.h"
 #include "dali/pipeline/operators/common.h"
+#include "dali/pipeline/util/philox.h"
 #include "dali/util/ocv.h"
 
 namespace dali {
@@ -33,7 +34,8 @@ cropped image, cropped and valid bounding boxes and valid labels are returned.)c
   .NumInput(3)   // [img, bbox, label]
   .NumOutput(3)  // [img, bbox, label]
   .AddOptionalArg("num_attempts", R"code(Number of attempts,
-the default value is 1.)code", 1);
+the default value is 1.)code", 1)
+  .AllowStridedOutputs();
 
 /*
  * # This function is from https://github.com/kuangliu/pytorch-ssd.
@@ -72,106 +74,67 @@ the default value is 1.)code", 1);
 namespace detail {
 
 // input in ltrb format
-// box1 is [N, 4], box2 is [M, 4]
-// calculate IoU of every box1 vs. every box2 : O(N^2)
-Tensor<CPUBackend> cpu_iou(const Tensor<CPUBackend>& box1,
-                           const Tensor<CPUBackend>& box2) {
-  Tensor<CPUBackend> ious;
-  ious.set_pinned(false);
-
-  int N = box1.dim(0);
-  // Note: We know M=1 in this use-case
-  // int M = box2.dim(0);
-  const int M = 1;
-
+// box1 is [N, 4], box2 is [1, 4], ious is [N, 1]
+// calculate IoU of every box1 vs. box2
+void cpu_iou(const Tensor<CPUBackend>& box1, const float *box2, float *ious) {
+  const int N = box1.dim(0);
   const float* box1_data = box1.data<float>();
-  const float* box2_data = box2.data<float>();
-
-  ious.Resize({N, 1});
-  float *ious_data = ious.mutable_data<float>();
 
-  std::vector<std::pair<float, float>> lt, rb;
+  // delta2 = be2[:, :, 2:] - be2[:, :, :2]
+  // area2 = delta2[:, :, 0] * delta[:, :, 2]
+  // area is (b-t) * (r-l)
+  const float area2 = (box2[3] - box2[1]) * (box2[2] - box2[0]);
 
-  /*
-   * # Left Top & Right Bottom
-   * lt = torch.max(be1[:,:,:2], be2[:,:,:2])
-   * rb = torch.min(be1[:,:,2:], be2[:,:,2:])
-   */
   for (int i = 0; i < N; ++i) {
     const float *b1 = box1_data + i * box1.dim(1);
-    const float *b2 = box2_data;
 
+    /*
+     * # Left Top & Right Bottom
+     * lt = torch.max(be1[:,:,:2], be2[:,:,:2])
+     * rb = torch.min(be1[:,:,2:], be2[:,:,2:])
+     */
     // want the maximum top, left
-    float l = std::max(b1[0], b2[0]);
-    float t = std::max(b1[1], b2[1]);
+    float l = std::max(b1[0], box2[0]);
+    float t = std::max(b1[1], box2[1]);
 
     // minimum bottom, right
-    float r = std::min(b1[2], b2[2]);
-    float b = std::min(b1[3], b2[3]);
-
-    lt.push_back(std::make_pair(l, t));
-    rb.push_back(std::make_pair(r, b));
-  }
-
-  // delta = rb - lt
-  // delta[delta < 0] = 0
-  // intersect = delta[:,:,0] * delta[:,:, 1]
-  vector<float> intersect(N);
-  for (int i = 0; i < N; ++i) {
-    float first_elem = rb[i].first - lt[i].first;
-    float second_elem = rb[i].second - lt[i].second;
+    float r = std::min(b1[2], box2[2]);
+    float b = std::min(b1[3], box2[3]);
 
+    // delta = rb - lt
     // delta[delta < 0] = 0
+    // intersect = delta[:,:,0] * delta[:,:, 1]
+    float first_elem = r - l;
+    float second_elem = b - t;
     first_elem = (first_elem < 0) ? 0 : first_elem;
     second_elem = (second_elem < 0) ? 0 : second_elem;
-    float inter = first_elem * second_elem;
-
-    intersect[i] = inter;
-  }
+    const float intersect = first_elem * second_elem;
 
-  // delta1 = be1[:, :, 2:] - be1[:, :, :2]
-  // area1 = delta1[:, :, 0] * delta[:, :, 1]
-  vector<float> area1(N);
-  for (int i = 0; i < N; ++i) {
-    const float* box = box1_data + i * 4;
-    // area is (b-t) * (r-l)
-    area1[i] = (box[3] - box[1]) * (box[2] - box[0]);
-  }
-  // delta2 = be2[:, :, 2:] - be2[:, :, :2]
-  // area2 = delta2[:, :, 0] * delta[:, :, 2]
-  const float* box = box2_data;
-  // area is (b-t) * (r-l)
-  auto area2 = (box[3] - box[1]) * (box[2] - box[0]);
+    // delta1 = be1[:, :, 2:] - be1[:, :, :2]
+    // area1 = delta1[:, :, 0] * delta[:, :, 1]
+    const float area1 = (b1[3] - b1[1]) * (b1[2] - b1[0]);
 
-  // iou = intersect / (area1 + area2 - intersect)
-  for (int i = 0; i < N; ++i) {
-    // index into N*M arrays
-    auto idx = i;
-    ious_data[idx] = intersect[idx] / (area1[i] + area2 - intersect[idx]);
+    // iou = intersect / (area1 + area2 - intersect)
+    ious[i] = intersect / (area1 + area2 - intersect);
   }
-  return ious;
 }
 
 // img is [H, W, C], bounds [l, t, r, b]
-// output [r-l, b-t, C]
-void crop(const Tensor<CPUBackend>& img, vector<int> bounds, Tensor<CPUBackend>* out) {
+// output [b-t, r-l, C], a view into img, or a copy without strided outputs
+void crop(const Tensor<CPUBackend>& img, const int *bounds, bool strided,
+          Tensor<CPUBackend>* out) {
   // output dimensions
   const int width = bounds[2] - bounds[0];
   const int height = bounds[3] - bounds[1];
-  // input dimensions
-  const int H = img.dim(0);
-  const int W = img.dim(1);
   const int C = img.dim(2);
 
-  out->Resize({height, width, C});
-  uint8_t *out_data = out->mutable_data<uint8_t>();
-
-  int out_idx = 0;
-  for (int h = bounds[1]; h < bounds[3]; ++h) {
-    const int idx = h * W * C + bounds[0] * C;
-    memcpy(out_data + out_idx, img.data<uint8_t>() + idx, (bounds[2] - bounds[0]) * C);
-    out_idx += (bounds[2] - bounds[0]) * C;
+  if (strided) {
+    out->ShareSlice(img, {bounds[1], bounds[0], 0}, {height, width, C});
+    return;
   }
+  Tensor<CPUBackend> view;
+  view.ShareSlice(img, {bounds[1], bounds[0], 0}, {height, width, C});
+  out->Copy(view, 0);
 }
 
 }  // namespace detail
@@ -190,19 +153,25 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
   const int* label_data = labels.data<int>();
 
   // [1x4]
-  Tensor<CPUBackend> crop_attempt;
-  crop_attempt.set_pinned(false);
-  crop_attempt.Resize({1, 4});
-  float *crop_ptr = crop_attempt.mutable_data<float>();
+  float crop_ptr[4];
+  // The temporaries of the attempts live in the scratch memory,
+  // as there can be many of them for each sample
+  float *ious_data = ws->AllocateScratch<float>(N);
+  int *mask = ws->AllocateScratch<int>(N);
+
+  Philox gen(seed_, ws->iteration(), ws->data_idx());
+  auto int_dis = int_dis_;
+  auto float_dis = float_dis_;
 
   // iterate until a suitable crop has been found
   while (true) {
-    auto opt_idx = int_dis_(gen_);
+    auto opt_idx = int_dis(gen);
     auto option = sample_options_[opt_idx];
 
     if (option.no_crop()) {
-      // copy directly to output without modification
-      ws->Output<CPUBackend>(0)->Copy(img, 0);
+      // pass the image through without modification
+      const int bounds[] = {0, 0, static_cast<int>(img.dim(1)), static_cast<int>(img.dim(0))};
+      detail::crop(img, bounds, strided_output_, ws->Output<CPUBackend>(0));
       ws->Output<CPUBackend>(1)->Copy(bboxes, 0);
       ws->Output<CPUBackend>(2)->Copy(labels, 0);
       return;
@@ -216,8 +185,8 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
 
     // make num_attempts_ tries to get a valid crop
     for (int i = 0; i < num_attempts_; ++i) {
-      auto w = float_dis_(gen_);
-      auto h = float_dis_(gen_);
+      auto w = float_dis(gen);
+      auto h = float_dis(gen);
 
       // aspect ratio check
       if ((w / h < 0.5) || (w / h > 2.)) {
@@ -226,8 +195,8 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
 
       // need RNG generators for left, top
       std::uniform_real_distribution<float> l_dis(0., 1. - w), t_dis(0., 1. - h);
-      auto left = l_dis(gen_);
-      auto top = t_dis(gen_);
+      auto left = l_dis(gen);
+      auto top = t_dis(gen);
 
       auto right = left + w;
       auto bottom = top + h;
@@ -238,9 +207,7 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
       crop_ptr[3] = bottom;
 
       // returns ious : [N, M]
-
-      Tensor<CPUBackend> ious = detail::cpu_iou(bboxes, crop_attempt);
-      const float *ious_data = ious.data<float>();
+      detail::cpu_iou(bboxes, crop_ptr, ious_data);
 
       // make sure all the calculated IoUs are in the range (min_iou, max_iou)
       // Note: ious has size N*M, but M = 1 in this case
@@ -255,7 +222,6 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
 
       // discard any bboxes whose center is not in the cropped image
       int valid_bboxes = 0;
-      std::vector<bool> mask;
       for (int j = 0; j < N; ++j) {
         const auto* bbox = bbox_data + j * 4;
         auto xc = 0.5*(bbox[0] + bbox[2]);
@@ -263,7 +229,7 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
 
         bool valid = (xc > left) && (xc < right) && (yc > top) && (yc < bottom);
         if (valid) {
-          mask.push_back(j);
+          mask[valid_bboxes] = j;
           valid_bboxes += 1;
         }
       }
@@ -315,8 +281,8 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
       const int bottom_idx = static_cast<int>(bottom * htot);
 
       // perform the crop
-      detail::crop(img, {left_idx, top_idx, right_idx, bottom_idx},
-                   ws->Output<CPUBackend>(0));
+      const int bounds[] = {left_idx, top_idx, right_idx, bottom_idx};
+      detail::crop(img, bounds, strided_output_, ws->Output<CPUBackend>(0));
 
       return;
     }  // end num_attempts loop
@@ -33,7 +33,8 @@ class SSDRandomCrop : public Operator<Backend> {
   explicit inline SSDRandomCrop(const OpSpec &spec) :
     Operator<Backend>(spec),
     num_attempts_(spec.GetArgument<int>("num_attempts")),
-    gen_(rd_()),
+    seed_(spec.GetArgument<int>("seed")),
+    strided_output_(SchemaRegistry::GetSchema(spec.name()).ProducesStridedOutputs(spec)),
     int_dis_(0, 6),        // sample option
     float_dis_(0.3, 1.) {  // w, h generation
     // setup all possible sample types
@@ -81,9 +82,10 @@ class SSDRandomCrop : public Operator<Backend> {
 
   int num_attempts_;
 
-  // RNG stuff
-  std::random_device rd_;
-  std::mt19937 gen_;
+  // RNG stuff, samples draw from their own Philox streams
+  int seed_;
+  // Whether the cropped image is a view of the input
+  bool strided_output_;
   std::uniform_int_distribution<> int_dis_;
   std::uniform_real_distribution<float> float_dis_;
 };
@@ -39,6 +39,13 @@ struct HasParam : std::false_type { };
 template <typename T>
 struct HasParam <T, decltype((void) (typename T::Param()), 0)> : std::true_type {};
 
+// Random displacements select the stream of the sample with SetSample
+template <typename T, typename = int>
+struct IsRandom : std::false_type { };
+
+template <typename T>
+struct IsRandom <T, decltype((void) (&T::SetSample), 0)> : std::true_type {};
+
 template <typename T>
 struct Point {
   const T x, y;
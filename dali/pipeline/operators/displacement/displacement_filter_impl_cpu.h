@@ -93,6 +93,14 @@ class DisplacementFilter<CPUBackend, Displacement,
   template <typename U = Displacement>
   typename std::enable_if<!HasParam<U>::value>::type PrepareDisplacement(SampleWorkspace *) {}
 
+  template <typename U = Displacement>
+  typename std::enable_if<IsRandom<U>::value>::type SetSample(U *displace, SampleWorkspace *ws) {
+    displace->SetSample(ws->iteration(), ws->data_idx());
+  }
+
+  template <typename U = Displacement>
+  typename std::enable_if<!IsRandom<U>::value>::type SetSample(U *, SampleWorkspace *) {}
+
   /**
    * @brief Do basic input checking and output setup
    * assuming output_shape = input_shape
@@ -184,6 +192,10 @@ class DisplacementFilter<CPUBackend, Displacement,
     auto *in = input.data<T>();
     auto *out = output->template mutable_data<T>();
 
+    // Samples run concurrently, each of them uses its own copy
+    Displacement displace(displace_);
+    SetSample(&displace, ws);
+
     if (!has_mask_ || mask_->template data<bool>()[ws->data_idx()]) {
       for (Index h = 0; h < H; ++h) {
         for (Index w = 0; w < W; ++w) {
@@ -197,7 +209,7 @@ class DisplacementFilter<CPUBackend, Displacement,
               T out_value;
               if (interp_type == DALI_INTERP_NN) {
                 // NN interpolation
-                const auto p = displace_.template operator()<Index>(h, w, c, H, W, C);
+                const auto p = displace.template operator()<Index>(h, w, c, H, W, C);
                 if (ShouldTransform(p)) {
                   const auto in_idx = PointToInIdx(p, H, W, C) + c;
                   out_value = in[in_idx];
@@ -206,7 +218,7 @@ class DisplacementFilter<CPUBackend, Displacement,
                 }
               } else {
                 // LINEAR interpolation
-                const auto p = displace_.template operator()<float>(h, w, c, H, W, C);
+                const auto p = displace.template operator()<float>(h, w, c, H, W, C);
                 if (ShouldTransform(p)) {
                   const auto in_idx = PointToInIdx(p, H, W, C) + c;
                   const auto next_offsets = CalcNextOffsets(p, H, W, C);
@@ -225,7 +237,7 @@ class DisplacementFilter<CPUBackend, Displacement,
             Index out_idx = (h * W + w) * C;
             if (interp_type == DALI_INTERP_NN) {
               // input idx is calculated by function
-              const auto p = displace_.template operator()<Index>(h, w, 0, H, W, C);
+              const auto p = displace.template operator()<Index>(h, w, 0, H, W, C);
               if (ShouldTransform(p)) {
                 const auto in_idx = PointToInIdx(p, H, W, C);
                 // apply transform uniformly across channels
@@ -238,7 +250,7 @@ class DisplacementFilter<CPUBackend, Displacement,
                 }
               }
             } else {
-              const auto p = displace_.template operator()<float>(h, w, 0, H, W, C);
+              const auto p = displace.template operator()<float>(h, w, 0, H, W, C);
               if (ShouldTransform(p)) {
                 const auto in_idx = PointToInIdx(p, H, W, C);
                 const auto next_offsets = CalcNextOffsets(p, H, W, C);
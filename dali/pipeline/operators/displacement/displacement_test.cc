@@ -35,7 +35,8 @@ TYPED_TEST(DisplacementTest, Water) {
 }
 
 /*
- * As of 08/03/2018 this test is disabled because Jitter is not activated for CPU
+ * This test is disabled because Jitter draws different random numbers
+ * on the CPU and on the GPU, so their outputs do not match
  *
 TYPED_TEST(DisplacementTest, Jitter) {
   this->RunTest("Jitter");
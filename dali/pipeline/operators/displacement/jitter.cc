@@ -19,8 +19,7 @@
 
 namespace dali {
 
-// TODO(ptredak): re-enable it once RNG is changed on the CPU to be deterministic
-// DALI_REGISTER_OPERATOR(Jitter, Jitter<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(Jitter, Jitter<CPUBackend>, CPU);
 
 DALI_SCHEMA(Jitter)
     .DocStr(R"code(Perform a random Jitter augmentation.
@@ -44,16 +44,23 @@ template <typename T>
     // JITTER_CORE
 #ifdef __CUDA_ARCH__
     const int idx = threadIdx.x + blockIdx.x * blockDim.x;
+    const int idx_y = idx;
 #else
-    const int idx = 0;
+    // On the CPU the numbers are a function of the pixel
+    const int idx = (y * W + x) * 2;
+    const int idx_y = idx + 1;
 #endif
 
     const T newX = rnd_.rand(idx) % degr - nHalf + x;
-    const T newY = rnd_.rand(idx) % degr - nHalf + y;
+    const T newY = rnd_.rand(idx_y) % degr - nHalf + y;
 
     return CreatePointLimited(newX, newY, W, H);
   }
 
+  void SetSample(int64 iteration, int sample) {
+    rnd_.SetSample(iteration, sample);
+  }
+
   void Cleanup() {
     rnd_.Cleanup();
   }
@@ -14,6 +14,8 @@
 
 #include "dali/pipeline/operators/fused/crop_cast_permute.h"
 
+#include <vector>
+
 namespace dali {
 
 DALI_SCHEMA(CropCastPermute)
@@ -28,7 +30,12 @@ cast and permute (from NHWC to NCHW).)code")
   .AddOptionalArg("output_layout",
       R"code(Output tensor data layout)code", DALI_NCHW)
   .AddParent("Crop")  // for image type, crop pos and sizes
-  .EnforceInputLayout(DALI_NHWC);
+  .EnforceInputLayout(DALI_NHWC)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    CropOutputShapes(spec, spec.GetArgument<DALITensorLayout>("output_layout"),
+        spec.GetArgument<DALIDataType>("output_dtype"), inputs, outputs);
+  });
 
 // Register operator
 DALI_REGISTER_OPERATOR(CropCastPermute, CropCastPermute<CPUBackend>, CPU);
@@ -242,7 +242,7 @@ void CropMirrorNormalize<GPUBackend>::DataDependentSetup(DeviceWorkspace *ws, co
 
   vector<Dims> output_shape(batch_size_);
   for (int i = 0; i < batch_size_; ++i) {
-    vector<Index> input_shape = input.tensor_shape(i);
+    const auto &input_shape = input.tensor_shape(i);
     DALI_ENFORCE(input_shape.size() == 3,
         "Expects 3-dimensional image input.");
 
@@ -323,7 +323,7 @@ void CropMirrorNormalize<GPUBackend>::SetupSharedSampleParams(DeviceWorkspace *w
   DALI_ENFORCE(IsType<uint8>(input.type()),
       "Expected input data as uint8.");
   for (int i = 0; i < batch_size_; ++i) {
-    vector<Index> input_shape = input.tensor_shape(i);
+    const auto &input_shape = input.tensor_shape(i);
     DALI_ENFORCE(input_shape.size() == 3,
         "Expects 3-dimensional image input.");
 
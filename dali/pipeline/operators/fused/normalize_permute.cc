@@ -90,6 +90,25 @@ output = (input - mean) / std
   .AddArg("std",
       R"code(Standard deviation values for image normalization.)code",
       DALI_FLOAT_VEC)
-  .EnforceInputLayout(DALI_NHWC);
+  .EnforceInputLayout(DALI_NHWC)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    const Index H = spec.GetArgument<int>("height");
+    const Index W = spec.GetArgument<int>("width");
+    const Index C = IsColor(spec.GetArgument<DALIImageType>("image_type")) ? 3 : 1;
+    const Dims input_shape = {H, W, C};
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const Dims &shape = inputs[i].shape;
+      if (!shape.empty() && !inputs[i].upper_bound) {
+        DALI_ENFORCE(shape.size() == 3, "Expects 3-dimensional image input.");
+        for (int d = 0; d < 3; ++d) {
+          DALI_ENFORCE(shape[d] == SampleShape::kUnknownDim || shape[d] == input_shape[d],
+              "Input shape " + ShapeString(shape) + "does not match the image shape " +
+              ShapeString(input_shape) + "given by the arguments.");
+        }
+      }
+      (*outputs)[i] = SampleShape({C, H, W}, spec.GetArgument<DALIDataType>("output_dtype"));
+    }
+  });
 
 }  // namespace dali
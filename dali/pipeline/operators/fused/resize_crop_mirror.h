@@ -41,14 +41,52 @@ class ResizeCropMirrorAttr : protected CropAttr {
  protected:
   explicit inline ResizeCropMirrorAttr(const OpSpec &spec) : CropAttr(spec),
     interp_type_(spec.GetArgument<DALIInterpType>("interp_type")) {
-    resize_shorter_ = spec.ArgumentDefined("resize_shorter");
-    resize_x_ = spec.ArgumentDefined("resize_x");
-    resize_y_ = spec.ArgumentDefined("resize_y");
-    DALI_ENFORCE(resize_shorter_ != (resize_x_ || resize_y_),
+    DALI_ENFORCE(spec.ArgumentDefined("resize_shorter") !=
+                 (spec.ArgumentDefined("resize_x") || spec.ArgumentDefined("resize_y")),
                  "Options `resize_shorter` and `resize_x` or `resize_y` "
                  "are mutually exclusive for schema \"" + spec.name() + "\"");
   }
 
+ public:
+  /**
+   * @brief Computes the size an image of H x W is resized to, from the
+   * resize arguments of the sample `index`. The output shape inference
+   * uses it too, without a workspace, when none of these arguments
+   * are tensors.
+   */
+  static void ResizedSize(const OpSpec &spec, const ArgumentWorkspace *ws, const Index index,
+                          int H, int W, int *rsz_h, int *rsz_w) {
+    if (spec.ArgumentDefined("resize_shorter")) {
+      // resize_shorter set
+      const int shorter_side_size = spec.GetArgument<float>("resize_shorter", ws, index);
+      if (H < W) {
+        const float scale = shorter_side_size/static_cast<float>(H);
+        *rsz_h = shorter_side_size;
+        *rsz_w = scale * W;
+      } else {
+        const float scale = shorter_side_size/static_cast<float>(W);
+        *rsz_h = scale * H;
+        *rsz_w = shorter_side_size;
+      }
+    } else if (spec.ArgumentDefined("resize_x")) {
+      *rsz_w = spec.GetArgument<float>("resize_x", ws, index);
+      if (spec.ArgumentDefined("resize_y")) {
+        // resize_x and resize_y set
+        *rsz_h = spec.GetArgument<float>("resize_y", ws, index);
+      } else {
+        // resize_x set only
+        const float scale = static_cast<float>(*rsz_w) / W;
+        *rsz_h = scale * H;
+      }
+    } else {
+      // resize_y set only
+      *rsz_h = spec.GetArgument<float>("resize_y", ws, index);
+      const float scale = static_cast<float>(*rsz_h) / H;
+      *rsz_w = scale * W;
+    }
+  }
+
+ protected:
   struct TransformMeta {
     int H, W, C;
     int rsz_h, rsz_w;
@@ -57,43 +95,14 @@ class ResizeCropMirrorAttr : protected CropAttr {
   };
 
  protected:
-  inline const TransformMeta GetTransformMeta(const OpSpec &spec, const vector<Index> &input_shape,
+  inline const TransformMeta GetTransformMeta(const OpSpec &spec, const Dims &input_shape,
                         const ArgumentWorkspace *ws, const Index index, const uint flag = 0) {
     TransformMeta meta;
     meta.H = input_shape[0];
     meta.W = input_shape[1];
     meta.C = input_shape[2];
 
-    if (resize_shorter_) {
-      // resize_shorter set
-      const int shorter_side_size = spec.GetArgument<float>("resize_shorter", ws, index);
-      if (meta.H < meta.W) {
-        const float scale = shorter_side_size/static_cast<float>(meta.H);
-        meta.rsz_h = shorter_side_size;
-        meta.rsz_w = scale * meta.W;
-      } else {
-        const float scale = shorter_side_size/static_cast<float>(meta.W);
-        meta.rsz_h = scale * meta.H;
-        meta.rsz_w = shorter_side_size;
-      }
-    } else {
-      if (resize_x_) {
-        meta.rsz_w = spec.GetArgument<float>("resize_x", ws, index);
-        if (resize_y_) {
-          // resize_x and resize_y set
-          meta.rsz_h = spec.GetArgument<float>("resize_y", ws, index);
-        } else {
-          // resize_x set only
-          const float scale = static_cast<float>(meta.rsz_w) / meta.W;
-          meta.rsz_h = scale * meta.H;
-        }
-      } else {
-        // resize_y set only
-        meta.rsz_h = spec.GetArgument<float>("resize_y", ws, index);
-        const float scale = static_cast<float>(meta.rsz_h) / meta.H;
-        meta.rsz_w = scale * meta.W;
-      }
-    }
+    ResizedSize(spec, ws, index, meta.H, meta.W, &meta.rsz_h, &meta.rsz_w);
 
     if (flag & t_crop)
       meta.crop = SetCropXY(spec, ws, index, meta.rsz_h, meta.rsz_w);
@@ -116,10 +125,6 @@ class ResizeCropMirrorAttr : protected CropAttr {
 
   // Interpolation type
   DALIInterpType interp_type_;
-
- private:
-  // Resize meta-data
-  bool resize_shorter_, resize_x_, resize_y_;
 };
 
 typedef DALIError_t (*resizeCropMirroHost)(const uint8 *img, int H, int W, int C,
@@ -134,9 +139,6 @@ class ResizeCropMirror : public Operator<CPUBackend>, protected ResizeCropMirror
  public:
   explicit inline ResizeCropMirror(const OpSpec &spec) :
     Operator(spec), ResizeCropMirrorAttr(spec) {
-    // Resize per-image & per-thread data
-    tl_workspace_.resize(num_threads_);
-
     // per-image-set data
     per_thread_meta_.resize(num_threads_);
   }
@@ -162,7 +164,7 @@ class ResizeCropMirror : public Operator<CPUBackend>, protected ResizeCropMirror
     // Resize the output & run
     output->Resize({crop_[0], crop_[1], meta.C});
 
-    tl_workspace_[ws->thread_idx()].resize(meta.rsz_h*meta.rsz_w*meta.C);
+    uint8 *workspace = ws->AllocateScratch<uint8>(meta.rsz_h*meta.rsz_w*meta.C);
     DALI_CALL((*func)(
         input.template data<uint8>(),
         meta.H, meta.W, meta.C,
@@ -172,10 +174,9 @@ class ResizeCropMirror : public Operator<CPUBackend>, protected ResizeCropMirror
         meta.mirror,
         output->template mutable_data<uint8>(),
         interp_type_,
-        tl_workspace_[ws->thread_idx()].data()));
+        workspace));
   }
 
-  vector<vector<uint8>> tl_workspace_;
   vector<TransformMeta> per_thread_meta_;
   USE_OPERATOR_MEMBERS();
 };
@@ -32,6 +32,7 @@ or [left, top, right, bottom] format. All coordinates are
 in the image coordinate system (i.e. 0.0-1.0))code")
                 .NumInput(1)
                 .NumOutput(1)
+                .AllowInPlace()
                 .AddOptionalArg(kCoordinatesTypeArgName,
                                 R"code(True, for two-point (ltrb).
 False for for width-height representation. Default: False)code",
@@ -52,8 +53,8 @@ BbFlip::BbFlip(const dali::OpSpec &spec) :
 }
 
 
-void BbFlip::RunImpl(dali::SampleWorkspace *ws, const int idx) {
-  const auto &input = ws->Input<CPUBackend>(idx);
+void BbFlip::FlipBoxes(const Tensor<CPUBackend> &input, Tensor<CPUBackend> *output,
+                       int horizontal, int vertical) {
   const auto input_data = input.data<float>();
 
   DALI_ENFORCE(input.type().id() == DALI_FLOAT, "Bounding box in wrong format");
@@ -86,22 +87,6 @@ void BbFlip::RunImpl(dali::SampleWorkspace *ws, const int idx) {
       return true;
   }(input_data, input.size(), coordinates_type_ltrb_), "Incorrect first or second point");
 
-  int vertical;
-  int index = ws->data_idx();
-  if (vflip_is_tensor_) {
-    vertical = spec_.GetArgument<int>(kVerticalArgName, ws, index);
-  } else {
-    vertical = spec_.GetArgument<int>(kVerticalArgName);
-  }
-
-  int horizontal;
-  if (hflip_is_tensor_) {
-    horizontal = spec_.GetArgument<int>(kHorizontalArgName, ws, index);
-  } else {
-    horizontal = spec_.GetArgument<int>(kHorizontalArgName);
-  }
-
-  auto *output = ws->Output<CPUBackend>(idx);
   // XXX: Setting type of output (i.e. Buffer -> buffer.h)
   //      explicitly is required for further processing
   //      It can also be achieved with mutable_data<>()
@@ -125,4 +110,39 @@ void BbFlip::RunImpl(dali::SampleWorkspace *ws, const int idx) {
 }
 
 
+void BbFlip::RunImpl(dali::SampleWorkspace *ws, const int idx) {
+  int vertical;
+  int index = ws->data_idx();
+  if (vflip_is_tensor_) {
+    vertical = spec_.GetArgument<int>(kVerticalArgName, ws, index);
+  } else {
+    vertical = spec_.GetArgument<int>(kVerticalArgName);
+  }
+
+  int horizontal;
+  if (hflip_is_tensor_) {
+    horizontal = spec_.GetArgument<int>(kHorizontalArgName, ws, index);
+  } else {
+    horizontal = spec_.GetArgument<int>(kHorizontalArgName);
+  }
+
+  FlipBoxes(ws->Input<CPUBackend>(idx), ws->Output<CPUBackend>(idx), horizontal, vertical);
+}
+
+
+void BbFlip::RunBatch(HostWorkspace *ws) {
+  // Scalar arguments are resolved once for the whole batch
+  const int vertical = vflip_is_tensor_ ? 0 : spec_.GetArgument<int>(kVerticalArgName);
+  const int horizontal = hflip_is_tensor_ ? 0 : spec_.GetArgument<int>(kHorizontalArgName);
+
+  for (int idx = 0; idx < input_sets_; ++idx) {
+    for (int i = 0; i < ws->NumInputAtIdx(idx); ++i) {
+      FlipBoxes(ws->Input<CPUBackend>(idx, i), ws->Output<CPUBackend>(idx, i),
+                hflip_is_tensor_ ? spec_.GetArgument<int>(kHorizontalArgName, ws, i) : horizontal,
+                vflip_is_tensor_ ? spec_.GetArgument<int>(kVerticalArgName, ws, i) : vertical);
+    }
+  }
+}
+
+
 }  // namespace dali
@@ -28,10 +28,19 @@ class BbFlip : public Operator<CPUBackend> {
   virtual ~BbFlip() = default;
   DISABLE_COPY_MOVE_ASSIGN(BbFlip);
 
+  void RunBatch(HostWorkspace *ws) override;
+
+  bool CanRunBatch() const override {
+    return true;
+  }
+
  protected:
   void RunImpl(SampleWorkspace *ws, const int idx) override;
 
  private:
+  void FlipBoxes(const Tensor<CPUBackend> &input, Tensor<CPUBackend> *output,
+                 int horizontal, int vertical);
+
   /**
    * Checks, if argument provided by user is a scalar and,
    * in such case, extends this scalar to entire tensor
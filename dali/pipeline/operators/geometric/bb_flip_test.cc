@@ -165,7 +165,7 @@ class BbFlipTest : public DALISingleOpTest<ImageType> {
     auto batch_size = input_data->size();
     this->SetBatchSize(static_cast<int>(batch_size));
     batch.set_type(TypeInfo::Create<float>());
-    new_batch_size_ = std::vector<std::vector<long int>>(batch_size);  //NOLINT
+    new_batch_size_ = std::vector<Dims>(batch_size);
     for (auto &sz : new_batch_size_) {
       sz = {kBbStructSize};
     }
@@ -192,7 +192,7 @@ class BbFlipTest : public DALISingleOpTest<ImageType> {
 
  private:
   const TestData *test_data_ = nullptr;
-  std::vector<std::vector<long int>> new_batch_size_;  //NOLINT
+  std::vector<Dims> new_batch_size_;
   bool flip_type_vertical_, flip_type_horizontal_;
 };
 
@@ -242,4 +242,22 @@ TYPED_TEST(BbFlipTest, NoFlipTest) {
   this->RunOperator(this->GetOperatorSpec(false, false, false), .001);
 }
 
+
+TYPED_TEST(BbFlipTest, HorizontalWHOperatorMajorTest) {
+  TensorList<CPUBackend> bb_test_data;
+  this->LoadBbData(bb_test_data, &wh_rois);
+  this->SetExternalInputs({std::make_pair("bb_input", &bb_test_data)});
+  this->GetPipeline()->SetCPUExecutionMode(DALI_CPU_OPERATOR_MAJOR);
+  this->RunOperator(this->GetOperatorSpec(false, false, true), .001);
+}
+
+
+TYPED_TEST(BbFlipTest, Vertical2POperatorMajorTest) {
+  TensorList<CPUBackend> bb_test_data;
+  this->LoadBbData(bb_test_data, &two_pt_rois);
+  this->SetExternalInputs({std::make_pair("bb_input", &bb_test_data)});
+  this->GetPipeline()->SetCPUExecutionMode(DALI_CPU_OPERATOR_MAJOR);
+  this->RunOperator(this->GetOperatorSpec(true, true, false), .001);
+}
+
 }  // namespace dali
@@ -24,6 +24,25 @@ std::map<string, OpSchema>& SchemaRegistry::registry() {
   return schema_map;
 }
 
+const Index SampleShape::kUnknownDim;
+
+bool OpSchema::ProducesStridedOutputs(const OpSpec &spec) const {
+  return strided_outputs_ && spec.GetArgument<bool>("strided_outputs");
+}
+
+vector<SampleShape> OpSchema::InferOutputShapes(const OpSpec &spec,
+    const vector<SampleShape> &inputs) const {
+  vector<SampleShape> outputs(spec.NumOutput());
+  if (output_shape_fn_) {
+    output_shape_fn_(spec, inputs, &outputs);
+    DALI_ENFORCE(static_cast<int>(outputs.size()) == spec.NumOutput(),
+        "Output shape function of \"" + name_ + "\" returned " +
+        std::to_string(outputs.size()) + " shapes for " +
+        std::to_string(spec.NumOutput()) + " outputs.");
+  }
+  return outputs;
+}
+
 int OpSchema::CalculateOutputs(const OpSpec &spec) const {
   int num_input_sets = 1;
   if (allow_multiple_input_sets_) {
@@ -24,15 +24,50 @@
 
 #include "dali/common.h"
 #include "dali/error_handling.h"
+#include "dali/pipeline/data/tensor_shape.h"
 #include "dali/pipeline/operators/argument.h"
 
 namespace dali {
 
 class OpSpec;
 
+/**
+ * @brief Shape and type of the samples of an input or output of an op,
+ * as far as they are known without running the op. Unknown dimensions
+ * are kUnknownDim, an empty shape or a DALI_NO_TYPE type mean that
+ * nothing is known. The shape is the same for all the samples.
+ */
+struct DLL_PUBLIC SampleShape {
+  static const Index kUnknownDim = -1;
+
+  inline SampleShape() = default;
+
+  inline SampleShape(const TensorShape &shape, DALIDataType type, bool upper_bound = false)
+    : shape(shape), type(type), upper_bound(upper_bound) {}
+
+  /**
+   * @brief Returns whether all the dimensions of the shape are known.
+   */
+  inline bool IsKnown() const {
+    if (shape.empty()) return false;
+    for (Index dim : shape) {
+      if (dim == kUnknownDim) return false;
+    }
+    return true;
+  }
+
+  TensorShape shape;
+  DALIDataType type = DALI_NO_TYPE;
+  // Whether the samples have at most Product(shape) elements,
+  // rather than exactly this shape
+  bool upper_bound = false;
+};
+
 class DLL_PUBLIC OpSchema {
  public:
   typedef std::function<int(const OpSpec &spec)> SpecFunc;
+  typedef std::function<void(const OpSpec &spec, const vector<SampleShape> &inputs,
+                             vector<SampleShape> *outputs)> ShapeFunc;
 
   DLL_PUBLIC explicit inline OpSchema(const std::string &name)
     : name_(name),
@@ -51,6 +86,9 @@ class DLL_PUBLIC OpSchema {
         Value::construct(false));
     internal_arguments_["seed"] = std::make_pair("Random seed",
         Value::construct(1234));
+    internal_arguments_["strided_outputs"] = std::make_pair(
+        "Whether the Op may output strided views, if its schema allows them",
+        Value::construct(true));
   }
 
   DLL_PUBLIC inline ~OpSchema() = default;
@@ -99,6 +137,22 @@ class DLL_PUBLIC OpSchema {
     return *this;
   }
 
+  /**
+   * @brief Sets a function that infers the shapes and types of the
+   * samples of the outputs from the ones of the regular inputs and the
+   * op specification, without running the op. The executor uses them
+   * to preallocate the outputs when the graph is built.
+   *
+   * The function gets one SampleShape per regular input and fills in
+   * the ones of the outputs it can tell, leaving the others unknown.
+   * It must not rely on the arguments that are tensor arguments of the
+   * spec, as they differ between the samples.
+   */
+  DLL_PUBLIC inline OpSchema& OutputShapeFn(ShapeFunc f) {
+    output_shape_fn_ = f;
+    return *this;
+  }
+
   /**
    * @brief Sets the number of inputs that the op can receive.
    */
@@ -198,7 +252,37 @@ class DLL_PUBLIC OpSchema {
    * be executed in-place depending on the ops specification.
    */
   DLL_PUBLIC inline OpSchema& InPlaceFn(SpecFunc f) {
-    REPORT_FATAL_PROBLEM("In-place op support not yet implemented.");
+    in_place_fn_ = f;
+    return *this;
+  }
+
+  /**
+   * @brief Notes that the cpu op can write each output into the buffer
+   * of the input with the same index. The executor then passes the same
+   * Tensor as the input and the output, when the input is not read by
+   * any other op. The op must read every element of the input before
+   * writing the same element of the output.
+   */
+  DLL_PUBLIC inline OpSchema& AllowInPlace() {
+    return InPlaceFn([](const OpSpec &) { return 1; });
+  }
+
+  /**
+   * @brief Notes that the cpu op can output strided views into its
+   * inputs (see Tensor::ShareSlice) instead of copying the data. The
+   * pipeline keeps the inputs alive while the views are in use and
+   * inserts a dense copy before the ops that do not accept them.
+   */
+  DLL_PUBLIC inline OpSchema& AllowStridedOutputs() {
+    strided_outputs_ = true;
+    return *this;
+  }
+
+  /**
+   * @brief Notes that the cpu op can read strided views as inputs.
+   */
+  DLL_PUBLIC inline OpSchema& AcceptStridedInputs() {
+    strided_inputs_ = true;
     return *this;
   }
 
@@ -257,11 +341,33 @@ class DLL_PUBLIC OpSchema {
     return additional_outputs_fn_(spec);
   }
 
+  DLL_PUBLIC inline bool HasOutputShapeFn() const {
+    return static_cast<bool>(output_shape_fn_);
+  }
+
+  /**
+   * @brief Returns the shapes of the samples of the outputs of the op,
+   * as far as the schema can infer them from the ones of its regular
+   * inputs. See OutputShapeFn().
+   */
+  DLL_PUBLIC vector<SampleShape> InferOutputShapes(const OpSpec &spec,
+      const vector<SampleShape> &inputs) const;
+
   DLL_PUBLIC inline bool SupportsInPlace(const OpSpec &spec) const {
     if (!in_place_fn_) return false;
     return in_place_fn_(spec);
   }
 
+  /**
+   * @brief Returns whether the cpu op outputs strided views, which the
+   * pipeline can turn off for the op with the strided_outputs argument.
+   */
+  DLL_PUBLIC bool ProducesStridedOutputs(const OpSpec &spec) const;
+
+  DLL_PUBLIC inline bool AcceptsStridedInputs() const {
+    return strided_inputs_;
+  }
+
   DLL_PUBLIC void CheckArgs(const OpSpec &spec) const;
 
   DLL_PUBLIC inline const OpSchema& GetSchemaWithArgument(const string& name) const;
@@ -299,6 +405,7 @@ class DLL_PUBLIC OpSchema {
   string dox_;
   string name_;
   SpecFunc output_fn_, in_place_fn_, additional_outputs_fn_;
+  ShapeFunc output_shape_fn_;
 
   int min_num_input_ = 0, max_num_input_ = 0;
   int num_output_ = 0;
@@ -309,6 +416,9 @@ class DLL_PUBLIC OpSchema {
   bool enforce_layout_;
   DALITensorLayout layout_;
 
+  bool strided_outputs_ = false;
+  bool strided_inputs_ = false;
+
   std::map<std::string, std::pair<std::string, DALIDataType> > arguments_;
   std::map<std::string, std::pair<std::string, Value*> > optional_arguments_;
   std::map<std::string, std::pair<std::string, Value*> > internal_arguments_;
@@ -118,4 +118,54 @@ TEST(OpSchemaTest, OptionalArgumentDefaultValueMultipleParent) {
   ASSERT_EQ(schema.GetDefaultValueForOptionalArgument<float>("dummy"), 1.85f);
 }
 
+DALI_SCHEMA(Dummy8)
+  .NumInput(1).NumOutput(1)
+  .AllowInPlace();
+
+DALI_SCHEMA(Dummy9)
+  .NumInput(1).NumOutput(1)
+  .InPlaceFn([](const OpSpec& spec) {
+    return spec.GetArgument<bool>("inplace");
+  });
+
+TEST(OpSchemaTest, InPlaceTest) {
+  ASSERT_FALSE(SchemaRegistry::GetSchema("Dummy1").SupportsInPlace(OpSpec("Dummy1")));
+  ASSERT_TRUE(SchemaRegistry::GetSchema("Dummy8").SupportsInPlace(OpSpec("Dummy8")));
+
+  auto schema = SchemaRegistry::GetSchema("Dummy9");
+  ASSERT_FALSE(schema.SupportsInPlace(OpSpec("Dummy9")));
+  ASSERT_TRUE(schema.SupportsInPlace(OpSpec("Dummy9").AddArg("inplace", true)));
+}
+
+DALI_SCHEMA(Dummy10)
+  .NumInput(1).NumOutput(2)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    (*outputs)[0] = inputs[0];
+    (*outputs)[1] = SampleShape({SampleShape::kUnknownDim, 4}, DALI_FLOAT);
+  });
+
+TEST(OpSchemaTest, OutputShapeTest) {
+  vector<SampleShape> inputs = {SampleShape({480, 640, 3}, DALI_UINT8)};
+
+  // Without a function nothing is known about the outputs
+  auto spec1 = OpSpec("Dummy1").AddInput("in", "cpu").AddOutput("out", "cpu");
+  auto outputs = SchemaRegistry::GetSchema("Dummy1").InferOutputShapes(spec1, inputs);
+  ASSERT_EQ(outputs.size(), 1);
+  ASSERT_FALSE(outputs[0].IsKnown());
+  ASSERT_EQ(outputs[0].type, DALI_NO_TYPE);
+
+  auto spec10 = OpSpec("Dummy10").AddInput("in", "cpu")
+    .AddOutput("out0", "cpu").AddOutput("out1", "cpu");
+  outputs = SchemaRegistry::GetSchema("Dummy10").InferOutputShapes(spec10, inputs);
+  ASSERT_EQ(outputs.size(), 2);
+  ASSERT_TRUE(outputs[0].IsKnown());
+  ASSERT_EQ(outputs[0].shape, Dims({480, 640, 3}));
+  ASSERT_EQ(outputs[0].type, DALI_UINT8);
+  ASSERT_FALSE(outputs[0].upper_bound);
+  ASSERT_FALSE(outputs[1].IsKnown());
+  ASSERT_EQ(outputs[1].shape[1], 4);
+  ASSERT_EQ(outputs[1].type, DALI_FLOAT);
+}
+
 }  // namespace dali
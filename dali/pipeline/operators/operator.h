@@ -21,12 +21,14 @@
 #include "dali/common.h"
 #include "dali/error_handling.h"
 #include "dali/pipeline/workspace/device_workspace.h"
+#include "dali/pipeline/workspace/host_workspace.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/operators/operator_factory.h"
 #include "dali/pipeline/operators/op_schema.h"
 #include "dali/pipeline/operators/op_spec.h"
 #include "dali/pipeline/workspace/sample_workspace.h"
 #include "dali/pipeline/util/backend2workspace_map.h"
+#include "dali/pipeline/util/latency_histogram.h"
 
 namespace dali {
 
@@ -93,6 +95,22 @@ class OperatorBase {
     DALI_FAIL("CPU execution is not implemented for this operator!");
   }
 
+  /**
+   * @brief Executes the operator on the whole batch of samples on the CPU.
+   * Only used by the operator-major CPU execution mode, and only if
+   * CanRunBatch() returns true. Lets the op vectorize across samples.
+   */
+  virtual void RunBatch(HostWorkspace *ws) {
+    DALI_FAIL("Batched CPU execution is not implemented for this operator!");
+  }
+
+  /**
+   * @brief Returns true if the op implements RunBatch(HostWorkspace*).
+   */
+  virtual bool CanRunBatch() const {
+    return false;
+  }
+
   /**
    * @brief Executes the operator on a batch of samples on the GPU.
    */
@@ -131,6 +149,15 @@ class OperatorBase {
     return -1;
   }
 
+  /**
+   * @brief For reader Ops, returns the times spent waiting for the
+   * prefetch thread, for the execution statistics.
+   * For all other Ops, returns nullptr
+   */
+  virtual LatencyHistogram* prefetch_wait() {
+    return nullptr;
+  }
+
   int GetNumInputSets() const {
     return input_sets_;
   }
@@ -186,6 +213,7 @@ class Operator : public OperatorBase {
       }
       RunImpl(ws, i);
     }
+    ReleaseScratchHelper(ws);
   }
 
   /**
@@ -212,6 +240,16 @@ class Operator : public OperatorBase {
   template <typename B = Backend>
   typename std::enable_if<!std::is_same<B, GPUBackend>::value>::type
   SyncHelper(int /*unused*/, Workspace<B> */*unused*/) {}
+
+  template <typename B = Backend>
+  typename std::enable_if<std::is_same<B, CPUBackend>::value>::type
+  ReleaseScratchHelper(Workspace<B> *ws) {
+    ws->ReleaseThreadLocalScratch();
+  }
+
+  template <typename B = Backend>
+  typename std::enable_if<!std::is_same<B, CPUBackend>::value>::type
+  ReleaseScratchHelper(Workspace<B> */*unused*/) {}
 };
 
 template<>
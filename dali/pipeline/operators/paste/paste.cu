@@ -129,7 +129,7 @@ void Paste<GPUBackend>::SetupSampleParams(DeviceWorkspace *ws, const int idx) {
   std::vector<Dims> output_shape(batch_size_);
 
   for (int i = 0; i < batch_size_; ++i) {
-    std::vector<Index> input_shape = input.tensor_shape(i);
+    const auto &input_shape = input.tensor_shape(i);
     DALI_ENFORCE(input_shape.size() == 3,
         "Expects 3-dimensional image input.");
 
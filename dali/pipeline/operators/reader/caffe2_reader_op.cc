@@ -15,6 +15,8 @@
 
 #include "dali/pipeline/operators/reader/caffe2_reader_op.h"
 
+#include <vector>
+
 namespace dali {
 
 DALI_REGISTER_OPERATOR(Caffe2Reader, Caffe2Reader, CPU);
@@ -31,6 +33,18 @@ DALI_SCHEMA(Caffe2Reader)
       int has_bbox = static_cast<int>(spec.GetArgument<bool>("bbox"));
     return 1 + num_label_outputs + additional_inputs + has_bbox;
   })
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    // The type of the labels is the one stored in the database
+    auto label_type = static_cast<LabelType>(spec.GetArgument<int>("label_type"));
+    if (label_type == SINGLE_LABEL) {
+      (*outputs)[1] = SampleShape({1}, DALI_NO_TYPE);
+    } else if (label_type == MULTI_LABEL_SPARSE) {
+      (*outputs)[1] = SampleShape({spec.GetArgument<int>("num_labels")}, DALI_NO_TYPE);
+    } else if (label_type == MULTI_LABEL_WEIGHTED_SPARSE) {
+      (*outputs)[1] = SampleShape({spec.GetArgument<int>("num_labels")}, DALI_FLOAT);
+    }
+  })
   .AddArg("path",
       R"code(Path to Caffe2 LMDB directory.)code",
       DALI_STRING)
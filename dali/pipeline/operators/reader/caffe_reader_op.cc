@@ -14,6 +14,8 @@
 
 #include "dali/pipeline/operators/reader/caffe_reader_op.h"
 
+#include <vector>
+
 namespace dali {
 
 DALI_REGISTER_OPERATOR(CaffeReader, CaffeReader, CPU);
@@ -22,6 +24,11 @@ DALI_SCHEMA(CaffeReader)
   .DocStr("Read (Image, label) pairs from a Caffe LMDB")
   .NumInput(0)
   .NumOutput(2)  // (Images, Labels)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    (*outputs)[0] = SampleShape({SampleShape::kUnknownDim}, DALI_UINT8);
+    (*outputs)[1] = SampleShape({1}, DALI_INT32);
+  })
   .AddArg("path",
       R"code(Path to Caffe LMDB directory.)code",
       DALI_STRING)
@@ -20,6 +20,13 @@ DALI_REGISTER_OPERATOR(COCOReader, COCOReader, CPU);
 DALI_SCHEMA(COCOReader)
   .NumInput(0)
   .NumOutput(3)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    // The number of boxes differs between the images
+    (*outputs)[0] = SampleShape({SampleShape::kUnknownDim}, DALI_UINT8);
+    (*outputs)[1] = SampleShape({SampleShape::kUnknownDim, 4}, DALI_FLOAT);
+    (*outputs)[2] = SampleShape({SampleShape::kUnknownDim, 1}, DALI_INT32);
+  })
   .DocStr(R"code(Read data from a COCO dataset composed of directory with images
 and an anotation files. For each image, with `m` bboxes, returns its bboxes as (m,4)
 Tensor (`m` * `[x, y, w, h] or `m` * [left, top, right, bottom]`) and labels as `(m,1)` Tensor (`m` * `category_id`).)code")
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <vector>
 
 #include "dali/pipeline/operators/reader/file_reader_op.h"
 
@@ -24,6 +25,12 @@ DALI_SCHEMA(FileReader)
   .DocStr("Read (Image, label) pairs from a directory")
   .NumInput(0)
   .NumOutput(2)  // (Images, Labels)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    // Encoded images of any size and their labels
+    (*outputs)[0] = SampleShape({SampleShape::kUnknownDim}, DALI_UINT8);
+    (*outputs)[1] = SampleShape({1}, DALI_INT32);
+  })
   .AddArg("file_root",
       R"code(Path to a directory containing data files.)code",
       DALI_STRING)
@@ -32,7 +32,7 @@ class FileReader : public DataReader<CPUBackend> {
   void RunImpl(SampleWorkspace *ws, const int i) override {
     const int idx = ws->data_idx();
 
-    auto* raw_data = prefetched_batch_[idx];
+    auto* raw_data = GetSample(idx);
 
     // copy from raw_data -> outputs directly
     auto *image_output = ws->Output<CPUBackend>(0);
@@ -48,7 +48,7 @@ class FileReader : public DataReader<CPUBackend> {
     std::memcpy(image_output->raw_mutable_data(),
                 raw_data->raw_data(),
                 image_size);
-    image_output->SetSourceInfo(raw_data->GetSourceInfo());
+    image_output->SetSourceInfo(raw_data->source_info());
 
     label_output->mutable_data<int>()[0] =
        *reinterpret_cast<const int*>(raw_data->data<uint8_t>() + image_size);
@@ -16,6 +16,8 @@
 #include <sys/stat.h>
 #include <errno.h>
 
+#include <memory>
+
 #include "dali/common.h"
 #include "dali/pipeline/operators/reader/loader/file_loader.h"
 #include "dali/util/file.h"
@@ -90,31 +92,46 @@ vector<std::pair<string, int>> filesystem::traverse_directories(const std::strin
   return file_label_pairs;
 }
 void FileLoader::ReadSample(Tensor<CPUBackend>* tensor) {
-  auto image_pair = image_label_pairs_[current_index_++];
+  PrepareRead(tensor)();
+}
 
-  // handle wrap-around
-  if (current_index_ == Size()) {
-    current_index_ = 0;
+std::function<void()> FileLoader::PrepareRead(Tensor<CPUBackend>* tensor) {
+  Index index;
+  if (global_shuffle_) {
+    index = NextShuffledIndex();
+  } else {
+    index = current_index_++;
+    // handle wrap-around
+    if (current_index_ == Size()) {
+      current_index_ = 0;
+    }
   }
+  const auto &image_pair = (*image_label_pairs_)[index];
 
-  FileStream *current_image = FileStream::Open(file_root_ + "/" + image_pair.first);
-  Index image_size = current_image->Size();
+  // The read only uses copies, and the name, which it shares
+  const string path = file_root_ + "/" + image_pair.first;
+  const std::shared_ptr<const string> name(image_label_pairs_, &image_pair.first);
+  const int label = image_pair.second;
+  return [tensor, path, name, label]() {
+    std::unique_ptr<FileStream> current_image(FileStream::Open(path));
+    Index image_size = current_image->Size();
 
-  // resize tensor to hold [image, label]
-  tensor->Resize({image_size + static_cast<Index>(sizeof(int))});
+    // resize tensor to hold [image, label]
+    tensor->Resize({image_size + static_cast<Index>(sizeof(int))});
 
-  // copy the image
-  current_image->Read(tensor->mutable_data<uint8_t>(), image_size);
-  tensor->SetSourceInfo(image_pair.first);
+    // copy the image
+    current_image->Read(tensor->mutable_data<uint8_t>(), image_size);
+    tensor->SetSourceInfo(SourceInfo(name));
 
-  // close the file handle
-  current_image->Close();
+    // close the file handle
+    current_image->Close();
 
-  // copy the label
-  *(reinterpret_cast<int*>(&tensor->mutable_data<uint8_t>()[image_size])) = image_pair.second;
+    // copy the label
+    *(reinterpret_cast<int*>(&tensor->mutable_data<uint8_t>()[image_size])) = label;
+  };
 }
 
 Index FileLoader::Size() {
-  return static_cast<Index>(image_label_pairs_.size());
+  return static_cast<Index>(image_label_pairs_->size());
 }
 }  // namespace dali
@@ -20,6 +20,8 @@
 #include <errno.h>
 
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -44,13 +46,12 @@ class FileLoader : public Loader<CPUBackend> {
       vector<std::pair<string, int>> image_label_pairs = std::vector<std::pair<string, int>>())
     : Loader<CPUBackend>(spec),
       file_root_(spec.GetArgument<string>("file_root")),
-      image_label_pairs_(image_label_pairs),
       current_index_(0) {
     file_list_ = spec.GetArgument<string>("file_list");
 
-    if (image_label_pairs_.empty()) {
+    if (image_label_pairs.empty()) {
       if (file_list_ == "") {
-        image_label_pairs_ = filesystem::traverse_directories(file_root_);
+        image_label_pairs = filesystem::traverse_directories(file_root_);
       } else {
         // load (path, label) pairs from list
         std::ifstream s(file_list_);
@@ -60,26 +61,30 @@ class FileLoader : public Loader<CPUBackend> {
         int label;
         while (s >> image_file >> label) {
           auto p = std::make_pair(image_file, label);
-          image_label_pairs_.push_back(p);
+          image_label_pairs.push_back(p);
         }
         DALI_ENFORCE(s.eof(), "Wrong format of file_list.");
       }
     }
 
-    DALI_ENFORCE(Size() > 0, "No files found.");
+    DALI_ENFORCE(!image_label_pairs.empty(), "No files found.");
 
     if (shuffle_) {
       // seeded with hardcoded value to get
       // the same sequence on every shard
-      std::mt19937 g(524287);
-      std::shuffle(image_label_pairs_.begin(), image_label_pairs_.end(), g);
+      std::mt19937 g(kShardShuffleSeed);
+      std::shuffle(image_label_pairs.begin(), image_label_pairs.end(), g);
     }
+    image_label_pairs_ = std::make_shared<const vector<std::pair<string, int>>>(
+        std::move(image_label_pairs));
 
     current_index_ = start_index(shard_id_, num_shards_, Size());
   }
 
   void ReadSample(Tensor<CPUBackend>* tensor) override;
 
+  std::function<void()> PrepareRead(Tensor<CPUBackend>* tensor) override;
+
   Index Size() override;
 
  protected:
@@ -87,7 +92,8 @@ class FileLoader : public Loader<CPUBackend> {
   using Loader<CPUBackend>::num_shards_;
 
   string file_root_, file_list_;
-  vector<std::pair<string, int>> image_label_pairs_;
+  // The source info of the samples shares the names in it
+  std::shared_ptr<const vector<std::pair<string, int>>> image_label_pairs_;
   Index current_index_;
 };
 
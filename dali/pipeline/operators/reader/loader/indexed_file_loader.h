@@ -31,6 +31,7 @@ class IndexedFileLoader : public Loader<CPUBackend> {
  public:
   explicit IndexedFileLoader(const OpSpec& options, bool init = true)
     : Loader(options),
+      use_mmap_(options.GetArgument<bool>("use_mmap")),
       current_file_(nullptr) {
       // trick for https://stackoverflow.com/questions/962132/calling-virtual-functions-inside-constructors
       if (init)
@@ -38,7 +39,9 @@ class IndexedFileLoader : public Loader<CPUBackend> {
     }
 
   void ReadSample(Tensor<CPUBackend>* tensor) override {
-    if (current_index_ == indices_.size()) {
+    if (global_shuffle_) {
+      MoveTo(NextShuffledIndex());
+    } else if (current_index_ == indices_.size()) {
       Reset();
     }
     int64 seek_pos, size;
@@ -46,15 +49,20 @@ class IndexedFileLoader : public Loader<CPUBackend> {
     std::tie(seek_pos, size, file_index) = indices_[current_index_];
     if (file_index != current_file_index_) {
       current_file_->Close();
-      current_file_.reset(FileStream::Open(uris_[file_index]));
+      current_file_.reset(FileStream::Open(uris_[file_index], use_mmap_));
       current_file_index_ = file_index;
     }
+    tensor->SetSourceInfo(SourceInfo(sources_[current_file_index_], seek_pos));
+    if (ShareSample(tensor, size)) {
+      ++current_index_;
+      return;
+    }
+    tensor->UnshareData();
     tensor->Resize({size});
     tensor->mutable_data<uint8_t>();
 
     int64 n_read = current_file_->Read(reinterpret_cast<uint8_t*>(tensor->raw_mutable_data()),
                         size);
-    tensor->SetSourceInfo(uris_[current_file_index_] + " at index " + to_string(seek_pos));
     DALI_ENFORCE(n_read == size, "Error reading from a file");
     ++current_index_;
     return;
@@ -90,6 +98,9 @@ class IndexedFileLoader : public Loader<CPUBackend> {
       options.GetRepeatedArgument<std::string>("path");
     DALI_ENFORCE(!uris_.empty(),
         "No files specified.");
+    for (const std::string &uri : uris_) {
+      sources_.push_back(std::make_shared<const std::string>(uri));
+    }
     std::vector<std::string> index_uris =
       options.GetRepeatedArgument<std::string>("index_path");
     ReadIndexFile(index_uris);
@@ -97,24 +108,45 @@ class IndexedFileLoader : public Loader<CPUBackend> {
     current_index_ = start_index(shard_id_, num_shards_, num_indices);
     int64 seek_pos, size;
     std::tie(seek_pos, size, current_file_index_) = indices_[current_index_];
-    current_file_.reset(FileStream::Open(uris_[current_file_index_]));
+    current_file_.reset(FileStream::Open(uris_[current_file_index_], use_mmap_));
     current_file_->Seek(seek_pos);
   }
 
   void Reset() {
-    current_index_ = 0;
+    MoveTo(0);
+  }
+
+  // Moves to the sample `index`, in whichever file it is
+  void MoveTo(size_t index) {
+    current_index_ = index;
     int64 seek_pos, size;
     size_t file_index;
     std::tie(seek_pos, size, file_index) = indices_[current_index_];
     if (file_index != current_file_index_) {
       current_file_->Close();
-      current_file_.reset(FileStream::Open(uris_[file_index]));
+      current_file_.reset(FileStream::Open(uris_[file_index], use_mmap_));
       current_file_index_ = file_index;
     }
     current_file_->Seek(seek_pos);
   }
 
+  // With use_mmap, makes `tensor` share the next `size` bytes of the
+  // mapped file instead of reading them. The tensor keeps the mapping
+  // alive. Returns false if the sample has to be read
+  bool ShareSample(Tensor<CPUBackend>* tensor, int64 size) {
+    if (!use_mmap_) return false;
+    shared_ptr<void> p = current_file_->Get(size);
+    if (p == nullptr) return false;
+    tensor->ShareData(p, size);
+    tensor->Resize({size});
+    tensor->set_type(TypeInfo::Create<uint8_t>());
+    return true;
+  }
+
+  const bool use_mmap_;
   std::vector<std::string> uris_;
+  // uris_, shared with the source info of the samples
+  std::vector<std::shared_ptr<const std::string>> sources_;
   std::vector<std::tuple<int64, int64, size_t>> indices_;
   size_t current_index_;
   size_t current_file_index_;
@@ -16,7 +16,9 @@
 #define DALI_PIPELINE_OPERATORS_READER_LOADER_LMDB_H_
 
 #include <lmdb.h>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "dali/common.h"
 #include "dali/pipeline/operators/reader/loader/loader.h"
@@ -65,12 +67,12 @@ class LMDBReader : public Loader<CPUBackend> {
  public:
   explicit LMDBReader(const OpSpec& options)
     : Loader(options),
-      db_path_(options.GetArgument<string>("path")) {
+      db_path_(std::make_shared<const string>(options.GetArgument<string>("path"))) {
 
     // Create the db environment, open the passed DB
     CHECK_LMDB(mdb_env_create(&mdb_env_));
     auto mdb_flags = MDB_RDONLY | MDB_NOTLS | MDB_NOLOCK;
-    CHECK_LMDB(mdb_env_open(mdb_env_, db_path_.c_str(), mdb_flags, 0664));
+    CHECK_LMDB(mdb_env_open(mdb_env_, db_path_->c_str(), mdb_flags, 0664));
 
     // Create transaction and cursor
     CHECK_LMDB(mdb_txn_begin(mdb_env_, NULL, MDB_RDONLY, &mdb_transaction_));
@@ -80,6 +82,16 @@ class LMDBReader : public Loader<CPUBackend> {
     // Optional: debug printing
     lmdb::PrintLMDBStats(mdb_transaction_, mdb_dbi_);
 
+    if (global_shuffle_) {
+      // The samples are read by key. The keys point into the memory
+      // map of the db, that stays open
+      keys_.reserve(Size());
+      while (lmdb::SeekLMDB(mdb_cursor_, MDB_NEXT, &key_, &value_)) {
+        keys_.push_back(key_);
+      }
+      return;
+    }
+
     // work out how many entries to move forward to handle sharding
     if (shard_id_ == 0) return;
     int start_idx = start_index(shard_id_, num_shards_, Size());
@@ -98,17 +110,25 @@ class LMDBReader : public Loader<CPUBackend> {
   }
 
   void ReadSample(Tensor<CPUBackend>* tensor) override {
-    // assume cursor is valid, read next, loop to start if necessary
-    bool ok = lmdb::SeekLMDB(mdb_cursor_, MDB_NEXT, &key_, &value_);
-
-    if (!ok) {
-      bool ok = lmdb::SeekLMDB(mdb_cursor_, MDB_FIRST, &key_, &value_);
+    if (global_shuffle_) {
+      key_ = keys_[NextShuffledIndex()];
+      bool ok = lmdb::SeekLMDB(mdb_cursor_, MDB_SET_KEY, &key_, &value_);
       DALI_ENFORCE(ok, "lmdb::SeekLMDB failed");
+    } else {
+      // assume cursor is valid, read next, loop to start if necessary
+      bool ok = lmdb::SeekLMDB(mdb_cursor_, MDB_NEXT, &key_, &value_);
+
+      if (!ok) {
+        bool ok = lmdb::SeekLMDB(mdb_cursor_, MDB_FIRST, &key_, &value_);
+        DALI_ENFORCE(ok, "lmdb::SeekLMDB failed");
+      }
     }
 
     tensor->Resize({static_cast<Index>(value_.mv_size)});
     tensor->mutable_data<uint8_t>();
-    tensor->SetSourceInfo(db_path_ + " at key " + to_string(reinterpret_cast<char*>(key_.mv_data)));
+    // The key points into the memory map of the db, the source info copies it
+    tensor->SetSourceInfo(SourceInfo(db_path_,
+          reinterpret_cast<const char*>(key_.mv_data), key_.mv_size));
 
     std::memcpy(tensor->raw_mutable_data(),
                 reinterpret_cast<uint8_t*>(value_.mv_data),
@@ -132,9 +152,12 @@ class LMDBReader : public Loader<CPUBackend> {
 
   // values
   MDB_val key_, value_;
+  // keys of all the samples, with global_shuffle
+  std::vector<MDB_val> keys_;
 
   // options
-  string db_path_;
+  // shared with the source info of the samples
+  std::shared_ptr<const string> db_path_;
 };
 
 };  // namespace dali
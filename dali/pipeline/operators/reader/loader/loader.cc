@@ -17,17 +17,54 @@
 
 namespace dali {
 
+namespace {
+
+// Rounds of the Feistel network of shuffled_index()
+const int kFeistelRounds = 4;
+
+// Finalizer of splitmix64, mixes all the bits of x into every bit
+inline uint64_t mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+}  // namespace
+
 DALI_SCHEMA(LoaderBase)
   .AddOptionalArg("random_shuffle",
       R"code(Whether to randomly shuffle data.)code", false)
   .AddOptionalArg("initial_fill",
       R"code(Size of the buffer used for shuffling.)code", 1024)
+  .AddOptionalArg("global_shuffle",
+      R"code(Shuffle all the samples again every epoch, and read the part of them
+of this shard directly. Every shard draws the same permutation, so the shards
+read disjoint samples. Unlike random_shuffle, it does not need a buffer of
+initial_fill samples. Cannot be used with random_shuffle.)code", false)
+  .AddOptionalArg("shuffle_seed",
+      R"code(Seed of the permutations drawn by global_shuffle, along with the epoch
+number. It has to be the same on every shard, or the shards read overlapping
+samples.)code", kShardShuffleSeed)
   .AddOptionalArg("num_shards",
       R"code(Partition the data into this many parts (used for multiGPU training).)code", 1)
   .AddOptionalArg("shard_id",
       R"code(Id of the part to read.)code", 0)
   .AddOptionalArg("tensor_init_bytes",
-      R"code(Hint for how much memory to allocate per image.)code", 1048576);
+      R"code(Hint for how much memory to allocate per image.)code", 1048576)
+  .AddOptionalArg("use_mmap",
+      R"code(Memory map the files read by the MXNet and TFRecord readers. The samples
+are then read from the page cache without copying them.)code", false)
+  .AddOptionalArg("reads_in_flight",
+      R"code(Number of samples the FileReader and COCOReader read at the same time,
+on as many threads. Reading ahead helps to keep network filesystems and cold
+page caches busy. The samples are the same, and in the same order, as when
+they are read one at a time.)code", 1)
+  .AddOptionalArg("prefetch_queue_depth",
+      R"code(Number of batches the reader prefetches. The reader keeps going while a
+batch is slow to read, as long as the batches prefetched before it last.)code", 1);
 
 
 size_t start_index(const size_t shard_id,
@@ -41,4 +78,29 @@ size_t start_index(const size_t shard_id,
   }
 }
 
+Index shuffled_index(Index index, Index size, uint64_t key) {
+  DALI_ENFORCE(index >= 0 && index < size, "Index " + std::to_string(index) +
+      " out of range [0, " + std::to_string(size) + ")");
+  // A Feistel network is a bijection of the 2 * half_bits wide numbers,
+  // which hold at most 4 times size. The numbers it maps past the
+  // samples are mapped again, until they land on a sample: as the
+  // network is a bijection, that still gives a permutation of [0, size)
+  int half_bits = 1;
+  while ((static_cast<Index>(1) << (2 * half_bits)) < size) ++half_bits;
+  const uint64_t mask = (static_cast<uint64_t>(1) << half_bits) - 1;
+
+  uint64_t x = index;
+  do {
+    uint64_t left = x >> half_bits;
+    uint64_t right = x & mask;
+    for (int round = 0; round < kFeistelRounds; ++round) {
+      uint64_t next = left ^ (mix64(right ^ mix64(key + round)) & mask);
+      left = right;
+      right = next;
+    }
+    x = (left << half_bits) | right;
+  } while (x >= static_cast<uint64_t>(size));
+  return x;
+}
+
 }  // namespace dali
@@ -15,9 +15,11 @@
 #ifndef DALI_PIPELINE_OPERATORS_READER_LOADER_LOADER_H_
 #define DALI_PIPELINE_OPERATORS_READER_LOADER_LOADER_H_
 
-#include <list>
+#include <deque>
+#include <functional>
+#include <future>
 #include <map>
-#include <mutex>
+#include <memory>
 #include <random>
 #include <string>
 #include <utility>
@@ -26,7 +28,10 @@
 #include "dali/common.h"
 #include "dali/error_handling.h"
 #include "dali/pipeline/operators/op_spec.h"
+#include "dali/pipeline/data/memory_tracker.h"
 #include "dali/pipeline/data/tensor.h"
+#include "dali/pipeline/util/mpmc_ring.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 
@@ -34,18 +39,37 @@ DLL_PUBLIC size_t start_index(const size_t shard_id,
                               const size_t shard_num,
                               const size_t size);
 
+// Position of the `index`-th sample, out of `size`, in the permutation
+// drawn with `key`. Every index of the permutation is computed on its
+// own, in constant time, without drawing the whole permutation
+DLL_PUBLIC Index shuffled_index(Index index, Index size, uint64_t key);
+
+// Seed of the shuffles that have to be the same on every shard
+const int kShardShuffleSeed = 524287;
+
 template <class Backend>
 class Loader {
  public:
   explicit Loader(const OpSpec& options)
     : shuffle_(options.GetArgument<bool>("random_shuffle")),
+      global_shuffle_(options.GetArgument<bool>("global_shuffle")),
       initial_buffer_fill_(shuffle_ ? options.GetArgument<int>("initial_fill") : 1),
-      initial_empty_size_(2 * options.GetArgument<int>("batch_size")),
+      // one batch more than the prefetched ones, for the batch being read
+      initial_empty_size_((options.GetArgument<int>("prefetch_queue_depth") + 1) *
+                          options.GetArgument<int>("batch_size")),
       tensor_init_bytes_(options.GetArgument<int>("tensor_init_bytes")),
       seed_(options.GetArgument<Index>("seed")),
+      shuffle_seed_(options.GetArgument<int>("shuffle_seed")),
       shard_id_(options.GetArgument<int>("shard_id")),
-      num_shards_(options.GetArgument<int>("num_shards")) {
+      num_shards_(options.GetArgument<int>("num_shards")),
+      reads_in_flight_(options.GetArgument<int>("reads_in_flight")),
+      // room for every tensor the loader allocates: the sample buffer,
+      // the empties and the ones read ahead
+      empty_tensors_(initial_buffer_fill_ + initial_empty_size_ + reads_in_flight_) {
     DALI_ENFORCE(initial_empty_size_ > 0, "Batch size needs to be greater than 0");
+    DALI_ENFORCE(reads_in_flight_ > 0, "reads_in_flight needs to be greater than 0");
+    DALI_ENFORCE(!(shuffle_ && global_shuffle_),
+        "random_shuffle and global_shuffle cannot be used together");
     // initialize a random distribution -- this will be
     // used to pick from our sample buffer
     dis = std::uniform_int_distribution<>(0, initial_buffer_fill_);
@@ -54,16 +78,20 @@ class Loader {
   }
 
   virtual ~Loader() {
+    // finish the reads still in flight before deleting their tensors
+    read_pool_.reset();
+    for (auto &read : reads_) {
+      delete read.first;
+    }
     // delete all the temporary tensors
     while (!sample_buffer_.empty()) {
       Tensor<Backend> * t = sample_buffer_.back();
       delete t;
       sample_buffer_.pop_back();
     }
-    while (!empty_tensors_.empty()) {
-      Tensor<Backend> * t = empty_tensors_.back();
+    Tensor<Backend> * t;
+    while (empty_tensors_.TryPop(&t)) {
       delete t;
-      empty_tensors_.pop_back();
     }
   }
 
@@ -74,20 +102,20 @@ class Loader {
     if (!initial_buffer_filled_) {
       TimeRange tr("[Loader] Filling initial buffer", TimeRange::kBlue1);
       // Read an initial number of samples to fill our
-      // sample buffer
-      for (int i = 0; i < initial_buffer_fill_; ++i) {
+      // sample buffer. The samples are already shuffled
+      // with global_shuffle, which needs no buffer
+      for (int i = 0; i < (global_shuffle_ ? 0 : initial_buffer_fill_); ++i) {
         Tensor<Backend>* tensor = new Tensor<CPUBackend>();
         tensor->set_pinned(false);
         // Initialize tensors to a set size to limit expensive reallocations
         tensor->Resize({tensor_init_bytes_});
         tensor->template mutable_data<uint8_t>();
 
-        ReadSample(tensor);
-        sample_buffer_.push_back(tensor);
+        sample_buffer_.push_back(Read(tensor));
       }
 
       TimeRange tr2("[Loader] Filling empty list", TimeRange::kOrange);
-      // need some entries in the empty_tensors_ list
+      // need some entries in the empty_tensors_ pool
       for (int i = 0; i < initial_empty_size_; ++i) {
         Tensor<Backend>* tensor = new Tensor<CPUBackend>();
         tensor->set_pinned(false);
@@ -95,11 +123,16 @@ class Loader {
         tensor->Resize({tensor_init_bytes_});
         tensor->template mutable_data<uint8_t>();
 
-        empty_tensors_.push_back(tensor);
+        ReturnTensor(tensor);
       }
 
       initial_buffer_filled_ = true;
     }
+
+    if (global_shuffle_) {
+      return Read(TakeEmptyTensor());
+    }
+
     // choose the random index
     int idx = shuffle_ ? dis(e_) % sample_buffer_.size() : 0;
     Tensor<Backend>* elem = sample_buffer_[idx];
@@ -110,26 +143,23 @@ class Loader {
     sample_buffer_.pop_back();
 
     // now grab an empty tensor, fill it and add to filled buffers
-    // empty_tensors_ needs to be thread-safe w.r.t. ReturnTensor()
-    // being called by multiple consumer threads
-    Tensor<Backend>* t;
-    {
-      std::lock_guard<std::mutex> lock(return_mutex_);
-      DALI_ENFORCE(empty_tensors_.size() > 0, "No empty tensors - did you forget to return them?");
-      t = empty_tensors_.back();
-      empty_tensors_.pop_back();
-    }
-    ReadSample(t);
-    sample_buffer_.push_back(t);
+    sample_buffer_.push_back(Read(TakeEmptyTensor()));
 
     return elem;
   }
 
   // return a tensor to the empty pile
-  // called by multiple consumer threads
+  // called by multiple consumer threads, without locking
   void ReturnTensor(Tensor<Backend>* tensor) {
-    std::lock_guard<std::mutex> lock(return_mutex_);
-    empty_tensors_.push_back(tensor);
+    DALI_ENFORCE(empty_tensors_.TryPush(tensor),
+        "More tensors returned than the loader allocated");
+  }
+
+  // return the tensors of a whole batch at once
+  void ReturnTensors(const std::vector<Tensor<Backend>*> &tensors) {
+    for (auto *tensor : tensors) {
+      ReturnTensor(tensor);
+    }
   }
 
   // Read an actual sample from the FileStore,
@@ -137,17 +167,99 @@ class Loader {
   // reads.
   virtual void ReadSample(Tensor<Backend>* tensor) = 0;
 
+  // Loaders whose reads can run in parallel override it. It moves
+  // the loader to the next sample, like ReadSample() does, and
+  // returns the work that reads that sample into `tensor`. The work
+  // must not use the loader, which may be destroyed while it runs.
+  virtual std::function<void()> PrepareRead(Tensor<Backend>* tensor) {
+    return nullptr;
+  }
+
   // Give the size of the data accessed through the Loader
   virtual Index Size() = 0;
 
  protected:
-  std::vector<Tensor<Backend>*> sample_buffer_;
+  // Reads the next sample. With reads_in_flight > 1, the read of the
+  // sample goes into `tensor` and runs in the background, while the
+  // sample returned is the oldest of the reads in flight. The samples
+  // come out in the same order as when they are read one at a time.
+  Tensor<Backend>* Read(Tensor<Backend>* tensor) {
+    std::function<void()> read;
+    if (reads_in_flight_ > 1) {
+      read = PrepareRead(tensor);
+    }
+    if (!read) {
+      ReadSample(tensor);
+      return tensor;
+    }
+
+    if (!read_pool_) {
+      read_pool_.reset(new ThreadPool(reads_in_flight_, CPU_ONLY_DEVICE_ID, false));
+    }
+    StartRead(tensor, std::move(read));
+    // The first time, reads ahead into tensors of their own
+    while (reads_.size() < static_cast<size_t>(reads_in_flight_)) {
+      Tensor<Backend>* ahead = new Tensor<CPUBackend>();
+      ahead->set_pinned(false);
+      ahead->Resize({tensor_init_bytes_});
+      ahead->template mutable_data<uint8_t>();
+      StartRead(ahead, PrepareRead(ahead));
+    }
 
-  std::list<Tensor<Backend>*> empty_tensors_;
+    // The future rethrows the errors of the read
+    auto oldest = std::move(reads_.front());
+    reads_.pop_front();
+    oldest.second.get();
+    return oldest.first;
+  }
+
+  // With global_shuffle, the loaders read the sample of this index
+  // next, instead of the one after the last they read. The indices
+  // are this shard's part of a permutation of all the samples, which
+  // is drawn again every epoch, from shuffle_seed and the epoch number
+  // only, so that every shard draws the same one. A shard only
+  // computes its own part of it
+  Index NextShuffledIndex() {
+    if (epoch_pos_ == epoch_end_) {
+      epoch_size_ = Size();
+      epoch_pos_ = start_index(shard_id_, num_shards_, epoch_size_);
+      epoch_end_ = start_index(shard_id_ + 1, num_shards_, epoch_size_);
+      DALI_ENFORCE(epoch_pos_ < epoch_end_, "Shard " + std::to_string(shard_id_) +
+          " has no samples to read");
+      std::seed_seq seq({static_cast<Index>(shuffle_seed_), epoch_++});
+      std::mt19937_64 g(seq);
+      epoch_key_ = g();
+    }
+    return shuffled_index(epoch_pos_++, epoch_size_, epoch_key_);
+  }
+
+  // empty_tensors_ is lock-free, so that ReturnTensor() can be
+  // called by multiple consumer threads while the loader takes from it
+  Tensor<Backend>* TakeEmptyTensor() {
+    Tensor<Backend>* t;
+    DALI_ENFORCE(empty_tensors_.TryPop(&t), "No empty tensors - did you forget to return them?");
+    return t;
+  }
+
+  void StartRead(Tensor<Backend>* tensor, std::function<void()> read) {
+    auto task = std::make_shared<std::packaged_task<void()>>(std::move(read));
+    reads_.emplace_back(tensor, task->get_future());
+    // The reads are accounted to the op, like the ones of this thread
+    MemoryTag *current_tag = MemoryTag::Current();
+    std::shared_ptr<MemoryTag> tag =
+        current_tag ? current_tag->shared_from_this() : nullptr;
+    read_pool_->DoWorkWithID([task, tag](int) {
+        MemoryTagScope memory_scope(tag.get());
+        (*task)();
+      });
+  }
+
+  std::vector<Tensor<Backend>*> sample_buffer_;
 
   // number of samples to initialize buffer with
   // ~1 minibatch seems reasonable
   bool shuffle_;
+  const bool global_shuffle_;
   const int initial_buffer_fill_;
   const int initial_empty_size_;
   const int tensor_init_bytes_;
@@ -157,13 +269,28 @@ class Loader {
   std::default_random_engine e_;
   std::uniform_int_distribution<> dis;
   Index seed_;
-
-  // control return of tensors
-  std::mutex return_mutex_;
+  const int shuffle_seed_;
 
   // sharding
   const int shard_id_;
   const int num_shards_;
+
+  // global_shuffle: the permutation of the current epoch, and the
+  // positions in it of the next sample to read and of the end of
+  // this shard's part
+  Index epoch_ = 0;
+  uint64_t epoch_key_ = 0;
+  Index epoch_size_ = 0;
+  Index epoch_pos_ = 0;
+  Index epoch_end_ = 0;
+
+  // parallel reads, oldest first
+  const int reads_in_flight_;
+  std::unique_ptr<ThreadPool> read_pool_;
+  std::deque<std::pair<Tensor<Backend>*, std::future<void>>> reads_;
+
+  // recycled tensors, returned by the consumers
+  MPMCRing<Tensor<Backend>*> empty_tensors_;
 };
 
 };  // namespace dali
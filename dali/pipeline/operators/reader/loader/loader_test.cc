@@ -13,16 +13,27 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "dali/common.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/memory_tracker.h"
 #include "dali/pipeline/operators/op_spec.h"
 #include "dali/test/dali_test.h"
 
 #include "dali/pipeline/operators/reader/loader/loader.h"
 #include "dali/pipeline/operators/reader/loader/file_loader.h"
 #include "dali/pipeline/operators/reader/loader/lmdb.h"
+#include "dali/pipeline/operators/reader/loader/recordio_loader.h"
 
 namespace dali {
 
@@ -88,6 +99,281 @@ TYPED_TEST(DataLoadStoreTest, LoaderTestFail) {
   throw std::runtime_error("LoaderTestFail failed");
 }
 
+static string SampleString(const Tensor<CPUBackend> &sample) {
+  return string(reinterpret_cast<const char*>(sample.data<uint8_t>()), sample.size());
+}
+
+// Writes `size` bytes to a new temporary file and returns its path
+static string WriteTempFile(const char *data, size_t size) {
+  char path[] = "/tmp/dali_loader_test_XXXXXX";
+  int fd = mkstemp(path);
+  DALI_ENFORCE(fd >= 0, "Could not create a temporary file");
+  DALI_ENFORCE(write(fd, data, size) == static_cast<ssize_t>(size),
+      "Could not write a temporary file");
+  close(fd);
+  return path;
+}
+
+TYPED_TEST(DataLoadStoreTest, RecordIOMmapTest) {
+  // Records of 4, 8 and 4 bytes, the second one split across the files
+  const char data[] = "0123456789abcdef";
+  const vector<string> paths = {WriteTempFile(data, 10), WriteTempFile(data + 10, 6)};
+  const string index = "0 0\n1 4\n2 12\n";
+  const string index_path = WriteTempFile(index.data(), index.size());
+
+  for (bool use_mmap : {false, true}) {
+    std::unique_ptr<RecordIOLoader> loader(
+        new RecordIOLoader(
+            OpSpec("MXNetReader")
+            .AddArg("path", paths)
+            .AddArg("index_path", vector<string>{index_path})
+            .AddArg("use_mmap", use_mmap)
+            .AddArg("batch_size", 1)));
+    ASSERT_EQ(loader->Size(), 3);
+
+    Tensor<CPUBackend> samples[3];
+    for (auto &sample : samples) {
+      sample.set_pinned(false);
+      loader->ReadSample(&sample);
+    }
+    ASSERT_EQ(SampleString(samples[0]), "0123");
+    ASSERT_EQ(SampleString(samples[1]), "456789ab");
+    ASSERT_EQ(SampleString(samples[2]), "cdef");
+    // The records that are in a single file are not copied
+    ASSERT_EQ(samples[0].shares_data(), use_mmap);
+    ASSERT_FALSE(samples[1].shares_data());
+    ASSERT_EQ(samples[2].shares_data(), use_mmap);
+
+    // The samples keep the files mapped
+    loader.reset();
+    ASSERT_EQ(SampleString(samples[2]), "cdef");
+
+    // With global_shuffle, every epoch reads all the records, in any order
+    loader.reset(
+        new RecordIOLoader(
+            OpSpec("MXNetReader")
+            .AddArg("path", paths)
+            .AddArg("index_path", vector<string>{index_path})
+            .AddArg("use_mmap", use_mmap)
+            .AddArg("global_shuffle", true)
+            .AddArg("batch_size", 1)));
+    for (int epoch = 0; epoch < 2; ++epoch) {
+      vector<string> records;
+      for (auto &sample : samples) {
+        loader->ReadSample(&sample);
+        records.push_back(SampleString(sample));
+      }
+      std::sort(records.begin(), records.end());
+      ASSERT_EQ(records, (vector<string>{"0123", "456789ab", "cdef"}));
+    }
+  }
+
+  for (const string &path : paths) {
+    std::remove(path.c_str());
+  }
+  std::remove(index_path.c_str());
+}
+
+// Writes two classes of 10 files of different sizes, in subdirectories
+// of `root`, which is created
+static vector<string> WriteClassDirs(char *root) {
+  DALI_ENFORCE(mkdtemp(root) != nullptr, "Could not create a temporary directory");
+  vector<string> files;
+  for (int label = 0; label < 2; ++label) {
+    const string dir = string(root) + "/" + std::to_string(label);
+    DALI_ENFORCE(mkdir(dir.c_str(), 0700) == 0, "Could not create " + dir);
+    for (int i = 0; i < 10; ++i) {
+      files.push_back(dir + "/" + std::to_string(i) + ".jpg");
+      std::ofstream(files.back()) << string(label * 10 + i + 1, 'a' + i);
+    }
+  }
+  return files;
+}
+
+static void RemoveClassDirs(const char *root, const vector<string> &files) {
+  for (const string &file : files) {
+    std::remove(file.c_str());
+  }
+  for (int label = 0; label < 2; ++label) {
+    rmdir((string(root) + "/" + std::to_string(label)).c_str());
+  }
+  rmdir(root);
+}
+
+TYPED_TEST(DataLoadStoreTest, ParallelReadsTest) {
+  char root[] = "/tmp/dali_loader_test_XXXXXX";
+  const vector<string> files = WriteClassDirs(root);
+
+  // The samples come in the same order, however many are read at once
+  for (bool shuffle : {false, true}) {
+    vector<string> samples[2];
+    for (int reads : {1, 4}) {
+      std::unique_ptr<FileLoader> loader(
+          new FileLoader(
+              OpSpec("FileReader")
+              .AddArg("file_root", string(root))
+              .AddArg("random_shuffle", shuffle)
+              .AddArg("initial_fill", 3)
+              .AddArg("reads_in_flight", reads)
+              .AddArg("batch_size", 2)));
+      for (int i = 0; i < 50; ++i) {
+        auto* sample = loader->ReadOne();
+        samples[reads > 1].push_back(SampleString(*sample) + sample->GetSourceInfo());
+        loader->ReturnTensor(sample);
+      }
+    }
+    ASSERT_EQ(samples[0], samples[1]);
+  }
+
+  RemoveClassDirs(root, files);
+}
+
+// Counts the reads it runs in the background, and those of them that
+// run with the memory tag expected
+class TagCountingLoader : public Loader<CPUBackend> {
+ public:
+  TagCountingLoader(const OpSpec& options, MemoryTag *expected_tag)
+    : Loader<CPUBackend>(options),
+      expected_tag_(expected_tag),
+      reads_(std::make_shared<std::atomic<int>>(0)),
+      tagged_reads_(std::make_shared<std::atomic<int>>(0)) {}
+
+  void ReadSample(Tensor<CPUBackend>* tensor) override {}
+
+  std::function<void()> PrepareRead(Tensor<CPUBackend>* tensor) override {
+    auto reads = reads_;
+    auto tagged_reads = tagged_reads_;
+    MemoryTag *expected_tag = expected_tag_;
+    return [reads, tagged_reads, expected_tag]() {
+      ++*reads;
+      if (MemoryTag::Current() == expected_tag) ++*tagged_reads;
+    };
+  }
+
+  Index Size() override {
+    return 10;
+  }
+
+  MemoryTag *expected_tag_;
+  std::shared_ptr<std::atomic<int>> reads_;
+  std::shared_ptr<std::atomic<int>> tagged_reads_;
+};
+
+TYPED_TEST(DataLoadStoreTest, ReadsInFlightTagTest) {
+  // The reads in the background are accounted to the memory tag of the
+  // thread that starts them
+  auto tag = std::make_shared<MemoryTag>("reader");
+  std::unique_ptr<TagCountingLoader> loader(
+      new TagCountingLoader(
+          OpSpec("FileReader")
+          .AddArg("reads_in_flight", 4)
+          .AddArg("batch_size", 2),
+          tag.get()));
+  auto reads = loader->reads_;
+  auto tagged_reads = loader->tagged_reads_;
+  {
+    MemoryTagScope memory_scope(tag.get());
+    for (int i = 0; i < 8; ++i) {
+      loader->ReturnTensor(loader->ReadOne());
+    }
+  }
+  // waits for the reads still in flight
+  loader.reset();
+  ASSERT_GT(*reads, 0);
+  ASSERT_EQ(*tagged_reads, *reads);
+}
+
+TYPED_TEST(DataLoadStoreTest, GlobalShuffleTest) {
+  char root[] = "/tmp/dali_loader_test_XXXXXX";
+  const vector<string> files = WriteClassDirs(root);
+  const int num_shards = 3;
+
+  // The samples each shard reads in the first 2 epochs
+  vector<string> epochs[2];
+  for (int shard_id = 0; shard_id < num_shards; ++shard_id) {
+    const int shard_size = start_index(shard_id + 1, num_shards, files.size()) -
+                           start_index(shard_id, num_shards, files.size());
+    vector<string> samples[2];
+    for (int reads : {1, 4}) {
+      std::unique_ptr<FileLoader> loader(
+          new FileLoader(
+              OpSpec("FileReader")
+              .AddArg("file_root", string(root))
+              .AddArg("global_shuffle", true)
+              .AddArg("shard_id", shard_id)
+              .AddArg("num_shards", num_shards)
+              .AddArg("reads_in_flight", reads)
+              .AddArg("batch_size", 2)));
+      for (int i = 0; i < 2 * shard_size; ++i) {
+        auto* sample = loader->ReadOne();
+        samples[reads > 1].push_back(sample->GetSourceInfo());
+        loader->ReturnTensor(sample);
+      }
+    }
+    ASSERT_EQ(samples[0], samples[1]);
+    for (int epoch = 0; epoch < 2; ++epoch) {
+      epochs[epoch].insert(epochs[epoch].end(), samples[0].begin() + epoch * shard_size,
+                           samples[0].begin() + (epoch + 1) * shard_size);
+    }
+  }
+
+  // Every epoch, the shards read all the samples once, in a new order
+  vector<string> first_epoch = epochs[0];
+  ASSERT_NE(epochs[0], epochs[1]);
+  for (auto &epoch : epochs) {
+    std::sort(epoch.begin(), epoch.end());
+    ASSERT_EQ(std::unique(epoch.begin(), epoch.end()), epoch.end());
+    ASSERT_EQ(epoch.size(), files.size());
+  }
+
+  // The permutations are drawn from shuffle_seed
+  const int shard_size = start_index(1, num_shards, files.size());
+  for (int shuffle_seed : {kShardShuffleSeed, 42}) {
+    std::unique_ptr<FileLoader> loader(
+        new FileLoader(
+            OpSpec("FileReader")
+            .AddArg("file_root", string(root))
+            .AddArg("global_shuffle", true)
+            .AddArg("shuffle_seed", shuffle_seed)
+            .AddArg("num_shards", num_shards)
+            .AddArg("batch_size", 2)));
+    vector<string> samples;
+    for (int i = 0; i < shard_size; ++i) {
+      auto* sample = loader->ReadOne();
+      samples.push_back(sample->GetSourceInfo());
+      loader->ReturnTensor(sample);
+    }
+    vector<string> expected(first_epoch.begin(), first_epoch.begin() + shard_size);
+    if (shuffle_seed == kShardShuffleSeed) {
+      ASSERT_EQ(samples, expected);
+    } else {
+      ASSERT_NE(samples, expected);
+    }
+  }
+
+  RemoveClassDirs(root, files);
+}
+
+TYPED_TEST(DataLoadStoreTest, ShuffledIndexTest) {
+  for (Index size : {1, 2, 3, 5, 16, 17, 1000}) {
+    vector<Index> order[2];
+    for (uint64_t key : {0, 1}) {
+      for (Index i = 0; i < size; ++i) {
+        order[key].push_back(shuffled_index(i, size, key));
+      }
+      // A permutation of [0, size)
+      vector<Index> sorted = order[key];
+      std::sort(sorted.begin(), sorted.end());
+      for (Index i = 0; i < size; ++i) {
+        ASSERT_EQ(sorted[i], i);
+      }
+    }
+    if (size >= 16) {
+      ASSERT_NE(order[0], order[1]);
+    }
+  }
+}
+
 #if 0
 TYPED_TEST(DataLoadStoreTest, CachedLMDBTest) {
   shared_ptr<dali::LMDBReader> reader(
@@ -38,7 +38,7 @@ class RecordIOLoader : public IndexedFileLoader {
     std::vector<size_t> file_offsets;
     file_offsets.push_back(0);
     for (std::string& path : uris_) {
-      FileStream * tmp = FileStream::Open(path);
+      std::unique_ptr<FileStream> tmp(FileStream::Open(path));
       file_offsets.push_back(tmp->Size() + file_offsets.back());
       tmp->Close();
     }
@@ -55,42 +55,50 @@ class RecordIOLoader : public IndexedFileLoader {
     }
     std::sort(temp.begin(), temp.end());
     size_t file_offset_index = 0;
-    for (size_t i = 0; i < temp.size() - 1; ++i) {
-      if (temp[i] >= file_offsets[file_offset_index + 1]) {
+    for (size_t i = 0; i < temp.size(); ++i) {
+      // the file the record starts in, which global_shuffle seeks into
+      while (file_offset_index + 1 < uris_.size() &&
+             temp[i] >= file_offsets[file_offset_index + 1]) {
         ++file_offset_index;
       }
+      const size_t end = i + 1 < temp.size() ? temp[i + 1] : file_offsets.back();
       indices_.push_back(std::make_tuple(temp[i] - file_offsets[file_offset_index],
-                                         temp[i + 1] - temp[i],
+                                         end - temp[i],
                                          file_offset_index));
     }
-    indices_.push_back(std::make_tuple(temp.back() - file_offsets[file_offset_index],
-                                       file_offsets.back() - temp.back(),
-                                       file_offset_index));
     index_file.close();
   }
 
   void ReadSample(Tensor<CPUBackend>* tensor) override {
-    if (current_index_ == static_cast<size_t>(Size())) {
+    if (global_shuffle_) {
+      MoveTo(NextShuffledIndex());
+    } else if (current_index_ == static_cast<size_t>(Size())) {
       current_index_ = 0;
       current_file_index_ = 0;
-      current_file_.reset(FileStream::Open(uris_[current_file_index_]));
+      current_file_.reset(FileStream::Open(uris_[current_file_index_], use_mmap_));
     }
 
     int64 seek_pos, size;
     size_t file_index;
     std::tie(seek_pos, size, file_index) = indices_[current_index_];
 
+    tensor->SetSourceInfo(SourceInfo(sources_[current_file_index_], seek_pos));
+    // Records split across two files are read
+    if (ShareSample(tensor, size)) {
+      ++current_index_;
+      return;
+    }
+    tensor->UnshareData();
     tensor->Resize({size});
 
     int64 n_read = 0;
-    tensor->SetSourceInfo(uris_[current_file_index_] + " at index " + to_string(seek_pos));
     while (n_read < size) {
       n_read += current_file_->Read(tensor->mutable_data<uint8_t>() + n_read,
                      size - n_read);
       if (n_read < size) {
         DALI_ENFORCE(current_file_index_ + 1 < uris_.size(),
             "Incomplete or corrupted record files");
-        current_file_.reset(FileStream::Open(uris_[++current_file_index_]));
+        current_file_.reset(FileStream::Open(uris_[++current_file_index_], use_mmap_));
       }
     }
     ++current_index_;
@@ -15,6 +15,8 @@
 
 #include "dali/pipeline/operators/reader/mxnet_reader_op.h"
 
+#include <vector>
+
 namespace dali {
 
 DALI_REGISTER_OPERATOR(MXNetReader, MXNetReader, CPU);
@@ -23,6 +25,11 @@ DALI_SCHEMA(MXNetReader)
   .DocStr("Read sample data from a MXNet RecordIO")
   .NumInput(0)
   .NumOutput(2)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    (*outputs)[0] = SampleShape({SampleShape::kUnknownDim}, DALI_UINT8);
+    (*outputs)[1] = SampleShape({1}, DALI_FLOAT);
+  })
   .AddArg("path",
       R"code(List of paths to RecordIO files.)code",
       DALI_STRING_VEC)
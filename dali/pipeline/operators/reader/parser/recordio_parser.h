@@ -79,33 +79,47 @@ class RecordIOParser : public Parser {
       uint8_t* data = o_image->mutable_data<uint8_t>();
       memcpy(data, input, data_size);
     } else {
-      std::vector<uint8_t> temp_vec(data_size);
-      memcpy(&temp_vec[0], input, data_size);
-      input += data_size;
-
-      while (true) {
-        size_t pad = clength - (((clength + 3U) >> 2U) << 2U);
-        input += pad;
-
-        if (cflag != 3) {
-          size_t s = temp_vec.size();
-          temp_vec.resize(static_cast<int64_t>(s + sizeof(kMagic)));
-          memcpy(&temp_vec[s], &kMagic, sizeof(kMagic));
-        } else {
-          break;
-        }
-        ReadSingle(&input, &magic);
-        ReadSingle(&input, &length_flag);
-        cflag = DecodeFlag(length_flag);
-        clength = DecodeLength(length_flag);
-        size_t s = temp_vec.size();
-        temp_vec.resize(static_cast<int64_t>(s + clength));
-        memcpy(&temp_vec[s], input, clength);
-        input += clength;
-      }
-      o_image->Resize({static_cast<Index>(temp_vec.size())});
+      // The size of the image split into several parts is found
+      // first, so that they can be copied straight to the output
+      Index image_size = 0;
+      ForEachPart(input, data_size, cflag, clength, kMagic,
+          [&image_size](const uint8_t*, size_t part_size) {
+            image_size += part_size;
+          });
+      o_image->Resize({image_size});
       uint8_t* data = o_image->mutable_data<uint8_t>();
-      memcpy(data, &temp_vec[0], temp_vec.size());
+      ForEachPart(input, data_size, cflag, clength, kMagic,
+          [&data](const uint8_t* part, size_t part_size) {
+            memcpy(data, part, part_size);
+            data += part_size;
+          });
+    }
+  }
+
+  // Calls `part_fn` with each part of an image split into several
+  // records, and with the magic number that joins them
+  template <typename PartFn>
+  void ForEachPart(const uint8_t* input, int64_t data_size, uint32_t cflag,
+                   uint32_t clength, const uint32_t kMagic, PartFn part_fn) {
+    part_fn(input, data_size);
+    input += data_size;
+
+    while (true) {
+      size_t pad = clength - (((clength + 3U) >> 2U) << 2U);
+      input += pad;
+
+      if (cflag != 3) {
+        part_fn(reinterpret_cast<const uint8_t*>(&kMagic), sizeof(kMagic));
+      } else {
+        break;
+      }
+      uint32_t magic, length_flag;
+      ReadSingle(&input, &magic);
+      ReadSingle(&input, &length_flag);
+      cflag = DecodeFlag(length_flag);
+      clength = DecodeLength(length_flag);
+      part_fn(input, clength);
+      input += clength;
     }
   }
 };
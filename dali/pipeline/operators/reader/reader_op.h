@@ -16,11 +16,14 @@
 #define DALI_PIPELINE_OPERATORS_READER_READER_OP_H_
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "dali/pipeline/data/memory_tracker.h"
 #include "dali/pipeline/operators/reader/loader/loader.h"
 #include "dali/pipeline/operators/reader/parser/parser.h"
 #include "dali/pipeline/operators/operator.h"
@@ -30,22 +33,24 @@ namespace dali {
 /**
  * @brief BaseClass for operators that perform prefetching work
  *
- * Operator runs an additional prefetch thread
+ * Operator runs an additional prefetch thread, which reads up to
+ * `prefetch_queue_depth` batches ahead into a ring of batches
  */
 template <typename Backend>
 class DataReader : public Operator<Backend> {
  public:
   inline explicit DataReader(const OpSpec& spec) :
     Operator<Backend>(spec),
-  thread_locks_(Operator<Backend>::num_threads_),
-  condition_vars_(Operator<Backend>::num_threads_),
-  prefetch_ready_(false),
-  prefetch_ready_workers_(false),
-  prefetch_success_(true),
+  prefetch_queue_depth_(spec.GetArgument<int>("prefetch_queue_depth")),
+  prefetched_batch_queue_(prefetch_queue_depth_),
+  prefetch_errors_(prefetch_queue_depth_),
+  curr_batch_producer_(0),
+  curr_batch_consumer_(0),
+  num_ready_batches_(0),
+  consumer_batch_ready_(false),
   finished_(false),
-  samples_processed_(0),
-  batch_stop_(false) {
-    // TODO(slayton): Anything needed here?
+  samples_processed_(0) {
+    DALI_ENFORCE(prefetch_queue_depth_ > 0, "prefetch_queue_depth needs to be greater than 0");
   }
 
   virtual ~DataReader() noexcept {}
@@ -53,16 +58,14 @@ class DataReader : public Operator<Backend> {
   // perform the prefetching operation
   virtual bool Prefetch() {
     // first clear the batch
-    // TODO(slayton): exchange multiple batches
-    prefetched_batch_.clear();
+    auto &batch = prefetched_batch_queue_[curr_batch_producer_];
+    batch.clear();
 
     for (int i = 0; i < Operator<Backend>::batch_size_; ++i) {
       auto* t = loader_->ReadOne();
-      prefetched_batch_.push_back(t);
+      batch.push_back(t);
     }
 
-    // TODO(slayton): swap prefetched batches around
-
     return true;
   }
 
@@ -70,30 +73,34 @@ class DataReader : public Operator<Backend> {
   void PrefetchWorker() {
     std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
 
-    // if a result is already ready, wait until it's consumed
-    while (prefetch_ready_) {
-      producer_.wait(lock);
-    }
+    while (true) {
+      // wait for a free batch in the ring
+      producer_.wait(lock, [this] {
+        return finished_ || num_ready_batches_ < prefetch_queue_depth_;
+      });
+      if (finished_) break;
 
-    while (!finished_) {
+      // the batch is only read by the consumer once it is ready
+      lock.unlock();
+      string error;
       try {
-        prefetched_batch_.reserve(Operator<Backend>::batch_size_);
-        prefetch_success_ = Prefetch();
+        TimeRange tr("[DataReader] Prefetch", TimeRange::kViolet);
+        prefetched_batch_queue_[curr_batch_producer_].reserve(Operator<Backend>::batch_size_);
+        if (!Prefetch()) {
+          error = "Prefetch failed";
+        }
       } catch (const std::exception& e) {
-        printf("Prefetch Failed\n");
-        DALI_FAIL(e.what());
-        // notify of failure
-        prefetch_success_ = false;
+        error = e.what();
       }
-      // mark as ready
-      prefetch_ready_ = true;
-      // notify the consumer of a result ready to consume
-      consumer_.notify_all();
+      lock.lock();
 
-      // wait until the result is consumed
-      while (prefetch_ready_) {
-        producer_.wait(lock);
-      }
+      // mark as ready, and notify the consumer
+      prefetch_errors_[curr_batch_producer_] = error;
+      curr_batch_producer_ = (curr_batch_producer_ + 1) % prefetch_queue_depth_;
+      ++num_ready_batches_;
+      consumer_.notify_all();
+      // a failed prefetch is reported by the consumer, do not go on
+      if (!error.empty()) break;
     }
   }
 
@@ -102,8 +109,15 @@ class DataReader : public Operator<Backend> {
     {
       // if thread hasn't been started yet, start it
       if (!prefetch_thread_.get()) {
+        // The samples read ahead are accounted to this op
+        MemoryTag *current_tag = MemoryTag::Current();
+        std::shared_ptr<MemoryTag> tag =
+            current_tag ? current_tag->shared_from_this() : nullptr;
         prefetch_thread_.reset(
-            new std::thread([this] { this->PrefetchWorker(); }));
+            new std::thread([this, tag] {
+              MemoryTagScope memory_scope(tag.get());
+              this->PrefetchWorker();
+            }));
       }
     }
   }
@@ -113,12 +127,7 @@ class DataReader : public Operator<Backend> {
     if (prefetch_thread_.get()) {
       {
         std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
-
-        while (!prefetch_ready_) {
-          consumer_.wait(lock);
-        }
         finished_ = true;
-        prefetch_ready_ = false;
       }
       // notify the prefetcher to stop
       producer_.notify_one();
@@ -126,64 +135,32 @@ class DataReader : public Operator<Backend> {
       prefetch_thread_->join();
       prefetch_thread_.reset();
 
+      // give the batches that were not consumed back to the loader,
+      // which owns their tensors
+      for (int i = 0; i < num_ready_batches_; ++i) {
+        int batch_idx = (curr_batch_consumer_ + i) % prefetch_queue_depth_;
+        loader_->ReturnTensors(prefetched_batch_queue_[batch_idx]);
+        prefetched_batch_queue_[batch_idx].clear();
+      }
     } else {
       finished_ = true;
     }
   }
 
   void Run(SampleWorkspace* ws) override {
-    {
-      std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
-      StartPrefetchThread();
-
-      if (batch_stop_) batch_stop_ = false;
-    }
-
-    {
-      // block all other worker threads from taking the prefetch-controller lock
-      std::unique_lock<std::mutex> worker_lock(worker_mutex_);
-
-      if (!prefetch_ready_workers_) {
-        // grab the actual prefetching lock
-        std::unique_lock<std::mutex> prefetch_lock(prefetch_access_mutex_);
-
-        // Wait until prefetch is ready
-        while (!prefetch_ready_) {
-          consumer_.wait(prefetch_lock);
-          prefetch_ready_ = true;
-        }
-        // signal the other workers we're ready
-        prefetch_ready_workers_ = true;
-
-        // signal the prefetch thread to start again
-        prefetch_ready_ = true;
-        producer_.notify_one();
-      }
+    // Only the first worker of a batch waits for it, the others see
+    // it is ready without taking any lock
+    if (!consumer_batch_ready_.load(std::memory_order_acquire)) {
+      WaitForBatch();
     }
 
     // consume batch
     Operator<Backend>::Run(ws);
 
-    loader_->ReturnTensor(prefetched_batch_[ws->data_idx()]);
-
-    samples_processed_++;
-
-    // lock, check if batch is finished, notify
-    {
-      std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
-
-      // if we need to stop, stop.
-      if (batch_stop_) return;
-
-      // if we've consumed all samples in this batch, reset state and stop
-      if (samples_processed_.load() == Operator<Backend>::batch_size_) {
-        prefetch_ready_workers_ = false;
-        prefetch_ready_ = false;
-        producer_.notify_one();
-        samples_processed_ = 0;
-        batch_stop_ = true;
-      }
-      return;
+    // the last sample of the batch frees its place in the ring
+    if (samples_processed_.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+        Operator<Backend>::batch_size_) {
+      ReleaseBatch();
     }
   }
 
@@ -191,39 +168,88 @@ class DataReader : public Operator<Backend> {
     return loader_->Size();
   }
 
+  LatencyHistogram* prefetch_wait() override {
+    return &prefetch_wait_;
+  }
+
  protected:
+  // sample `idx` of the batch being consumed
+  Tensor<Backend>* GetSample(int idx) {
+    return prefetched_batch_queue_[curr_batch_consumer_][idx];
+  }
+
+  // Waits until the oldest batch of the ring is ready to be consumed
+  void WaitForBatch() {
+    // block all other worker threads from taking the prefetch-controller lock
+    std::unique_lock<std::mutex> worker_lock(worker_mutex_);
+    // another worker may have waited for the batch in the meantime
+    if (consumer_batch_ready_.load(std::memory_order_relaxed)) return;
+    // grab the actual prefetching lock
+    std::unique_lock<std::mutex> prefetch_lock(prefetch_access_mutex_);
+    StartPrefetchThread();
+
+    auto wait_start = std::chrono::steady_clock::now();
+    consumer_.wait(prefetch_lock, [this] { return num_ready_batches_ > 0; });
+    std::chrono::duration<double, std::micro> wait_time =
+        std::chrono::steady_clock::now() - wait_start;
+    prefetch_wait_.Record(wait_time.count());
+
+    const string &error = prefetch_errors_[curr_batch_consumer_];
+    DALI_ENFORCE(error.empty(), "Prefetch failed: " + error);
+    // signal the other workers we're ready
+    consumer_batch_ready_.store(true, std::memory_order_release);
+  }
+
+  // Gives the consumed batch back to the loader, and its place in the
+  // ring back to the producer. Called once all its samples are processed
+  void ReleaseBatch() {
+    auto &batch = prefetched_batch_queue_[curr_batch_consumer_];
+    loader_->ReturnTensors(batch);
+    batch.clear();
+
+    std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
+    curr_batch_consumer_ = (curr_batch_consumer_ + 1) % prefetch_queue_depth_;
+    --num_ready_batches_;
+    samples_processed_.store(0, std::memory_order_relaxed);
+    consumer_batch_ready_.store(false, std::memory_order_release);
+    producer_.notify_one();
+  }
+
   std::unique_ptr<std::thread> prefetch_thread_;
 
   // mutex to control access to the producer
   std::mutex prefetch_access_mutex_;
   std::mutex worker_mutex_;
-  std::vector<std::mutex> thread_locks_;
 
   // signals for producer and consumer
   std::condition_variable producer_, consumer_;
-  std::vector<std::condition_variable> condition_vars_;
-  std::condition_variable worker_threads_;
 
-  // signal that a complete batch has been prefetched
-  std::atomic<bool> prefetch_ready_;
-  std::atomic<bool> prefetch_ready_workers_;
-
-  // check if prefetching was successful
-  std::atomic<bool> prefetch_success_;
+  // ring of prefetched batches. The producer fills the batch at
+  // curr_batch_producer_, the consumer reads the one at
+  // curr_batch_consumer_, and num_ready_batches_ are filled
+  const int prefetch_queue_depth_;
+  std::vector<std::vector<Tensor<Backend>*>> prefetched_batch_queue_;
+  // errors of the prefetch of each batch of the ring
+  std::vector<string> prefetch_errors_;
+  int curr_batch_producer_;
+  int curr_batch_consumer_;
+  int num_ready_batches_;
+
+  // signal the other workers that the batch to consume is ready.
+  // Set by the worker that waited for the batch, with the batch and
+  // curr_batch_consumer_ visible to the workers that load it
+  std::atomic<bool> consumer_batch_ready_;
 
   // signal that the prefetch thread has finished
-  std::atomic<bool> finished_;
+  bool finished_;
 
-  // prefetched batch
-  std::vector<Tensor<Backend>*> prefetched_batch_;
+  // time spent by the workers waiting for each prefetched batch
+  LatencyHistogram prefetch_wait_;
 
   // keep track of how many samples have been processed
   // over all threads.
   std::atomic<int> samples_processed_;
 
-  // notify threads to stop processing
-  std::atomic<bool> batch_stop_;
-
   // Loader
   std::unique_ptr<Loader<Backend>> loader_;
 
@@ -239,7 +265,7 @@ class DataReader : public Operator<Backend> {
 #define USE_READER_OPERATOR_MEMBERS(Backend)         \
   using DataReader<Backend>::loader_;                \
   using DataReader<Backend>::parser_;                \
-  using DataReader<Backend>::prefetched_batch_;
+  using DataReader<Backend>::GetSample;
 
 };  // namespace dali
 
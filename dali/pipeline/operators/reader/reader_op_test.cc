@@ -14,6 +14,7 @@
 
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <string>
@@ -57,12 +58,13 @@ class DummyDataReader : public DataReader<CPUBackend> {
     DataReader<CPUBackend>::StopPrefetchThread();
   }
   /*
-  using DataReader<CPUBackend>::prefetched_batch_;
+  using DataReader<CPUBackend>::prefetched_batch_queue_;
+  using DataReader<CPUBackend>::curr_batch_producer_;
   bool Prefetch() override {
     for (int i = 0; i < Operator::batch_size_; ++i) {
       printf("new tensor %d\n", i);
       auto *t = loader_->ReadOne();
-      prefetched_batch_.push_back(t);
+      prefetched_batch_queue_[curr_batch_producer_].push_back(t);
     }
     return true;
   }
@@ -71,7 +73,7 @@ class DummyDataReader : public DataReader<CPUBackend> {
   void RunImpl(SampleWorkspace* ws, int idx) override {
     std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
-    ws->Output<CPUBackend>(0)->Copy(*prefetched_batch_[ws->data_idx()], 0);
+    ws->Output<CPUBackend>(0)->Copy(*GetSample(ws->data_idx()), 0);
   }
 
  private:
@@ -87,6 +89,51 @@ DALI_SCHEMA(DummyDataReader)
   .NumOutput(1)
   .AddParent("LoaderBase");
 
+// Number of samples read by the last CountingLoader
+static std::atomic<int> samples_read(0);
+
+// Numbers the samples in the order they are read
+class CountingLoader : public Loader<CPUBackend> {
+ public:
+  explicit CountingLoader(const OpSpec& spec) :
+    Loader<CPUBackend>(spec) {
+    samples_read = 0;
+  }
+
+  void ReadSample(Tensor<CPUBackend> *t) override {
+    t->Resize({1});
+    t->mutable_data<int>()[0] = samples_read++;
+  }
+
+  Index Size() override {
+    return 1 << 20;
+  }
+};
+
+class CountingDataReader : public DataReader<CPUBackend> {
+ public:
+  explicit CountingDataReader(const OpSpec &spec)
+      : DataReader<CPUBackend>(spec) {
+    loader_.reset(new CountingLoader(spec));
+  }
+
+  ~CountingDataReader() {
+    DataReader<CPUBackend>::StopPrefetchThread();
+  }
+
+  void RunImpl(SampleWorkspace* ws, int idx) override {
+    ws->Output<CPUBackend>(0)->Copy(*GetSample(ws->data_idx()), 0);
+  }
+};
+
+DALI_REGISTER_OPERATOR(CountingDataReader, CountingDataReader, CPU);
+
+DALI_SCHEMA(CountingDataReader)
+  .DocStr("Dummy")
+  .NumInput(0)
+  .NumOutput(1)
+  .AddParent("LoaderBase");
+
 template <typename Backend>
 class ReaderTest : public DALITest {
  public:
@@ -119,4 +166,40 @@ TYPED_TEST(ReaderTest, SimpleTest) {
   return;
 }
 
+TYPED_TEST(ReaderTest, PrefetchQueueTest) {
+  const int batch_size = 4;
+  for (int depth : {1, 3}) {
+    Pipeline pipe(batch_size, 2, CPU_ONLY_DEVICE_ID);
+
+    pipe.AddOperator(
+        OpSpec("CountingDataReader")
+        .AddArg("prefetch_queue_depth", depth)
+        .AddOutput("data_out", "cpu"));
+
+    std::vector<std::pair<string, string>> outputs = {{"data_out", "cpu"}};
+    pipe.Build(outputs);
+
+    DeviceWorkspace ws;
+    for (int i = 0; i < 5; ++i) {
+      pipe.RunCPU();
+      pipe.RunGPU();
+      pipe.Outputs(&ws);
+
+      // The batches come in order, however many are prefetched
+      auto *data = ws.Output<CPUBackend>(0);
+      for (int j = 0; j < batch_size; ++j) {
+        ASSERT_EQ(data->tensor<int>(j)[0], i * batch_size + j);
+      }
+
+      // The reader fills the ring while the batches are consumed: with the
+      // sample buffer, one sample more than the prefetched ones is read
+      const int expected = (i + 1 + depth) * batch_size + 1;
+      for (int k = 0; k < 1000 && samples_read < expected; ++k) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      ASSERT_EQ(samples_read, expected);
+    }
+  }
+}
+
 };  // namespace dali
@@ -36,7 +36,7 @@ class TFRecordReader : public DataReader<CPUBackend> {
   void RunImpl(SampleWorkspace* ws, const int i) override {
     const int idx = ws->data_idx();
 
-    auto* raw_data = prefetched_batch_[idx];
+    auto* raw_data = GetSample(idx);
 
     parser_->Parse(raw_data->data<uint8_t>(), raw_data->size(), ws);
 
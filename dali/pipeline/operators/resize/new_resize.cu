@@ -58,7 +58,7 @@ void DataDependentSetupCPU(const Tensor<CPUBackend> &input,
   DALI_ENFORCE(input.ndim() == 3);
   DALI_ENFORCE(IsType<uint8>(input.type()), "Expects input data in uint8.");
 
-  const vector<Index> &shape = input.shape();
+  const auto &shape = input.shape();
   const int C = shape[2];
   DALI_ENFORCE(C == 1 || C == 3,
                string(pOpName ? pOpName : "Operation") +
@@ -44,7 +44,18 @@ Before resizing, the cropped image's area will be equal to `A` * original image'
   .AddOptionalArg("num_attempts",
       R"code(Maximum number of attempts used to choose random area and aspect ratio.)code",
       10)
-  .EnforceInputLayout(DALI_NHWC);
+  .EnforceInputLayout(DALI_NHWC)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    vector<int> size;
+    GetSingleOrRepeatedArg(spec, &size, "size", 2);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const Dims &shape = inputs[i].shape;
+      const Index C = shape.size() == 3 && !inputs[i].upper_bound ?
+          shape[2] : SampleShape::kUnknownDim;
+      (*outputs)[i] = SampleShape({size[0], size[1], C}, inputs[i].type);
+    }
+  });
 
 template<>
 struct RandomResizedCrop<CPUBackend>::Params {
@@ -119,7 +130,7 @@ void RandomResizedCrop<CPUBackend>::RunImpl(SampleWorkspace * ws, const int idx)
 template<>
 void RandomResizedCrop<CPUBackend>::SetupSharedSampleParams(SampleWorkspace *ws) {
   auto &input = ws->Input<CPUBackend>(0);
-  vector<Index> input_shape = input.shape();
+  const auto &input_shape = input.shape();
   DALI_ENFORCE(input_shape.size() == 3,
       "Expects 3-dimensional image input.");
 
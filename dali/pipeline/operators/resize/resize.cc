@@ -47,9 +47,31 @@ DALI_SCHEMA(Resize)
   .AllowMultipleInputSets()
   .AddOptionalArg("save_attrs",
       R"code(Save reshape attributes for testing.)code", false)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    // The sizes are the same for all the samples unless an argument is a tensor
+    for (const char *arg : {"resize_x", "resize_y", "resize_shorter"}) {
+      if (spec.HasTensorArgument(arg)) return;
+    }
+    // Both resize_x and resize_y give the size without the input image
+    const bool fixed = spec.HasArgument("resize_x") && spec.HasArgument("resize_y");
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const Dims &shape = inputs[i].shape;
+      const bool known = shape.size() == 3 && !inputs[i].upper_bound &&
+          shape[0] != SampleShape::kUnknownDim && shape[1] != SampleShape::kUnknownDim;
+      if (!fixed && !known) continue;
+      int H = 0, W = 0;
+      ResizeCropMirrorAttr::ResizedSize(spec, nullptr, 0, known ? shape[0] : 0,
+                                        known ? shape[1] : 0, &H, &W);
+      if (H <= 0 || W <= 0) continue;
+      const Index C = shape.size() == 3 && !inputs[i].upper_bound ?
+          shape[2] : SampleShape::kUnknownDim;
+      (*outputs)[i] = SampleShape({H, W, C}, inputs[i].type);
+    }
+  })
   .AddParent("ResizeAttr");
 
-void ResizeAttr::SetSize(DALISize *in_size, const vector<Index> &shape, int idx,
+void ResizeAttr::SetSize(DALISize *in_size, const Dims &shape, int idx,
                          DALISize *out_size, TransformMeta const *meta) const {
   in_size->height = shape[0];
   in_size->width = shape[1];
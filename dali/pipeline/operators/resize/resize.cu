@@ -112,7 +112,7 @@ void Resize<GPUBackend>::SetupSharedSampleParams(DeviceWorkspace* ws) {
   DALI_ENFORCE(IsType<uint8>(input.type()), "Expected input data as uint8.");
 
   for (int i = 0; i < batch_size_; ++i) {
-    vector<Index> input_shape = input.tensor_shape(i);
+    const auto &input_shape = input.tensor_shape(i);
     DALI_ENFORCE(input_shape.size() == 3, "Expects 3-dimensional image input.");
 
     per_sample_meta_[i] = GetTransformMeta(spec_, input_shape, ws, i, ResizeInfoNeeded());
@@ -55,7 +55,7 @@ class ResizeAttr : protected ResizeCropMirrorAttr {
  public:
   explicit inline ResizeAttr(const OpSpec &spec) : ResizeCropMirrorAttr(spec) {}
 
-  void SetSize(DALISize *in_size, const vector<Index> &shape, int idx,
+  void SetSize(DALISize *in_size, const Dims &shape, int idx,
                DALISize *out_size, TransformMeta const * meta = nullptr) const;
 
   inline vector<DALISize> &sizes(io_type type)            { return sizes_[type]; }
@@ -126,4 +126,39 @@ TYPED_TESTS(ResizeXY,         CUBIC, .AddArg("resize_x", 224.f)         \
 TYPED_TESTS(ResizeXY_A,       CUBIC, .AddArg("resize_x", 240.f)         \
                                      .AddArg("resize_y", 480.f))
 
+TEST(ResizeShapeTest, InferOutputShapes) {
+  const OpSchema &schema = SchemaRegistry::GetSchema("Resize");
+  vector<SampleShape> inputs = {
+    SampleShape({SampleShape::kUnknownDim, SampleShape::kUnknownDim, 3}, DALI_UINT8)};
+
+  // Sized like the op does it, which truncates the arguments
+  auto resize_xy = OpSpec("Resize")
+    .AddArg("resize_x", 224.7f)
+    .AddArg("resize_y", 100.2f)
+    .AddInput("images", "cpu")
+    .AddOutput("resized", "cpu");
+  auto outputs = schema.InferOutputShapes(resize_xy, inputs);
+  ASSERT_EQ(outputs[0].shape, Dims({100, 224, 3}));
+  ASSERT_EQ(outputs[0].type, DALI_UINT8);
+
+  // The other sizes depend on the size of the input images
+  auto resize_shorter = OpSpec("Resize")
+    .AddArg("resize_shorter", 256.f)
+    .AddInput("images", "cpu")
+    .AddOutput("resized", "cpu");
+  outputs = schema.InferOutputShapes(resize_shorter, inputs);
+  ASSERT_FALSE(outputs[0].IsKnown());
+
+  inputs[0].shape = {480, 640, 3};
+  outputs = schema.InferOutputShapes(resize_shorter, inputs);
+  ASSERT_EQ(outputs[0].shape, Dims({256, 341, 3}));
+
+  auto resize_x = OpSpec("Resize")
+    .AddArg("resize_x", 320.f)
+    .AddInput("images", "cpu")
+    .AddOutput("resized", "cpu");
+  outputs = schema.InferOutputShapes(resize_x, inputs);
+  ASSERT_EQ(outputs[0].shape, Dims({240, 320, 3}));
+}
+
 }  // namespace dali
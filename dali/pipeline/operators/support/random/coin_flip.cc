@@ -14,6 +14,7 @@
 
 
 #include "dali/pipeline/operators/support/random/coin_flip.h"
+#include "dali/pipeline/util/philox.h"
 
 namespace dali {
 
@@ -24,9 +25,8 @@ void CoinFlip::RunImpl(SupportWorkspace * ws, const int idx) {
 
   int * out_data = output->template mutable_data<int>();
 
-  for (int i = 0; i < batch_size_; ++i) {
-    out_data[i] = dis_(rng_) ? 1 : 0;
-  }
+  Philox rng(seed_, ws->iteration(), 0);
+  rng.GenerateBernoulli(out_data, batch_size_, probability_);
 }
 
 DALI_REGISTER_OPERATOR(CoinFlip, CoinFlip, Support);
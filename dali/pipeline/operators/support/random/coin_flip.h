@@ -15,8 +15,6 @@
 #ifndef DALI_PIPELINE_OPERATORS_SUPPORT_RANDOM_COIN_FLIP_H_
 #define DALI_PIPELINE_OPERATORS_SUPPORT_RANDOM_COIN_FLIP_H_
 
-#include <random>
-
 #include "dali/pipeline/operators/operator.h"
 
 namespace dali {
@@ -25,8 +23,8 @@ class CoinFlip : public Operator<SupportBackend> {
  public:
   inline explicit CoinFlip(const OpSpec &spec) :
     Operator<SupportBackend>(spec),
-    dis_(spec.GetArgument<float>("probability")),
-    rng_(spec.GetArgument<int>("seed")) {}
+    probability_(spec.GetArgument<float>("probability")),
+    seed_(spec.GetArgument<int>("seed")) {}
 
   virtual inline ~CoinFlip() = default;
 
@@ -38,8 +36,8 @@ class CoinFlip : public Operator<SupportBackend> {
   void RunImpl(Workspace<SupportBackend> * ws, const int idx) override;
 
  private:
-  std::bernoulli_distribution dis_;
-  std::mt19937 rng_;
+  float probability_;
+  int seed_;
 };
 
 }  // namespace dali
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "dali/pipeline/operators/support/random/uniform.h"
+#include "dali/pipeline/util/philox.h"
 
 namespace dali {
 
@@ -26,9 +27,8 @@ void Uniform::RunImpl(SupportWorkspace * ws, const int idx) {
 
   float * out_data = output->template mutable_data<float>();
 
-  for (int i = 0; i < batch_size_; ++i) {
-    out_data[i] = dis_(rng_);
-  }
+  Philox rng(seed_, ws->iteration(), 0);
+  rng.GenerateUniform(out_data, batch_size_, range_[0], range_[1]);
 }
 
 DALI_REGISTER_OPERATOR(Uniform, Uniform, Support);
@@ -15,7 +15,6 @@
 #ifndef DALI_PIPELINE_OPERATORS_SUPPORT_RANDOM_UNIFORM_H_
 #define DALI_PIPELINE_OPERATORS_SUPPORT_RANDOM_UNIFORM_H_
 
-#include <random>
 #include <vector>
 
 #include "dali/pipeline/operators/operator.h"
@@ -27,10 +26,8 @@ class Uniform : public Operator<SupportBackend> {
  public:
   inline explicit Uniform(const OpSpec &spec) :
     Operator<SupportBackend>(spec),
-    rng_(spec.GetArgument<int>("seed")) {
-    std::vector<float> range;
-    GetSingleOrRepeatedArg(spec, &range, "range", 2);
-    dis_ = std::uniform_real_distribution<float>(range[0], range[1]);
+    seed_(spec.GetArgument<int>("seed")) {
+    GetSingleOrRepeatedArg(spec, &range_, "range", 2);
   }
 
   virtual inline ~Uniform() = default;
@@ -43,8 +40,8 @@ class Uniform : public Operator<SupportBackend> {
   void RunImpl(Workspace<SupportBackend> * ws, const int idx) override;
 
  private:
-  std::uniform_real_distribution<float> dis_;
-  std::mt19937 rng_;
+  std::vector<float> range_;
+  int seed_;
 };
 
 }  // namespace dali
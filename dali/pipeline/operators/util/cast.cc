@@ -15,6 +15,9 @@
 
 #include "dali/pipeline/operators/util/cast.h"
 
+#include <cstring>
+#include <vector>
+
 namespace dali {
 
 template<>
@@ -23,6 +26,19 @@ void Cast<CPUBackend>::RunImpl(SampleWorkspace *ws, int idx) {
   auto *output = ws->Output<CPUBackend>(idx);
 
   DALIDataType itype = input.type().id();
+  const Index size = input.size();
+
+  // When run in place, the input is converted element by element
+  // in its own buffer. A wider output type does not fit there, so
+  // the input is copied aside to the scratch memory first.
+  size_t output_type_size = 0;
+  DALI_TYPE_SWITCH(output_type_, OType, output_type_size = sizeof(OType););
+  const void *in_data = input.raw_data();
+  if (output == &input && output_type_size > input.type().size()) {
+    void *in_copy = ws->scratch().Allocate(input.nbytes());
+    std::memcpy(in_copy, in_data, input.nbytes());
+    in_data = in_copy;
+  }
 
   DALI_TYPE_SWITCH(output_type_, OType,
       output->mutable_data<OType>();
@@ -30,8 +46,8 @@ void Cast<CPUBackend>::RunImpl(SampleWorkspace *ws, int idx) {
       DALI_TYPE_SWITCH(itype, IType,
         CPUHelper<IType, OType>(
           output->mutable_data<OType>(),
-          input.data<IType>(),
-          input.size());););
+          static_cast<const IType*>(in_data),
+          size);););
 }
 
 DALI_REGISTER_OPERATOR(Cast, Cast<CPUBackend>, CPU);
@@ -41,6 +57,14 @@ DALI_SCHEMA(Cast)
   .NumInput(1)
   .NumOutput(1)
   .AllowMultipleInputSets()
+  .AllowInPlace()
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      (*outputs)[i] = inputs[i];
+      (*outputs)[i].type = spec.GetArgument<DALIDataType>("dtype");
+    }
+  })
   .AddArg("dtype",
       R"code(Output data type.)code",
       DALI_DATA_TYPE);
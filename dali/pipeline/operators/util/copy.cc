@@ -14,6 +14,8 @@
 
 #include "dali/pipeline/operators/util/copy.h"
 
+#include <vector>
+
 namespace dali {
 
 template<>
@@ -22,11 +24,7 @@ void Copy<CPUBackend>::RunImpl(SampleWorkspace *ws, const int idx) {
   auto output = ws->Output<CPUBackend>(idx);
   output->set_type(input.type());
   output->ResizeLike(input);
-
-  TypeInfo type = input.type();
-  type.Copy<CPUBackend, CPUBackend>(
-      output->raw_mutable_data(),
-      input.raw_data(), input.size(), 0);
+  input.CopyDenseTo(output->raw_mutable_data());
 }
 
 DALI_REGISTER_OPERATOR(Copy, Copy<CPUBackend>, CPU);
@@ -34,6 +32,11 @@ DALI_REGISTER_OPERATOR(Copy, Copy<CPUBackend>, CPU);
 DALI_SCHEMA(Copy)
   .DocStr("Make a copy of the input tensor")
   .NumInput(1)
-  .NumOutput(1);
+  .NumOutput(1)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    *outputs = inputs;
+  })
+  .AcceptStridedInputs();
 
 }  // namespace dali
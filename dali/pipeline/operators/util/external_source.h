@@ -36,8 +36,17 @@ class ExternalSource : public Operator<Backend> {
   inline explicit ExternalSource(const OpSpec &spec) :
     Operator<Backend>(spec),
     samples_processed_(0),
-    busy_(false) {
+    busy_(false),
+    pinned_(!spec.HasArgument("device_id") ||
+            spec.GetArgument<int>("device_id") != CPU_ONLY_DEVICE_ID) {
     output_name_ = spec.Output(0);
+    tl_data_.set_pinned(pinned_);
+    // The data is copied in by the threads of the user, so the
+    // copies take the tag of the op explicitly
+    MemoryTag *tag = MemoryTag::Current();
+    if (tag != nullptr) {
+      tl_data_.set_memory_tag(tag->shared_from_this());
+    }
   }
 
   inline ~ExternalSource() = default;
@@ -73,6 +82,11 @@ class ExternalSource : public Operator<Backend> {
     std::unique_lock<std::mutex> lock(m_);
     cv_.wait(lock,  [this]{return !this->busy_;});
 
+    for (size_t i = t_data_.size(); i < t.size(); ++i) {
+      t_data_.emplace_back();
+      t_data_.back().set_pinned(pinned_);
+      t_data_.back().set_memory_tag(tl_data_.memory_tag());
+    }
     t_data_.resize(t.size());
     for (size_t i = 0; i < t.size(); ++i) {
       t_data_[i].Copy(t[i], 0);
@@ -94,6 +108,8 @@ class ExternalSource : public Operator<Backend> {
   std::atomic<int> samples_processed_;
 
   bool busy_;
+  // Staging buffers are not pinned in CPU-only pipelines
+  const bool pinned_;
   std::condition_variable cv_;
   std::mutex m_;
   std::mutex samples_processed_m_;
@@ -21,6 +21,11 @@ DALI_REGISTER_OPERATOR(MakeContiguous, MakeContiguous, Mixed);
 DALI_SCHEMA(MakeContiguous)
   .DocStr(R"code(Move input batch to a contiguous representation, more suitable for execution on the GPU)code")
   .NumInput(1)
-  .NumOutput(1);
+  .NumOutput(1)
+  .OutputShapeFn([](const OpSpec &spec, const vector<SampleShape> &inputs,
+                    vector<SampleShape> *outputs) {
+    *outputs = inputs;
+  })
+  .AcceptStridedInputs();
 
 }  // namespace dali
@@ -15,6 +15,7 @@
 #ifndef DALI_PIPELINE_OPERATORS_UTIL_MAKE_CONTIGUOUS_H_
 #define DALI_PIPELINE_OPERATORS_UTIL_MAKE_CONTIGUOUS_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "dali/pipeline/operators/operator.h"
@@ -25,11 +26,61 @@
 
 namespace dali {
 
+/**
+ * @brief Copies the samples returned by `sample(i)` into the contiguous
+ * `output`. The samples that the ops already wrote into their slot of
+ * `output` (see Executor::SetDirectOutputsForIter) are not copied.
+ */
+template <typename SampleFn>
+void GatherSamples(int batch_size, SampleFn sample, TensorList<CPUBackend> *output) {
+  vector<Dims> shape(batch_size);
+  const TypeInfo &type = sample(0).type();
+  bool laid_out = output->ntensor() == batch_size && output->type() == type;
+  // Whether some samples were written into `output`
+  bool aliased = false;
+  uintptr_t begin = 0, end = 0;
+  if (IsValidType(output->type())) {
+    begin = reinterpret_cast<uintptr_t>(output->raw_data());
+    end = begin + output->nbytes();
+  }
+  for (int i = 0; i < batch_size; ++i) {
+    const Tensor<CPUBackend> &input = sample(i);
+    DALI_ENFORCE(type == input.type(), "Inconsistent types in "
+        "input batch. Cannot copy to contiguous buffer.");
+    shape[i] = input.shape();
+    laid_out = laid_out && output->tensor_shape(i) == shape[i];
+    const uintptr_t ptr = reinterpret_cast<uintptr_t>(input.raw_data());
+    aliased = aliased || (ptr >= begin && ptr < end);
+  }
+
+  if (!laid_out) {
+    if (aliased) {
+      // The samples written into `output` with other shapes than
+      // planned must be moved out before it is laid out again
+      TensorList<CPUBackend> tmp;
+      tmp.set_pinned(false);
+      GatherSamples(batch_size, sample, &tmp);
+      output->Copy(tmp, 0);
+      return;
+    }
+    output->Resize(shape);
+    output->set_type(type);
+  }
+
+  for (int i = 0; i < batch_size; ++i) {
+    const Tensor<CPUBackend> &input = sample(i);
+    if (input.raw_data() != output->raw_tensor(i)) {
+      input.CopyDenseTo(output->raw_mutable_tensor(i));
+    }
+  }
+}
+
 class MakeContiguous : public Operator<MixedBackend> {
  public:
   inline explicit MakeContiguous(const OpSpec &spec) :
     Operator<MixedBackend>(spec),
-    coalesced(true)
+    coalesced(true),
+    strided(false)
     {}
 
   virtual inline ~MakeContiguous() = default;
@@ -43,36 +94,29 @@ class MakeContiguous : public Operator<MixedBackend> {
       output_shape[i] = input.shape();
       if (coalesced && input.nbytes() > COALESCE_TRESHOLD)
         coalesced = false;
+      // Views are gathered densely on the host first
+      if (!input.IsDense())
+        strided = true;
       DALI_ENFORCE(type == input.type(), "Inconsistent types in "
           "input batch. Cannot copy to contiguous device buffer.");
     }
 
     if (ws->OutputIsType<CPUBackend>(0)) {
-      auto output = ws->Output<CPUBackend>(0);
-      output->Resize(output_shape);
-      output->set_type(type);
-
-      for (int i = 0; i < batch_size_; ++i) {
-        auto &input = ws->Input<CPUBackend>(0, i);
-
-        // Note: We know that this will translate into
-        // a std::memcpy, so it is safe to pass stream 0
-        type.Copy<CPUBackend, CPUBackend>(
-            output->raw_mutable_tensor(i),
-            input.raw_data(), input.size(), 0);
-      }
+      GatherSamples(batch_size_, [ws](int i) -> const Tensor<CPUBackend>& {
+            return ws->Input<CPUBackend>(0, i);
+          }, ws->Output<CPUBackend>(0));
     } else {
       auto output = ws->Output<GPUBackend>(0);
       output->Resize(output_shape);
       output->set_type(type);
 
-      if (coalesced) {
+      if (coalesced || strided) {
         TimeRange tm("coalesced", TimeRange::kBlue);
         cpu_output_buff.ResizeLike(*output);
         cpu_output_buff.set_type(type);
         for (int i = 0; i < batch_size_; ++i) {
           auto &input = ws->Input<CPUBackend>(0, i);
-          memcpy(cpu_output_buff.raw_mutable_tensor(i), input.raw_data(), input.nbytes());
+          input.CopyDenseTo(cpu_output_buff.raw_mutable_tensor(i));
         }
         CUDA_CALL(cudaMemcpyAsync(
               output->raw_mutable_data(),
@@ -94,6 +138,7 @@ class MakeContiguous : public Operator<MixedBackend> {
       }
     }
     coalesced = true;
+    strided = false;
   }
 
   DISABLE_COPY_MOVE_ASSIGN(MakeContiguous);
@@ -102,6 +147,7 @@ class MakeContiguous : public Operator<MixedBackend> {
   USE_OPERATOR_MEMBERS();
   TensorList<CPUBackend> cpu_output_buff;
   bool coalesced;
+  bool strided;
 };
 
 }  // namespace dali
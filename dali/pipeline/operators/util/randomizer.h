@@ -30,12 +30,22 @@ class Randomizer {
 #endif
   int rand(int idx);
 
+  /**
+   * @brief Selects the stream of the sample. On the CPU, rand(idx)
+   * is a function of the seed, the stream and `idx`, so that it does
+   * not depend on the threads running the samples. No-op on the GPU.
+   */
+  void SetSample(int64 iteration, int sample);
+
   void Cleanup();
 
  private:
     void *states_;
     size_t len_;
     int device_;
+    int seed_;
+    int64 iteration_;
+    int sample_;
 };
 
 }  // namespace dali
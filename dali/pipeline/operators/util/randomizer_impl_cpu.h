@@ -16,16 +16,29 @@
 #define DALI_PIPELINE_OPERATORS_UTIL_RANDOMIZER_IMPL_CPU_H_
 
 #include "dali/pipeline/operators/util/randomizer.h"
+#include "dali/pipeline/util/philox.h"
 
 namespace dali {
 
 // CPU methods
 template <>
-Randomizer<CPUBackend>::Randomizer(int seed, size_t len) {}
+Randomizer<CPUBackend>::Randomizer(int seed, size_t len) :
+  states_(nullptr), len_(len), device_(-1), seed_(seed), iteration_(0), sample_(0) {}
 
 template <>
 int Randomizer<CPUBackend>::rand(int idx) {
-  return lrand48();
+  const Philox::Block block = Philox::Compute(
+      {static_cast<uint32_t>(idx), static_cast<uint32_t>(sample_),
+       static_cast<uint32_t>(iteration_), static_cast<uint32_t>(iteration_ >> 32)},
+      static_cast<uint32_t>(seed_), 0);
+  // Non-negative, like lrand48()
+  return block[0] >> 1;
+}
+
+template <>
+void Randomizer<CPUBackend>::SetSample(int64 iteration, int sample) {
+  iteration_ = iteration;
+  sample_ = sample;
 }
 
 template <>
@@ -47,6 +47,9 @@ int Randomizer<GPUBackend>::rand(int idx) {
   return curand(reinterpret_cast<curandState*>(states_) + idx);
 }
 
+template <>
+void Randomizer<GPUBackend>::SetSample(int64 iteration, int sample) {}
+
 template <>
 void Randomizer<GPUBackend>::Cleanup() {
   DeviceGuard g(device_);
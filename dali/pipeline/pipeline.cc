@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <set>
 
 #include "dali/pipeline/operators/argument.h"
 #include "dali/pipeline/util/device_guard.h"
@@ -119,6 +120,9 @@ void Pipeline::AddOperator(OpSpec spec, const std::string& inst_name) {
                device == "support", "Invalid "
       "device argument \"" + device + "\". Valid options are "
       "\"cpu\", \"gpu\", \"mixed\" or \"support\"");
+  DALI_ENFORCE(device_id_ != CPU_ONLY_DEVICE_ID || device == "cpu" || device == "support",
+      "CPU-only pipeline can only run \"cpu\" and \"support\" ops, \"" +
+      device + "\" op \"" + spec.name() + "\" is not allowed.");
 
   DeviceGuard g(device_id_);
 
@@ -240,7 +244,18 @@ void Pipeline::Build(vector<std::pair<string, string>> output_names) {
 
 
   // Creating the executor
-  if (pipelined_execution_ && async_execution_) {
+  if (device_id_ == CPU_ONLY_DEVICE_ID && async_execution_) {
+    executor_.reset(new AsyncCPUExecutor(
+            batch_size_, num_threads_,
+            bytes_per_sample_hint_, set_affinity_,
+            prefetch_queue_depth_));
+    executor_->Init();
+  } else if (device_id_ == CPU_ONLY_DEVICE_ID) {
+    executor_.reset(new CPUExecutor(
+            batch_size_, num_threads_,
+            bytes_per_sample_hint_, set_affinity_,
+            prefetch_queue_depth_));
+  } else if (pipelined_execution_ && async_execution_) {
     executor_.reset(new AsyncPipelinedExecutor(
             batch_size_, num_threads_,
             device_id_, bytes_per_sample_hint_,
@@ -259,13 +274,39 @@ void Pipeline::Build(vector<std::pair<string, string>> output_names) {
             device_id_, bytes_per_sample_hint_,
             set_affinity_, max_num_stream_, prefetch_queue_depth_));
   }
+  executor_->SetCPUExecutionMode(cpu_execution_mode_);
+  executor_->SetCPUSchedulingPolicy(cpu_scheduling_policy_);
+  executor_->SetBufferPolicy(buffer_policy_);
+  executor_->EnableStatistics(statistics_enabled_);
 
   // Creating the graph
+  // Outputs of the cpu ops that can be strided views of their inputs
+  std::set<string> strided_edges;
   for (auto& name_op_spec : op_specs_) {
     string& inst_name = name_op_spec.first;
     OpSpec op_spec = name_op_spec.second;
     PrepareOpSpec(&op_spec);
+    if (!executor_->AllowsStridedOutputs()) {
+      op_spec.AddArg("strided_outputs", false);
+    }
+    const OpSchema &schema = SchemaRegistry::GetSchema(op_spec.name());
+    if (!schema.AcceptsStridedInputs()) {
+      for (int i = 0; i < op_spec.NumRegularInput(); ++i) {
+        if (op_spec.InputDevice(i) == "cpu" && strided_edges.count(op_spec.InputName(i))) {
+          op_spec.mutable_input(i)->first = AddDenseCopy(op_spec.InputName(i));
+        }
+      }
+    }
+    // Buffers allocated by the constructors of the ops are accounted to them
+    MemoryTagScope memory_scope(executor_->GetMemoryTracker().Tag(inst_name).get());
     graph_.AddOp(op_spec, inst_name);
+
+    if (schema.ProducesStridedOutputs(op_spec) &&
+        op_spec.GetArgument<string>("device") == "cpu") {
+      for (int i = 0; i < op_spec.NumOutput(); ++i) {
+        strided_edges.insert(op_spec.OutputName(i));
+      }
+    }
   }
 
   // Validate the output tensors names
@@ -281,7 +322,10 @@ void Pipeline::Build(vector<std::pair<string, string>> output_names) {
       DALI_ENFORCE(it->second.has_cpu, "Requested cpu output '" +
           name + "' only exists on gpu.");
 
-      if (!it->second.has_contiguous) {
+      if (device_id_ == CPU_ONLY_DEVICE_ID) {
+        // The executor gathers the outputs of the cpu ops itself
+        outputs.push_back(name + "_" + device);
+      } else if (!it->second.has_contiguous) {
         // Add a make contiguous op to produce this output
         OpSpec spec =
           OpSpec("MakeContiguous")
@@ -297,6 +341,8 @@ void Pipeline::Build(vector<std::pair<string, string>> output_names) {
         outputs.push_back(name + "_" + device);
       }
     } else if (device == "gpu") {
+      DALI_ENFORCE(device_id_ != CPU_ONLY_DEVICE_ID, "Requested gpu output '" +
+          name + "' from a CPU-only pipeline.");
       if (!it->second.has_gpu) {
         DALI_ENFORCE(it->second.has_cpu, "Output '" + name +
             "' exists on neither cpu or gpu, internal error");
@@ -380,6 +426,23 @@ void Pipeline::ReleaseOutputs() {
     }
 }
 
+string Pipeline::AddDenseCopy(const string &name) {
+  // The copy is shared by all the ops reading the edge
+  const string dense_name = "dense_" + name;
+  if (graph_.TensorExists(dense_name + "_cpu")) return dense_name;
+
+  OpSpec spec =
+    OpSpec("Copy")
+    .AddArg("device", "cpu")
+    .AddInput(name, "cpu")
+    .AddOutput(dense_name, "cpu");
+  PrepareOpSpec(&spec);
+  const string op_name = "__Dense_" + name;
+  MemoryTagScope memory_scope(executor_->GetMemoryTracker().Tag(op_name).get());
+  graph_.AddOp(spec, op_name);
+  return dense_name;
+}
+
 void Pipeline::SetupCPUInput(std::map<string, EdgeMeta>::iterator it,
     int input_idx, OpSpec *spec) {
   if (!it->second.has_contiguous) {
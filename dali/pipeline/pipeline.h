@@ -27,6 +27,7 @@
 #include "dali/pipeline/executor/executor.h"
 #include "dali/pipeline/executor/pipelined_executor.h"
 #include "dali/pipeline/executor/async_pipelined_executor.h"
+#include "dali/pipeline/executor/cpu_executor.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
@@ -67,7 +68,10 @@ class DLL_PUBLIC Pipeline {
    *
    * @param batch_size the size of the batch that should be produced.
    * @param num_threads the number of threads to use in the prefetch stage.
-   * @param device_id id of the GPU to operate on.
+   * @param device_id id of the GPU to operate on, or CPU_ONLY_DEVICE_ID for
+   * a pipeline of cpu and support ops only that never uses the GPU. Such a
+   * pipeline runs with the CPUExecutor, or the AsyncCPUExecutor for
+   * asynchronous execution, and can only have cpu outputs.
    * @param whether to allocate the necessary buffers to pipeline execution
    * between the cpu and gpu portions of the graph. See PipelinedExecutor.
    * @param whether to use extra host-threads to enable asynchronous issue
@@ -245,6 +249,80 @@ class DLL_PUBLIC Pipeline {
    */
   DLL_PUBLIC void SaveGraphToDotFile(const std::string filename);
 
+  /**
+   * @brief Selects how the executor schedules the cpu ops over the
+   * samples of a batch. Must be called before "Build()".
+   * See CPUExecutionMode.
+   */
+  DLL_PUBLIC inline void SetCPUExecutionMode(CPUExecutionMode mode) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed");
+    cpu_execution_mode_ = mode;
+  }
+
+  /**
+   * @brief Selects the order the executor issues the samples of
+   * a batch in. Must be called before "Build()".
+   * See CPUSchedulingPolicy.
+   */
+  DLL_PUBLIC inline void SetCPUSchedulingPolicy(CPUSchedulingPolicy policy) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed");
+    cpu_scheduling_policy_ = policy;
+  }
+
+  /**
+   * @brief Sets the policy for the allocations of the buffers of the
+   * executor. Must be called before "Build()". See BufferPolicy.
+   */
+  DLL_PUBLIC inline void SetBufferPolicy(const BufferPolicy &policy) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed");
+    buffer_policy_ = policy;
+  }
+
+  /**
+   * @brief Enables or disables the collection of the execution
+   * statistics. Can be called at any time. See GetStatistics().
+   */
+  DLL_PUBLIC inline void EnableStatistics(bool enabled) {
+    statistics_enabled_ = enabled;
+    if (built_) executor_->EnableStatistics(enabled);
+  }
+
+  /**
+   * @brief Returns the execution statistics of the pipeline: run times
+   * and output sizes of each op, time waited for the output buffers and
+   * by the readers for their prefetch threads. They are collected only
+   * when enabled, since the last call to ResetStatistics().
+   */
+  DLL_PUBLIC inline ExecutorStatistics GetStatistics() const {
+    DALI_ENFORCE(built_, "\"Build()\" must be called prior to getting the statistics.");
+    return executor_->GetStatistics();
+  }
+
+  DLL_PUBLIC inline void ResetStatistics() {
+    DALI_ENFORCE(built_, "\"Build()\" must be called prior to resetting the statistics.");
+    executor_->ResetStatistics();
+  }
+
+  /**
+   * @brief Returns the memory held by the buffers of each op and of the
+   * executor queues, now and at the peak since Build() or the last call
+   * to ResetMemoryPeaks(). Buffers created by an op, including its
+   * scratch buffers and the samples its loader reads ahead, count
+   * towards the op.
+   */
+  DLL_PUBLIC inline vector<MemoryUsage> GetMemoryReport() const {
+    DALI_ENFORCE(built_, "\"Build()\" must be called prior to getting the memory report.");
+    return executor_->GetMemoryReport();
+  }
+
+  DLL_PUBLIC inline void ResetMemoryPeaks() {
+    DALI_ENFORCE(built_, "\"Build()\" must be called prior to resetting the memory peaks.");
+    executor_->ResetMemoryPeaks();
+  }
+
   /**
    * @brief Returns the batch size that will be produced by the pipeline.
    */
@@ -290,6 +368,9 @@ class DLL_PUBLIC Pipeline {
     this->set_affinity_ = set_affinity;
     this->max_num_stream_ = max_num_stream;
     this->prefetch_queue_depth_ = prefetch_queue_depth;
+    this->cpu_execution_mode_ = DALI_CPU_SAMPLE_MAJOR;
+    this->cpu_scheduling_policy_ = DALI_CPU_SCHEDULE_IN_ORDER;
+    this->statistics_enabled_ = false;
     DALI_ENFORCE(batch_size_ > 0, "Batch size must be greater than 0");
     seed_.resize(MAX_SEEDS);
     current_seed_ = 0;
@@ -319,6 +400,10 @@ class DLL_PUBLIC Pipeline {
 
   void SetupGPUInput(std::map<string, EdgeMeta>::iterator it);
 
+  // Adds a cpu op that copies the strided views of the edge
+  // into dense tensors, returns the name of its output
+  string AddDenseCopy(const string &name);
+
   inline EdgeMeta NewEdge(string device) {
     EdgeMeta edge;
     edge.has_cpu = false;
@@ -356,6 +441,10 @@ class DLL_PUBLIC Pipeline {
   int set_affinity_;
   int max_num_stream_;
   int prefetch_queue_depth_;
+  CPUExecutionMode cpu_execution_mode_;
+  BufferPolicy buffer_policy_;
+  CPUSchedulingPolicy cpu_scheduling_policy_;
+  bool statistics_enabled_;
 
   std::vector<int> seed_;
   int original_seed_;
@@ -17,6 +17,8 @@
 #include <cuda_runtime_api.h>
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 #include "dali/common.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/buffer.h"
@@ -241,6 +243,142 @@ TEST_F(PipelineTestOnce, TestTriggerCopyToDevice) {
   RunTestTrigger("gpu");
 }
 
+TEST_F(PipelineTestOnce, TestCPUOnlyConstraints) {
+  Pipeline pipe(1, 1, CPU_ONLY_DEVICE_ID);
+
+  pipe.AddExternalInput("data");
+
+  ASSERT_THROW(
+    pipe.AddOperator(
+      OpSpec("Copy")
+        .AddArg("device", "gpu")
+        .AddInput("data", "gpu")
+        .AddOutput("data_copy", "gpu")),
+    std::runtime_error);
+
+  ASSERT_THROW(
+    pipe.AddOperator(
+      OpSpec("MakeContiguous")
+        .AddArg("device", "mixed")
+        .AddInput("data", "cpu")
+        .AddOutput("data_copy", "cpu")),
+    std::runtime_error);
+
+  vector<std::pair<string, string>> outputs = {{"data", "gpu"}};
+  ASSERT_THROW(pipe.Build(outputs), std::runtime_error);
+}
+
+TEST_F(PipelineTestOnce, TestCPUOnlyPipeline) {
+  int batch_size = this->jpegs_.nImages();
+  Pipeline pipe(batch_size, 2, CPU_ONLY_DEVICE_ID);
+
+  TensorList<CPUBackend> data;
+  this->MakeJPEGBatch(&data, batch_size);
+  pipe.AddExternalInput("data");
+
+  pipe.AddOperator(
+    OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("data", "cpu")
+      .AddOutput("data_copy", "cpu"));
+
+  vector<std::pair<string, string>> outputs = {{"data_copy", "cpu"}};
+  pipe.Build(outputs);
+
+  // The outputs are gathered by the executor, not by MakeContiguous
+  OpGraph &graph = this->GetGraph(&pipe);
+  ASSERT_EQ(graph.NumCPUOp(), 2);
+  ASSERT_EQ(graph.NumMixedOp(), 0);
+  ASSERT_EQ(graph.NumGPUOp(), 0);
+
+  DeviceWorkspace ws;
+  for (int i = 0; i < 3; ++i) {
+    pipe.SetExternalInput("data", data);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+
+    ASSERT_EQ(ws.NumOutput(), 1);
+    ASSERT_TRUE(ws.OutputIsType<CPUBackend>(0));
+    const TensorList<CPUBackend> &out = *ws.Output<CPUBackend>(0);
+    ASSERT_EQ(out.ntensor(), batch_size);
+    for (int j = 0; j < batch_size; ++j) {
+      ASSERT_EQ(out.tensor_shape(j), data.tensor_shape(j));
+      ASSERT_EQ(std::memcmp(out.tensor<uint8>(j), data.tensor<uint8>(j),
+          Product(data.tensor_shape(j))), 0);
+    }
+  }
+}
+
+TEST_F(PipelineTestOnce, TestStridedViews) {
+  const int batch_size = 2;
+  Pipeline pipe(batch_size, 1, CPU_ONLY_DEVICE_ID);
+
+  TensorList<CPUBackend> data;
+  data.set_type(TypeInfo::Create<uint8>());
+  data.Resize(vector<Dims>(batch_size, {4, 5, 3}));
+  for (int j = 0; j < batch_size; ++j) {
+    for (int k = 0; k < 4 * 5 * 3; ++k) {
+      data.mutable_tensor<uint8>(j)[k] = j + k;
+    }
+  }
+  pipe.AddExternalInput("data");
+
+  // The crop at (1, 1) is a view of the image
+  pipe.AddOperator(
+    OpSpec("Crop")
+      .AddArg("device", "cpu")
+      .AddArg("crop", vector<int>{2, 3})
+      .AddInput("data", "cpu")
+      .AddOutput("crop", "cpu"));
+
+  // Copy reads the view, Cast needs a dense copy of it
+  pipe.AddOperator(
+    OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("crop", "cpu")
+      .AddOutput("crop_copy", "cpu"));
+
+  pipe.AddOperator(
+    OpSpec("Cast")
+      .AddArg("device", "cpu")
+      .AddArg("dtype", DALI_INT32)
+      .AddInput("crop", "cpu")
+      .AddOutput("crop_cast", "cpu"));
+
+  vector<std::pair<string, string>> outputs = {
+    {"crop", "cpu"}, {"crop_copy", "cpu"}, {"crop_cast", "cpu"}};
+  pipe.Build(outputs);
+
+  OpGraph &graph = this->GetGraph(&pipe);
+  ASSERT_EQ(graph.NumCPUOp(), 5);
+  ASSERT_EQ(graph.node("__Dense_crop").spec.name(), "Copy");
+  ASSERT_EQ(graph.node("__Dense_crop").spec.Output(0), "dense_crop_cpu");
+
+  DeviceWorkspace ws;
+  for (int i = 0; i < 2; ++i) {
+    pipe.SetExternalInput("data", data);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+
+    ASSERT_EQ(ws.NumOutput(), 3);
+    for (int j = 0; j < batch_size; ++j) {
+      for (int h = 0; h < 2; ++h) {
+        for (int w = 0; w < 3; ++w) {
+          for (int c = 0; c < 3; ++c) {
+            const int out_idx = (h * 3 + w) * 3 + c;
+            const int expected = j + ((h + 1) * 5 + w + 1) * 3 + c;
+            ASSERT_EQ(ws.Output<CPUBackend>(0)->tensor<uint8>(j)[out_idx], expected);
+            ASSERT_EQ(ws.Output<CPUBackend>(1)->tensor<uint8>(j)[out_idx], expected);
+            ASSERT_EQ(ws.Output<CPUBackend>(2)->tensor<int>(j)[out_idx], expected);
+          }
+        }
+      }
+    }
+  }
+}
+
 TYPED_TEST(PipelineTest, TestExternalSource) {
   int num_thread = TypeParam::nt;
   int batch_size = this->jpegs_.nImages();
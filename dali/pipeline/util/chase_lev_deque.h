@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_CHASE_LEV_DEQUE_H_
+#define DALI_PIPELINE_UTIL_CHASE_LEV_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/error_handling.h"
+
+namespace dali {
+
+/**
+ * @brief Lock-free work-stealing deque of pointers (Chase and Lev,
+ * "Dynamic Circular Work-Stealing Deque", with the memory orders of
+ * Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+ * Models").
+ *
+ * A single owner thread pushes and pops at the bottom, any number of
+ * thieves steal from the top. The owner only synchronizes with the
+ * thieves over the last element, with a CAS on the top, and the
+ * thieves race for an element with that same CAS. The deque grows when
+ * it is full. The arrays it outgrows are kept until it is destroyed,
+ * as thieves may still be reading them. The deque does not own the
+ * pointers it holds.
+ */
+template <typename T>
+class ChaseLevDeque {
+ public:
+  explicit ChaseLevDeque(int64_t capacity = 64) : top_(0), bottom_(0) {
+    DALI_ENFORCE(capacity > 0, "ChaseLevDeque capacity must be greater than 0");
+    int64_t size = 1;
+    while (size < capacity) size <<= 1;
+    arrays_.emplace_back(new Array(size));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(ChaseLevDeque);
+
+  // Owner only
+  void Push(T *item) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    Array *a = array_.load(std::memory_order_relaxed);
+    if (b - t >= a->size) {
+      a = Grow(a, t, b);
+    }
+    a->Put(b, item);
+    // publishes the item to the thieves that see the new bottom
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  // Owner only. Returns the last item pushed, or nullptr if the deque is
+  // empty or a thief took the last item
+  T *Pop() {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *a = array_.load(std::memory_order_relaxed);
+    // Reserves the bottom item before looking at the top: with the
+    // load of the top in Steal(), one of the two sees the other
+    bottom_.store(b, std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    if (t > b) {
+      // empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *item = a->Get(b);
+    if (t == b) {
+      // the last item, race the thieves for it
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // Any thread. Returns the first item pushed, or nullptr if the deque
+  // is empty or another thread took the item first
+  T *Steal() {
+    int64_t t = top_.load(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_seq_cst);
+    if (t >= b) return nullptr;
+    Array *a = array_.load(std::memory_order_acquire);
+    T *item = a->Get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  // Number of items, only exact when no other thread uses the deque
+  int64_t Size() const {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? b - t : 0;
+  }
+
+ private:
+  struct Array {
+    explicit Array(int64_t size) : size(size), items(new std::atomic<T*>[size]) {}
+
+    T *Get(int64_t i) const {
+      return items[i & (size - 1)].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t i, T *item) {
+      items[i & (size - 1)].store(item, std::memory_order_relaxed);
+    }
+
+    const int64_t size;
+    std::unique_ptr<std::atomic<T*>[]> items;
+  };
+
+  // Owner only, copies the items in [t, b) into an array twice the size
+  Array *Grow(Array *a, int64_t t, int64_t b) {
+    arrays_.emplace_back(new Array(2 * a->size));
+    Array *grown = arrays_.back().get();
+    for (int64_t i = t; i < b; ++i) {
+      grown->Put(i, a->Get(i));
+    }
+    array_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  std::atomic<int64_t> top_;
+  std::atomic<int64_t> bottom_;
+  std::atomic<Array*> array_;
+  // every array the deque used, the last one is array_
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_CHASE_LEV_DEQUE_H_
@@ -0,0 +1,90 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "dali/pipeline/util/chase_lev_deque.h"
+
+namespace dali {
+
+TEST(ChaseLevDequeTest, OwnerAndThief) {
+  vector<int> values(100);
+  // Starts small, so that it grows
+  ChaseLevDeque<int> deque(2);
+  ASSERT_EQ(deque.Pop(), nullptr);
+  ASSERT_EQ(deque.Steal(), nullptr);
+  for (auto &value : values) {
+    deque.Push(&value);
+  }
+  ASSERT_EQ(deque.Size(), 100);
+
+  // The owner pops the last pushed, the thieves steal the first
+  ASSERT_EQ(deque.Pop(), &values[99]);
+  ASSERT_EQ(deque.Steal(), &values[0]);
+  for (int i = 1; i < 50; ++i) {
+    ASSERT_EQ(deque.Steal(), &values[i]);
+  }
+  for (int i = 98; i >= 50; --i) {
+    ASSERT_EQ(deque.Pop(), &values[i]);
+  }
+  ASSERT_EQ(deque.Pop(), nullptr);
+  ASSERT_EQ(deque.Steal(), nullptr);
+  ASSERT_EQ(deque.Size(), 0);
+}
+
+TEST(ChaseLevDequeTest, ConcurrentSteals) {
+  // The owner pushes and pops while thieves steal, every item is taken
+  // exactly once
+  const int num_items = 100000;
+  const int num_thieves = 4;
+  vector<int> items(num_items, 0);
+  vector<std::atomic<int>> taken(num_items);
+  for (auto &t : taken) t = 0;
+  ChaseLevDeque<int> deque(4);
+  std::atomic<bool> done(false);
+
+  auto take = [&items, &taken] (int *item) {
+    ++taken[item - items.data()];
+  };
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < num_thieves; ++i) {
+    thieves.emplace_back([&deque, &done, &take] {
+        while (!done) {
+          if (int *item = deque.Steal()) take(item);
+        }
+        while (int *item = deque.Steal()) take(item);
+      });
+  }
+  for (int i = 0; i < num_items; ++i) {
+    deque.Push(&items[i]);
+    if (i % 3 == 0) {
+      if (int *item = deque.Pop()) take(item);
+    }
+  }
+  while (int *item = deque.Pop()) take(item);
+  done = true;
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+
+  for (int i = 0; i < num_items; ++i) {
+    ASSERT_EQ(taken[i], 1) << "Item " << i << " taken " << taken[i] << " times";
+  }
+}
+
+}  // namespace dali
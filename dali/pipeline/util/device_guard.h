@@ -24,11 +24,15 @@
  */
 class DeviceGuard {
  public:
-  explicit DeviceGuard(int new_device) {
+  explicit DeviceGuard(int new_device)
+    : original_device_(dali::CPU_ONLY_DEVICE_ID) {
+    // Nothing to switch for cpu-only pipelines
+    if (new_device == dali::CPU_ONLY_DEVICE_ID) return;
     CUDA_CALL(cudaGetDevice(&original_device_));
     CUDA_CALL(cudaSetDevice(new_device));
   }
   ~DeviceGuard() noexcept(false) {
+    if (original_device_ == dali::CPU_ONLY_DEVICE_ID) return;
     CUDA_CALL(cudaSetDevice(original_device_));
   }
  private:
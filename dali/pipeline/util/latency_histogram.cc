@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dali {
+
+constexpr double LatencyHistogram::kMinTimeUs;
+
+LatencyHistogram::LatencyHistogram() {
+  Reset();
+}
+
+void LatencyHistogram::Record(double time_us, int64 n) {
+  if (n <= 0) return;
+  time_us = std::max(time_us, 0.0);
+  int bucket = 0;
+  if (time_us > kMinTimeUs) {
+    bucket = std::min<int>(kNumBuckets - 1,
+        std::log2(time_us / kMinTimeUs) * kBucketsPerOctave);
+  }
+  buckets_[bucket].fetch_add(n, std::memory_order_relaxed);
+  count_.fetch_add(n, std::memory_order_relaxed);
+
+  const uint64_t time_ns = std::llround(time_us * 1000);
+  total_ns_.fetch_add(time_ns * n, std::memory_order_relaxed);
+  uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (time_ns > max_ns &&
+      !max_ns_.compare_exchange_weak(max_ns, time_ns, std::memory_order_relaxed)) {}
+}
+
+TimingStatistics LatencyHistogram::Summary() const {
+  TimingStatistics stats;
+  const uint64_t count = count_.load(std::memory_order_relaxed);
+  if (count == 0) return stats;
+  stats.count = count;
+  stats.total_us = total_ns_.load(std::memory_order_relaxed) / 1000.;
+  stats.max_us = max_ns_.load(std::memory_order_relaxed) / 1000.;
+  stats.p50_us = std::min(Percentile(0.5, count), stats.max_us);
+  stats.p90_us = std::min(Percentile(0.9, count), stats.max_us);
+  stats.p99_us = std::min(Percentile(0.99, count), stats.max_us);
+  return stats;
+}
+
+void LatencyHistogram::Reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  total_ns_.store(0, std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::Percentile(double p, uint64_t count) const {
+  // Buckets may be updated concurrently, in which case the
+  // total of the buckets can be off by the last few records
+  const uint64_t rank = std::max<uint64_t>(1, std::ceil(p * count));
+  uint64_t seen = 0;
+  int bucket = 0;
+  for (; bucket < kNumBuckets - 1; ++bucket) {
+    seen += buckets_[bucket].load(std::memory_order_relaxed);
+    if (seen >= rank) break;
+  }
+  // Geometric middle of the bucket
+  return kMinTimeUs * std::exp2((bucket + 0.5) / kBucketsPerOctave);
+}
+
+}  // namespace dali
@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_LATENCY_HISTOGRAM_H_
+#define DALI_PIPELINE_UTIL_LATENCY_HISTOGRAM_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "dali/common.h"
+
+namespace dali {
+
+/**
+ * @brief Summary of a set of measured times, in microseconds
+ */
+struct TimingStatistics {
+  int64 count = 0;
+  double total_us = 0;
+  double p50_us = 0;
+  double p90_us = 0;
+  double p99_us = 0;
+  double max_us = 0;
+};
+
+/**
+ * @brief Histogram of times with logarithmic buckets, 8 per octave, so
+ * the percentiles are known within 5%. Recording is lock-free and can
+ * be done from any number of threads.
+ */
+class DLL_PUBLIC LatencyHistogram {
+ public:
+  DLL_PUBLIC LatencyHistogram();
+
+  /**
+   * @brief Records a time, in microseconds, `n` times
+   */
+  DLL_PUBLIC void Record(double time_us, int64 n = 1);
+
+  DLL_PUBLIC TimingStatistics Summary() const;
+
+  DLL_PUBLIC void Reset();
+
+  DISABLE_COPY_MOVE_ASSIGN(LatencyHistogram);
+
+ private:
+  double Percentile(double p, uint64_t count) const;
+
+  static const int kBucketsPerOctave = 8;
+  static const int kNumBuckets = 40 * kBucketsPerOctave;
+  // Lower bound of the first bucket, smaller times are recorded in it
+  static constexpr double kMinTimeUs = 0.01;
+
+  std::atomic<uint64_t> buckets_[kNumBuckets];
+  std::atomic<uint64_t> count_;
+  // Times are accumulated in nanoseconds, to stay lock-free
+  std::atomic<uint64_t> total_ns_, max_ns_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "dali/pipeline/util/latency_histogram.h"
+
+namespace dali {
+
+TEST(LatencyHistogramTest, Empty) {
+  LatencyHistogram hist;
+  TimingStatistics stats = hist.Summary();
+  ASSERT_EQ(stats.count, 0);
+  ASSERT_EQ(stats.total_us, 0);
+  ASSERT_EQ(stats.p99_us, 0);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram hist;
+  for (int i = 1; i <= 1000; ++i) {
+    hist.Record(i);
+  }
+  TimingStatistics stats = hist.Summary();
+  ASSERT_EQ(stats.count, 1000);
+  ASSERT_NEAR(stats.total_us, 1000 * 1001 / 2, 1e-3);
+  ASSERT_NEAR(stats.max_us, 1000, 1e-3);
+  // Buckets are 2^(1/8) wide, about 9%
+  ASSERT_NEAR(stats.p50_us, 500, 500 * 0.05);
+  ASSERT_NEAR(stats.p90_us, 900, 900 * 0.05);
+  ASSERT_NEAR(stats.p99_us, 990, 990 * 0.05);
+
+  hist.Reset();
+  ASSERT_EQ(hist.Summary().count, 0);
+}
+
+TEST(LatencyHistogramTest, OutOfRange) {
+  LatencyHistogram hist;
+  hist.Record(0);
+  hist.Record(-1);
+  hist.Record(1e12);
+  TimingStatistics stats = hist.Summary();
+  ASSERT_EQ(stats.count, 3);
+  ASSERT_LE(stats.p50_us, 0.02);
+  ASSERT_NEAR(stats.max_us, 1e12, 1);
+  ASSERT_LE(stats.p99_us, stats.max_us);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecords) {
+  LatencyHistogram hist;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&hist, t] {
+        for (int i = 0; i < 10000; ++i) {
+          hist.Record(t + 1, 2);
+        }
+      });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  TimingStatistics stats = hist.Summary();
+  ASSERT_EQ(stats.count, 4 * 10000 * 2);
+  ASSERT_NEAR(stats.total_us, 2 * 10000 * (1 + 2 + 3 + 4), 1e-3);
+  ASSERT_NEAR(stats.max_us, 4, 1e-3);
+}
+
+}  // namespace dali
@@ -0,0 +1,120 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_MPMC_RING_H_
+#define DALI_PIPELINE_UTIL_MPMC_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "dali/common.h"
+#include "dali/error_handling.h"
+
+namespace dali {
+
+/**
+ * @brief Bounded, lock-free queue for any number of producers and
+ * consumers.
+ *
+ * Every cell of the ring carries a sequence number that tells whether
+ * it is free for the push at its position or holds the value for the
+ * pop at its position. A push or a pop claims its position with a
+ * single CAS on the shared cursor and then only touches its own cell,
+ * so neither ever blocks or allocates. The capacity is rounded up to a
+ * power of two.
+ */
+template <typename T>
+class MPMCRing {
+ public:
+  explicit MPMCRing(size_t capacity) {
+    DALI_ENFORCE(capacity > 0, "MPMCRing capacity must be greater than 0");
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    mask_ = size - 1;
+    cells_.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    push_pos_.store(0, std::memory_order_relaxed);
+    pop_pos_.store(0, std::memory_order_relaxed);
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(MPMCRing);
+
+  size_t capacity() const {
+    return mask_ + 1;
+  }
+
+  // Returns false, without pushing, if the ring is full
+  bool TryPush(const T &value) {
+    size_t pos = push_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Returns false, leaving `value` untouched, if the ring is empty
+  bool TryPop(T *value) {
+    size_t pos = pop_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (pop_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = pop_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    *value = cell->value;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_;
+  // the producers and the consumers each update their own cursor, keep
+  // them on different cache lines
+  char pad0_[64];
+  std::atomic<size_t> push_pos_;
+  char pad1_[64];
+  std::atomic<size_t> pop_pos_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_MPMC_RING_H_
@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "dali/pipeline/util/mpmc_ring.h"
+
+namespace dali {
+
+TEST(MPMCRingTest, FullAndEmpty) {
+  MPMCRing<int> ring(3);
+  ASSERT_EQ(ring.capacity(), 4u);
+
+  int value = -1;
+  ASSERT_FALSE(ring.TryPop(&value));
+  ASSERT_EQ(value, -1);
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(ring.TryPush(i));
+    }
+    ASSERT_FALSE(ring.TryPush(4));
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(ring.TryPop(&value));
+      ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(ring.TryPop(&value));
+  }
+}
+
+TEST(MPMCRingTest, ConcurrentTakeAndReturn) {
+  // Like the tensors of a loader: every thread takes values out of the
+  // ring and puts them back, none is lost or duplicated
+  const int num_values = 64;
+  const int num_thread = 8;
+  MPMCRing<int> ring(num_values);
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_TRUE(ring.TryPush(i));
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_thread; ++t) {
+    threads.emplace_back([&ring] {
+        for (int i = 0; i < 20000; ++i) {
+          int value;
+          if (ring.TryPop(&value)) {
+            while (!ring.TryPush(value)) {}
+          }
+        }
+      });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<int> seen(num_values, 0);
+  int value;
+  while (ring.TryPop(&value)) {
+    ASSERT_GE(value, 0);
+    ASSERT_LT(value, num_values);
+    ++seen[value];
+  }
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_EQ(seen[i], 1) << "Value " << i << " seen " << seen[i] << " times";
+  }
+}
+
+}  // namespace dali
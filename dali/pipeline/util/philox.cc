@@ -0,0 +1,122 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/philox.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dali {
+
+namespace {
+
+// Blocks Generate() computes at a time
+const int kLanes = 8;
+// Numbers GenerateUniform() and GenerateBernoulli() draw at a time, on
+// the stack: whole blocks of all the lanes, so Generate() can compute
+// them together
+const size_t kChunk = 4 * kLanes;
+
+}  // namespace
+
+const int Philox::kRounds;
+const uint32_t Philox::kMul0;
+const uint32_t Philox::kMul1;
+const uint32_t Philox::kWeyl0;
+const uint32_t Philox::kWeyl1;
+
+void Philox::Generate(uint32_t *out, size_t n) {
+  // Rest of the current block
+  while (n > 0 && block_idx_ < 4) {
+    *out++ = block_[block_idx_++];
+    --n;
+  }
+
+  // Whole blocks, kLanes of them at a time. The words of the counters
+  // are kept in separate arrays, so that every step of a round is
+  // a loop over the lanes.
+  const uint32_t iter_lo = static_cast<uint32_t>(iteration_);
+  const uint32_t iter_hi = static_cast<uint32_t>(iteration_ >> 32);
+  while (n >= 4 * kLanes) {
+    uint32_t c0[kLanes], c1[kLanes], c2[kLanes], c3[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      c0[l] = position_ + l;
+      c1[l] = sample_;
+      c2[l] = iter_lo;
+      c3[l] = iter_hi;
+    }
+    uint32_t key0 = key0_, key1 = key1_;
+    for (int round = 0; round < kRounds; ++round) {
+      for (int l = 0; l < kLanes; ++l) {
+        const uint64_t prod0 = static_cast<uint64_t>(kMul0) * c0[l];
+        const uint64_t prod1 = static_cast<uint64_t>(kMul1) * c2[l];
+        const uint32_t n0 = static_cast<uint32_t>(prod1 >> 32) ^ c1[l] ^ key0;
+        const uint32_t n2 = static_cast<uint32_t>(prod0 >> 32) ^ c3[l] ^ key1;
+        c1[l] = static_cast<uint32_t>(prod1);
+        c3[l] = static_cast<uint32_t>(prod0);
+        c0[l] = n0;
+        c2[l] = n2;
+      }
+      key0 += kWeyl0;
+      key1 += kWeyl1;
+    }
+    for (int l = 0; l < kLanes; ++l) {
+      out[4 * l] = c0[l];
+      out[4 * l + 1] = c1[l];
+      out[4 * l + 2] = c2[l];
+      out[4 * l + 3] = c3[l];
+    }
+    position_ += kLanes;
+    out += 4 * kLanes;
+    n -= 4 * kLanes;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = (*this)();
+  }
+}
+
+void Philox::GenerateUniform(float *out, size_t n, float lo, float hi) {
+  uint32_t bits[kChunk];
+  const float range = hi - lo;
+  // lo + x * range rounds up to hi for the x closest to 1 when the
+  // range is narrow compared to lo, those get the float below hi
+  const bool clamp = lo < hi;
+  const float below_hi = std::nextafter(hi, lo);
+  while (n > 0) {
+    const size_t count = std::min(n, kChunk);
+    Generate(bits, count);
+    for (size_t i = 0; i < count; ++i) {
+      const float x = lo + ToUnitFloat(bits[i]) * range;
+      out[i] = clamp && x >= hi ? below_hi : x;
+    }
+    out += count;
+    n -= count;
+  }
+}
+
+void Philox::GenerateBernoulli(int *out, size_t n, float p) {
+  uint32_t bits[kChunk];
+  while (n > 0) {
+    const size_t count = std::min(n, kChunk);
+    Generate(bits, count);
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = ToUnitFloat(bits[i]) < p ? 1 : 0;
+    }
+    out += count;
+    n -= count;
+  }
+}
+
+}  // namespace dali
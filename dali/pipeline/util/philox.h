@@ -0,0 +1,128 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_PHILOX_H_
+#define DALI_PIPELINE_UTIL_PHILOX_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "dali/api_helper.h"
+
+namespace dali {
+
+/**
+ * @brief Philox4x32-10 counter-based random number generator
+ * (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+ *
+ * The numbers are a function of the key and of their position in
+ * a stream, and not of any state shared between the draws. The key is
+ * the seed of the op, which the pipeline makes unique for every op, and
+ * the stream is selected by the iteration and the index of the sample.
+ * Every sample of every iteration thus gets its own sequence, which does
+ * not depend on the number of threads or on the order the samples run
+ * in, and ops can create generators wherever they need them without
+ * any locking.
+ *
+ * Satisfies UniformRandomBitGenerator, so it can be used with
+ * the distributions of the standard library.
+ */
+class DLL_PUBLIC Philox {
+ public:
+  typedef uint32_t result_type;
+  typedef std::array<uint32_t, 4> Block;
+
+  DLL_PUBLIC inline Philox(uint64_t seed, uint64_t iteration, uint32_t sample) :
+    key0_(static_cast<uint32_t>(seed)),
+    key1_(static_cast<uint32_t>(seed >> 32)),
+    sample_(sample),
+    iteration_(iteration),
+    position_(0),
+    block_idx_(4) {}
+
+  DLL_PUBLIC static constexpr result_type min() { return 0; }
+  DLL_PUBLIC static constexpr result_type max() { return UINT32_MAX; }
+
+  DLL_PUBLIC inline result_type operator()() {
+    if (block_idx_ == 4) {
+      block_ = Compute({position_++, sample_, static_cast<uint32_t>(iteration_),
+                        static_cast<uint32_t>(iteration_ >> 32)}, key0_, key1_);
+      block_idx_ = 0;
+    }
+    return block_[block_idx_++];
+  }
+
+  /**
+   * @brief Fills `out` with the next `n` numbers of the stream, the
+   * same as calling the generator `n` times. The blocks are computed
+   * several at a time, in a loop the compiler can vectorize.
+   */
+  DLL_PUBLIC void Generate(uint32_t *out, size_t n);
+
+  /**
+   * @brief Fills `out` with `n` numbers uniformly distributed in [lo, hi).
+   */
+  DLL_PUBLIC void GenerateUniform(float *out, size_t n, float lo, float hi);
+
+  /**
+   * @brief Fills `out` with `n` values, that are 1 with probability `p`
+   * and 0 otherwise.
+   */
+  DLL_PUBLIC void GenerateBernoulli(int *out, size_t n, float p);
+
+  /**
+   * @brief Returns a number uniformly distributed in [0, 1),
+   * with 24 random bits.
+   */
+  DLL_PUBLIC static inline float ToUnitFloat(uint32_t x) {
+    return (x >> 8) * (1.f / (1 << 24));
+  }
+
+  /**
+   * @brief Computes the 10 rounds of Philox4x32 for one counter.
+   */
+  DLL_PUBLIC static inline Block Compute(Block ctr, uint32_t key0, uint32_t key1) {
+    for (int round = 0; round < kRounds; ++round) {
+      const uint64_t prod0 = static_cast<uint64_t>(kMul0) * ctr[0];
+      const uint64_t prod1 = static_cast<uint64_t>(kMul1) * ctr[2];
+      ctr = {static_cast<uint32_t>(prod1 >> 32) ^ ctr[1] ^ key0,
+             static_cast<uint32_t>(prod1),
+             static_cast<uint32_t>(prod0 >> 32) ^ ctr[3] ^ key1,
+             static_cast<uint32_t>(prod0)};
+      key0 += kWeyl0;
+      key1 += kWeyl1;
+    }
+    return ctr;
+  }
+
+ private:
+  static const int kRounds = 10;
+  static const uint32_t kMul0 = 0xD2511F53;
+  static const uint32_t kMul1 = 0xCD9E8D57;
+  static const uint32_t kWeyl0 = 0x9E3779B9;
+  static const uint32_t kWeyl1 = 0xBB67AE85;
+
+  uint32_t key0_, key1_;
+  uint32_t sample_;
+  uint64_t iteration_;
+  // Counter of the next block to compute
+  uint32_t position_;
+  Block block_;
+  int block_idx_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_PHILOX_H_
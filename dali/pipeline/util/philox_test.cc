@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/philox.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace dali {
+
+TEST(PhiloxTest, KnownAnswers) {
+  // Known answers of the Random123 library
+  Philox::Block zero = Philox::Compute({0, 0, 0, 0}, 0, 0);
+  ASSERT_EQ(zero, Philox::Block({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+
+  Philox::Block ones = Philox::Compute(
+      {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, 0xffffffff, 0xffffffff);
+  ASSERT_EQ(ones, Philox::Block({0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+
+  Philox::Block pi = Philox::Compute(
+      {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, 0xa4093822, 0x299f31d0);
+  ASSERT_EQ(pi, Philox::Block({0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(PhiloxTest, Streams) {
+  Philox a(1234, 5, 7), b(1234, 5, 7);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(a(), b());
+  }
+
+  // Other samples, iterations and seeds get other numbers
+  Philox first(1234, 5, 7), sample(1234, 5, 8), iteration(1234, 6, 7), seed(4321, 5, 7);
+  const uint32_t x = first();
+  ASSERT_NE(x, sample());
+  ASSERT_NE(x, iteration());
+  ASSERT_NE(x, seed());
+}
+
+TEST(PhiloxTest, Generate) {
+  // The bulk path continues the stream at any position
+  for (size_t skip : {0, 1, 3, 4, 5}) {
+    for (size_t n : {0, 7, 32, 100, 1000}) {
+      Philox scalar(42, 1, 0), bulk(42, 1, 0);
+      for (size_t i = 0; i < skip; ++i) {
+        ASSERT_EQ(scalar(), bulk());
+      }
+      std::vector<uint32_t> out(n);
+      bulk.Generate(out.data(), n);
+      for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(out[i], scalar()) << "skip " << skip << " n " << n << " i " << i;
+      }
+      ASSERT_EQ(scalar(), bulk());
+    }
+  }
+}
+
+TEST(PhiloxTest, Distributions) {
+  const int n = 10000;
+  std::vector<float> uniform(n);
+  Philox(1, 0, 0).GenerateUniform(uniform.data(), n, -2.f, 3.f);
+  double sum = 0;
+  for (float x : uniform) {
+    ASSERT_GE(x, -2.f);
+    ASSERT_LE(x, 3.f);
+    sum += x;
+  }
+  ASSERT_NEAR(sum / n, 0.5, 0.1);
+
+  // A narrow range far from 0, where the draws closest to 1 would round
+  // up to hi
+  std::vector<float> narrow(1 << 20);
+  Philox(1, 0, 0).GenerateUniform(narrow.data(), narrow.size(), 1000.f, 1001.f);
+  for (float x : narrow) {
+    ASSERT_GE(x, 1000.f);
+    ASSERT_LT(x, 1001.f);
+  }
+
+  std::vector<int> coins(n);
+  Philox(1, 0, 0).GenerateBernoulli(coins.data(), n, 0.25f);
+  int ones = 0;
+  for (int x : coins) {
+    ASSERT_TRUE(x == 0 || x == 1);
+    ones += x;
+  }
+  ASSERT_NEAR(static_cast<double>(ones) / n, 0.25, 0.02);
+
+  // Works with the standard distributions
+  Philox gen(1, 0, 0);
+  std::uniform_int_distribution<int> dis(0, 6);
+  for (int i = 0; i < 100; ++i) {
+    const int x = dis(gen);
+    ASSERT_GE(x, 0);
+    ASSERT_LE(x, 6);
+  }
+}
+
+}  // namespace dali
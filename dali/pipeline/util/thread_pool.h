@@ -39,9 +39,12 @@ class ThreadPool {
     : threads_(num_thread),
       running_(true),
       work_complete_(true),
-      active_threads_(0) {
+      active_threads_(0),
+      use_gpu_(device_id != CPU_ONLY_DEVICE_ID) {
     DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
-    nvml::Init();
+    if (use_gpu_) {
+      nvml::Init();
+    }
     // Start the threads in the main loop
     for (int i = 0; i < num_thread; ++i) {
       threads_[i] = std::thread(std::bind(&ThreadPool::ThreadMain,
@@ -62,7 +65,9 @@ class ThreadPool {
     for (auto &thread : threads_) {
       thread.join();
     }
-    nvml::Shutdown();
+    if (use_gpu_) {
+      nvml::Shutdown();
+    }
   }
 
   inline void DoWorkWithID(Work work) {
@@ -104,9 +109,12 @@ class ThreadPool {
  private:
   inline void ThreadMain(int thread_id, int device_id, bool set_affinity) {
     try {
-    CUDA_CALL(cudaSetDevice(device_id));
-      if (set_affinity) {
-        nvml::SetCPUAffinity();
+      // Affinity is derived from the GPU, cpu-only threads keep the default
+      if (use_gpu_) {
+        CUDA_CALL(cudaSetDevice(device_id));
+        if (set_affinity) {
+          nvml::SetCPUAffinity();
+        }
       }
     } catch(std::runtime_error &e) {
       tl_errors_[thread_id].push(e.what());
@@ -161,6 +169,7 @@ class ThreadPool {
   bool running_;
   bool work_complete_;
   int active_threads_;
+  const bool use_gpu_;
   std::mutex mutex_;
   std::condition_variable condition_;
   std::condition_variable completed_;
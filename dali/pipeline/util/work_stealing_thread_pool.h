@@ -0,0 +1,255 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_WORK_STEALING_THREAD_POOL_H_
+#define DALI_PIPELINE_UTIL_WORK_STEALING_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/error_handling.h"
+#include "dali/pipeline/util/chase_lev_deque.h"
+#include "dali/util/nvml.h"
+
+namespace dali {
+
+/**
+ * @brief Thread pool with one lock-free work deque per worker (see
+ * ChaseLevDeque). Drop-in replacement for ThreadPool.
+ *
+ * Work issued by a worker, e.g. the next sample of the streaming mode,
+ * goes into the deque of that worker, which pops it from the bottom.
+ * Work issued by other threads goes into one more deque, shared by the
+ * issuing threads, which only lock to push into it. The workers steal
+ * from the top of that deque, and from the top of each other's once it
+ * is empty, so the issued work is started in the order it was issued.
+ * No worker ever takes a lock to get work. Completion is tracked with an
+ * atomic counter of outstanding work: workers only take the completion
+ * lock when the counter drops to zero, i.e. once per batch instead of
+ * once per item.
+ *
+ * As with ThreadPool, the argument passed to the work is the id of the
+ * worker running it, in the range [0, size()).
+ */
+class WorkStealingThreadPool {
+ public:
+  // Basic unit of work that our threads do
+  typedef std::function<void(int)> Work;
+
+  inline WorkStealingThreadPool(int num_thread, int device_id, bool set_affinity)
+    : threads_(num_thread),
+      running_(true),
+      queued_(0),
+      outstanding_(0),
+      sleeping_(0),
+      use_gpu_(device_id != CPU_ONLY_DEVICE_ID) {
+    DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
+    if (use_gpu_) {
+      nvml::Init();
+    }
+    for (int i = 0; i < num_thread; ++i) {
+      queues_.emplace_back(new ChaseLevDeque<Work>);
+    }
+    tl_errors_.resize(num_thread);
+    // Start the threads in the main loop
+    for (int i = 0; i < num_thread; ++i) {
+      threads_[i] = std::thread(std::bind(&WorkStealingThreadPool::ThreadMain,
+              this, i, device_id, set_affinity));
+    }
+  }
+
+  inline ~WorkStealingThreadPool() {
+    // Wait for work to find errors
+    WaitForWork(false);
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    running_ = false;
+    sleep_cond_.notify_all();
+    lock.unlock();
+
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+    // all the work ran, the deques are empty
+    if (use_gpu_) {
+      nvml::Shutdown();
+    }
+  }
+
+  inline void DoWorkWithID(Work work) {
+    outstanding_.fetch_add(1);
+    Work *item = new Work(std::move(work));
+    const Worker &worker = CurrentWorker();
+    if (worker.pool == this) {
+      // Only this worker pushes into its deque
+      queues_[worker.thread_id]->Push(item);
+    } else {
+      std::lock_guard<std::mutex> lock(issue_mutex_);
+      issued_.Push(item);
+    }
+    queued_.fetch_add(1);
+
+    // Only wake a worker if one is actually asleep, the busy ones
+    // will find the new work when they look for their next item
+    if (sleeping_.load() > 0) {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      sleep_cond_.notify_one();
+    }
+  }
+
+  // Blocks until all work issued to the thread pool is complete
+  inline void WaitForWork(bool checkForErrors = true) {
+    std::unique_lock<std::mutex> lock(completed_mutex_);
+    completed_.wait(lock, [this] { return this->outstanding_.load() == 0; });
+
+    if (checkForErrors) {
+      // Check for errors
+      for (size_t i = 0; i < threads_.size(); ++i) {
+        if (!tl_errors_[i].empty()) {
+          // Throw the first error that occured
+          string error = "Error in thread " +
+            std::to_string(i) + ": " + tl_errors_[i].front();
+          tl_errors_[i].pop();
+          throw std::runtime_error(error);
+        }
+      }
+    }
+  }
+
+  inline int size() const {
+    return threads_.size();
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(WorkStealingThreadPool);
+
+ private:
+  // The pool and the id of the worker running on this thread, if any
+  struct Worker {
+    const WorkStealingThreadPool *pool;
+    int thread_id;
+  };
+
+  static inline Worker &CurrentWorker() {
+    static thread_local Worker worker = {nullptr, -1};
+    return worker;
+  }
+
+  // Takes the work the worker issued last, from its own deque
+  inline Work *PopWork(int thread_id) {
+    return queues_[thread_id]->Pop();
+  }
+
+  // Takes the oldest work issued by the other threads, or else by
+  // the other workers
+  inline Work *StealWork(int thread_id) {
+    if (Work *work = issued_.Steal()) return work;
+    const int num_queues = queues_.size();
+    for (int i = 1; i < num_queues; ++i) {
+      if (Work *work = queues_[(thread_id + i) % num_queues]->Steal()) return work;
+    }
+    return nullptr;
+  }
+
+  inline void ThreadMain(int thread_id, int device_id, bool set_affinity) {
+    try {
+      // Affinity is derived from the GPU, cpu-only threads keep the default
+      if (use_gpu_) {
+        CUDA_CALL(cudaSetDevice(device_id));
+        if (set_affinity) {
+          nvml::SetCPUAffinity();
+        }
+      }
+    } catch(std::runtime_error &e) {
+      tl_errors_[thread_id].push(e.what());
+    } catch(...) {
+      tl_errors_[thread_id].push("Caught unknown exception");
+    }
+
+    CurrentWorker() = {this, thread_id};
+    while (true) {
+      Work *item = PopWork(thread_id);
+      if (!item) item = StealWork(thread_id);
+      if (!item) {
+        // Nothing to do, sleep until new work is issued. The counter
+        // of sleeping threads is raised before `queued_` is checked, so
+        // a concurrent DoWorkWithID either sees this thread sleeping
+        // and notifies it, or this thread sees the new work. A steal
+        // that lost a race leaves `queued_` up, and is retried.
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleeping_.fetch_add(1);
+        sleep_cond_.wait(lock, [this] {
+            return !running_ || queued_.load() > 0;
+          });
+        sleeping_.fetch_sub(1);
+        if (!running_) break;
+        continue;
+      }
+      queued_.fetch_sub(1);
+      std::unique_ptr<Work> work(item);
+
+      // If an error occurs, we save it in tl_errors_. When
+      // WaitForWork is called, we will check for any errors
+      // in the threads and return an error if one occured.
+      try {
+        (*work)(thread_id);
+      } catch(std::runtime_error &e) {
+        tl_errors_[thread_id].push(e.what());
+      } catch(...) {
+        tl_errors_[thread_id].push("Caught unknown exception");
+      }
+
+      // Only the last piece of outstanding work signals completion
+      if (outstanding_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(completed_mutex_);
+        completed_.notify_all();
+      }
+    }
+  }
+
+  vector<std::thread> threads_;
+  // the work issued by each worker
+  vector<std::unique_ptr<ChaseLevDeque<Work>>> queues_;
+  // the work issued by the other threads, which push into it in turn
+  ChaseLevDeque<Work> issued_;
+  std::mutex issue_mutex_;
+
+  std::atomic<bool> running_;
+  // Number of work items sitting in the queues
+  std::atomic<int> queued_;
+  // Number of work items issued but not finished yet
+  std::atomic<int> outstanding_;
+  std::atomic<int> sleeping_;
+  const bool use_gpu_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cond_;
+  std::mutex completed_mutex_;
+  std::condition_variable completed_;
+
+  //  Stored error strings for each thread
+  vector<std::queue<string>> tl_errors_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_WORK_STEALING_THREAD_POOL_H_
@@ -0,0 +1,111 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "dali/pipeline/util/work_stealing_thread_pool.h"
+
+namespace dali {
+
+TEST(WorkStealingThreadPoolTest, RunsAllWork) {
+  const int num_thread = 4;
+  const int num_work = 1000;
+  WorkStealingThreadPool pool(num_thread, 0, false);
+  ASSERT_EQ(pool.size(), num_thread);
+
+  for (int iter = 0; iter < 3; ++iter) {
+    std::vector<int> done(num_work, 0);
+    std::atomic<int> bad_tid(0);
+    for (int i = 0; i < num_work; ++i) {
+      pool.DoWorkWithID([&done, &bad_tid, i, num_thread] (int tid) {
+          if (tid < 0 || tid >= num_thread) ++bad_tid;
+          ++done[i];
+        });
+    }
+    pool.WaitForWork();
+    ASSERT_EQ(bad_tid, 0);
+    for (int i = 0; i < num_work; ++i) {
+      ASSERT_EQ(done[i], 1) << "Work item " << i << " ran " << done[i] << " times";
+    }
+  }
+}
+
+TEST(WorkStealingThreadPoolTest, ThreadIdIsExclusive) {
+  // Operators index per-thread state with the id given to the work,
+  // so two pieces of work with the same id must never run concurrently
+  const int num_thread = 8;
+  WorkStealingThreadPool pool(num_thread, 0, false);
+  std::vector<std::atomic<int>> in_use(num_thread);
+  for (auto &v : in_use) v = 0;
+  std::atomic<int> overlaps(0);
+
+  for (int i = 0; i < 4096; ++i) {
+    pool.DoWorkWithID([&in_use, &overlaps] (int tid) {
+        if (in_use[tid].fetch_add(1) != 0) ++overlaps;
+        std::this_thread::yield();
+        in_use[tid].fetch_sub(1);
+      });
+  }
+  pool.WaitForWork();
+  ASSERT_EQ(overlaps, 0);
+}
+
+TEST(WorkStealingThreadPoolTest, RunsWorkIssuedByWorkers) {
+  // Like the streaming mode of the executor, the work of a sample issues
+  // the work of the same sample in the next batch
+  const int num_thread = 4;
+  const int num_samples = 64;
+  const int num_batches = 50;
+  WorkStealingThreadPool pool(num_thread, 0, false);
+  std::vector<std::atomic<int>> done(num_samples);
+  for (auto &d : done) d = 0;
+
+  std::function<void(int, int, int)> run = [&pool, &done, &run] (int sample, int batch, int) {
+      ++done[sample];
+      if (batch + 1 < num_batches) {
+        pool.DoWorkWithID(std::bind(run, sample, batch + 1, std::placeholders::_1));
+      }
+    };
+  for (int i = 0; i < num_samples; ++i) {
+    pool.DoWorkWithID(std::bind(run, i, 0, std::placeholders::_1));
+  }
+  pool.WaitForWork();
+  for (int i = 0; i < num_samples; ++i) {
+    ASSERT_EQ(done[i], num_batches);
+  }
+}
+
+TEST(WorkStealingThreadPoolTest, ReportsErrors) {
+  WorkStealingThreadPool pool(2, 0, false);
+  for (int i = 0; i < 16; ++i) {
+    pool.DoWorkWithID([i] (int) {
+        if (i == 7) throw std::runtime_error("Bad sample");
+      });
+  }
+  ASSERT_THROW(pool.WaitForWork(), std::runtime_error);
+
+  // The pool remains usable after an error was reported
+  std::atomic<int> count(0);
+  for (int i = 0; i < 16; ++i) {
+    pool.DoWorkWithID([&count] (int) { ++count; });
+  }
+  pool.WaitForWork();
+  ASSERT_EQ(count, 16);
+}
+
+}  // namespace dali
@@ -59,8 +59,11 @@ class WorkerThread {
   typedef std::function<void(void)> Work;
 
   inline WorkerThread(int device_id, bool set_affinity) :
-    running_(true), work_complete_(true), barrier_(2) {
-    nvml::Init();
+    running_(true), work_complete_(true),
+    use_gpu_(device_id != CPU_ONLY_DEVICE_ID), barrier_(2) {
+    if (use_gpu_) {
+      nvml::Init();
+    }
     thread_ = std::thread(&WorkerThread::ThreadMain,
         this, device_id, set_affinity);
   }
@@ -83,7 +86,9 @@ class WorkerThread {
       ForceStop();
       thread_.join();
     }
-    nvml::Shutdown();
+    if (use_gpu_) {
+      nvml::Shutdown();
+    }
   }
 
   inline void DoWork(Work work) {
@@ -135,9 +140,12 @@ class WorkerThread {
  private:
   void ThreadMain(int device_id, bool set_affinity) {
     try {
-      CUDA_CALL(cudaSetDevice(device_id));
-      if (set_affinity) {
-        nvml::SetCPUAffinity();
+      // Affinity is derived from the GPU, cpu-only threads keep the default
+      if (use_gpu_) {
+        CUDA_CALL(cudaSetDevice(device_id));
+        if (set_affinity) {
+          nvml::SetCPUAffinity();
+        }
       }
     } catch(std::runtime_error &e) {
       errors_.push(e.what());
@@ -189,6 +197,7 @@ class WorkerThread {
   }
 
   bool running_, work_complete_;
+  const bool use_gpu_;
   std::queue<Work> work_queue_;
   std::thread thread_;
   std::mutex mutex_;
@@ -19,11 +19,17 @@
 namespace dali {
 
 void HostWorkspace::GetSample(SampleWorkspace *ws,
-    int data_idx, int thread_idx) {
+    int data_idx, int thread_idx, ScratchArena *scratch) {
   DALI_ENFORCE(ws != nullptr, "Input workspace is nullptr.");
   ws->Clear();
   ws->set_data_idx(data_idx);
   ws->set_thread_idx(thread_idx);
+  if (scratch == nullptr) {
+    scratch = &ScratchArena::ThreadLocal();
+  }
+  scratch->Reset();
+  ws->set_scratch(scratch);
+  ws->set_iteration(iteration_);
   for (const auto &input_meta : input_index_map_) {
     if (input_meta.first) {
       ws->AddInput(cpu_inputs_[input_meta.second][data_idx]);
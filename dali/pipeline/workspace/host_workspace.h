@@ -22,6 +22,7 @@
 #include "dali/common.h"
 #include "dali/error_handling.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/scratch_arena.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/workspace/workspace.h"
 
@@ -45,9 +46,11 @@ class DLL_PUBLIC HostWorkspace : public WorkspaceBase<HostInputType, HostOutputT
 
   /**
    * @brief Returns a sample workspace for the given sample
-   * index and thread index
+   * index and thread index. The scratch arena is reset and given to
+   * the sample, if there is none the arena of the calling thread is.
    */
-  DLL_PUBLIC void GetSample(SampleWorkspace *ws, int data_idx, int thread_idx);
+  DLL_PUBLIC void GetSample(SampleWorkspace *ws, int data_idx, int thread_idx,
+      ScratchArena *scratch = nullptr);
 
   /**
    * @brief Returns the number of Tensors in the input set of
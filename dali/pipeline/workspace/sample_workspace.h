@@ -24,6 +24,7 @@
 #include "dali/common.h"
 #include "dali/error_handling.h"
 #include "dali/pipeline/workspace/device_workspace.h"
+#include "dali/pipeline/data/scratch_arena.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/workspace/host_workspace.h"
@@ -42,7 +43,8 @@ using SampleOutputType = shared_ptr<Tensor<Backend>>;
  */
 class DLL_PUBLIC SampleWorkspace : public WorkspaceBase<SampleInputType, SampleOutputType> {
  public:
-  DLL_PUBLIC SampleWorkspace() : data_idx_(-1), thread_idx_(-1), has_stream_(false) {}
+  DLL_PUBLIC SampleWorkspace() : data_idx_(-1), thread_idx_(-1), has_stream_(false),
+    scratch_(nullptr) {}
 
   DLL_PUBLIC ~SampleWorkspace() = default;
 
@@ -56,6 +58,7 @@ class DLL_PUBLIC SampleWorkspace : public WorkspaceBase<SampleInputType, SampleO
     thread_idx_ = -1;
     has_stream_ = false;
     stream_ = 0;
+    scratch_ = nullptr;
   }
 
   /**
@@ -120,10 +123,48 @@ class DLL_PUBLIC SampleWorkspace : public WorkspaceBase<SampleInputType, SampleO
     stream_ = stream;
   }
 
+  /**
+   * @brief Returns the scratch arena for the temporary buffers of the
+   * op running on this sample. It is reset before each op runs, so the
+   * memory must not be kept past RunImpl. Workspaces that did not come
+   * from HostWorkspace::GetSample() use the arena of the calling thread,
+   * which is reset when the op is done with the sample instead.
+   */
+  DLL_PUBLIC inline ScratchArena &scratch() {
+    return scratch_ != nullptr ? *scratch_ : ScratchArena::ThreadLocal();
+  }
+
+  /**
+   * @brief Returns uninitialized scratch memory
+   * for `count` objects of type T.
+   */
+  template <typename T>
+  DLL_PUBLIC inline T *AllocateScratch(size_t count) {
+    return scratch().Allocate<T>(count);
+  }
+
+  /**
+   * @brief Releases the scratch memory of the op that ran on this
+   * sample, if it was taken from the arena of the calling thread.
+   */
+  DLL_PUBLIC inline void ReleaseThreadLocalScratch() {
+    if (scratch_ == nullptr) {
+      ScratchArena::ThreadLocal().Reset();
+    }
+  }
+
+  /**
+   * @brief Sets the scratch arena for this workspace.
+   */
+  DLL_PUBLIC inline void set_scratch(ScratchArena *scratch) {
+    scratch_ = scratch;
+  }
+
  private:
   int data_idx_, thread_idx_;
   cudaStream_t stream_;
   bool has_stream_;
+  ScratchArena *scratch_;
 };
 
 }  // namespace dali
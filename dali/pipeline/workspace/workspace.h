@@ -57,9 +57,22 @@ class ArgumentWorkspace {
     return *(argument_inputs_.at(arg_name));
   }
 
+  /**
+   * @brief Returns the index of the iteration, counted by the
+   * executor from 0. Random ops use it to select their streams.
+   */
+  inline int64 iteration() const {
+    return iteration_;
+  }
+
+  inline void set_iteration(int64 iteration) {
+    iteration_ = iteration;
+  }
+
  protected:
   // Argument inputs
   std::unordered_map<std::string, shared_ptr<Tensor<CPUBackend>>> argument_inputs_;
+  int64 iteration_ = 0;
 };
 
 /**
@@ -134,7 +134,10 @@ void ExposeTensor(py::module &m) { // NOLINT
       R"code(
       Tensor residing in the CPU memory.
       )code")
-    .def("shape", &Tensor<CPUBackend>::shape,
+    .def("shape",
+         [](Tensor<CPUBackend> &t) -> vector<Index> {
+           return t.shape();
+         },
          R"code(
          Shape of the tensor.
          )code")
@@ -167,7 +170,10 @@ void ExposeTensor(py::module &m) { // NOLINT
       )code");
 
   py::class_<Tensor<GPUBackend>>(m, "TensorGPU")
-    .def("shape", &Tensor<GPUBackend>::shape,
+    .def("shape",
+         [](Tensor<GPUBackend> &t) -> vector<Index> {
+           return t.shape();
+         },
          R"code(
          Shape of the tensor.
          )code")
@@ -397,6 +403,17 @@ static vector<string> GetRegisteredSupportOps() {
 static const OpSchema &GetSchema(const string &name) {
   return SchemaRegistry::GetSchema(name);
 }
+
+static py::dict TimingStatisticsToDict(const TimingStatistics &stats) {
+  py::dict dict;
+  dict["count"] = stats.count;
+  dict["total_us"] = stats.total_us;
+  dict["p50_us"] = stats.p50_us;
+  dict["p90_us"] = stats.p90_us;
+  dict["p99_us"] = stats.p99_us;
+  dict["max_us"] = stats.max_us;
+  return dict;
+}
 #ifdef DALI_BUILD_PROTO3
 typedef dali::TFRecordParser::FeatureType TFFeatureType;
 typedef dali::TFRecordParser::Feature TFFeature;
@@ -484,6 +501,23 @@ PYBIND11_MODULE(backend_impl, m) {
     .value("SAME", DALI_SAME)
     .export_values();
 
+  // CPUExecutionMode
+  py::enum_<CPUExecutionMode>(types_m, "CPUExecutionMode", "Scheduling of CPU ops over a batch")
+    .value("SAMPLE_MAJOR", DALI_CPU_SAMPLE_MAJOR)
+    .value("OPERATOR_MAJOR", DALI_CPU_OPERATOR_MAJOR)
+    .value("STREAMING", DALI_CPU_STREAMING)
+    .export_values();
+
+  // CPUSchedulingPolicy
+  py::enum_<CPUSchedulingPolicy>(types_m, "CPUSchedulingPolicy",
+      "Order of issuing the samples of a batch to CPU threads")
+    .value("IN_ORDER", DALI_CPU_SCHEDULE_IN_ORDER)
+    .value("LONGEST_FIRST", DALI_CPU_SCHEDULE_LONGEST_FIRST)
+    .export_values();
+
+  // Device id of pipelines that never use the GPU
+  types_m.attr("CPU_ONLY_DEVICE_ID") = CPU_ONLY_DEVICE_ID;
+
   // Operator node
   py::class_<OpNode>(m, "OpNode")
     .def("instance_name",
@@ -557,6 +591,59 @@ PYBIND11_MODULE(backend_impl, m) {
         [](Pipeline *p, const std::vector<std::pair<string, string>>& outputs) {
           p->SetOutputNames(outputs);
           })
+    .def("SetCPUExecutionMode", &Pipeline::SetCPUExecutionMode)
+    .def("SetCPUSchedulingPolicy", &Pipeline::SetCPUSchedulingPolicy)
+    .def("SetBufferPolicy",
+        [](Pipeline *p, double growth_factor, size_t alignment,
+           int shrink_after, double shrink_threshold) {
+          BufferPolicy policy;
+          policy.growth_factor = growth_factor;
+          policy.alignment = alignment;
+          policy.shrink_after = shrink_after;
+          policy.shrink_threshold = shrink_threshold;
+          p->SetBufferPolicy(policy);
+        })
+    .def("EnableStatistics", &Pipeline::EnableStatistics)
+    .def("GetStatistics",
+        [](Pipeline *p) {
+          ExecutorStatistics stats = p->GetStatistics();
+          py::list ops;
+          for (auto &op_stats : stats.ops) {
+            py::dict op;
+            op["name"] = op_stats.name;
+            op["device"] = op_stats.device;
+            op["run_time"] = TimingStatisticsToDict(op_stats.run_time);
+            op["bytes_produced"] = op_stats.bytes_produced;
+            op["prefetch_wait"] = TimingStatisticsToDict(op_stats.prefetch_wait);
+            op["max_sample_bytes"] = op_stats.max_sample_bytes;
+            ops.append(op);
+          }
+          py::dict dict;
+          dict["iterations"] = stats.iterations;
+          dict["ops"] = ops;
+          dict["free_queue_wait"] = TimingStatisticsToDict(stats.free_queue_wait);
+          dict["ready_queue_wait"] = TimingStatisticsToDict(stats.ready_queue_wait);
+          dict["planned_peak_bytes"] = stats.planned_peak_bytes;
+          dict["allocated_bytes"] = stats.allocated_bytes;
+          dict["max_sample_bytes"] = stats.max_sample_bytes;
+          return dict;
+        })
+    .def("ResetStatistics", &Pipeline::ResetStatistics)
+    .def("GetMemoryReport",
+        [](Pipeline *p) {
+          py::list report;
+          for (auto &usage : p->GetMemoryReport()) {
+            py::dict tag;
+            tag["tag"] = usage.tag;
+            tag["host_bytes"] = usage.host_bytes;
+            tag["host_peak_bytes"] = usage.host_peak_bytes;
+            tag["gpu_bytes"] = usage.gpu_bytes;
+            tag["gpu_peak_bytes"] = usage.gpu_peak_bytes;
+            report.append(tag);
+          }
+          return report;
+        })
+    .def("ResetMemoryPeaks", &Pipeline::ResetMemoryPeaks)
     .def("RunCPU", &Pipeline::RunCPU)
     .def("RunGPU", &Pipeline::RunGPU)
     .def("Outputs",
@@ -675,6 +762,12 @@ PYBIND11_MODULE(backend_impl, m) {
         return ret;
         }, py::return_value_policy::reference);
 
+  // Chrome trace of the executor stages, ops and readers
+  m.def("StartTracing", []() { Tracer::Get().Start(); });
+  m.def("StopTracing", []() { Tracer::Get().Stop(); });
+  m.def("ChromeTrace", []() { return Tracer::Get().ChromeTraceJSON(); });
+  m.def("DumpChromeTrace", [](const string &path) { Tracer::Get().DumpChromeTrace(path); });
+
   // Registries for cpu, gpu & mixed operators
   m.def("RegisteredCPUOps", &GetRegisteredCPUOps);
   m.def("RegisteredGPUOps", &GetRegisteredGPUOps);
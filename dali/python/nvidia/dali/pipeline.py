@@ -16,6 +16,7 @@
 from collections import deque
 from nvidia.dali import backend as b
 from nvidia.dali import tensor as nt
+from nvidia.dali import types
 
 class Pipeline(object):
     """Pipeline class encapsulates all data required to define and run
@@ -38,6 +39,9 @@ class Pipeline(object):
                   Negative values for this parameter are invalid - the default
                   value may only be used with serialized pipeline (the value
                   stored in serialized pipeline is used instead).
+                  `types.CPU_ONLY_DEVICE_ID` creates a pipeline of CPU and
+                  support ops only, which never uses the GPU and can run on
+                  machines without one. Its outputs must be on the CPU.
     `seed` : int, optional, default = -1
              Seed used for random number generation. Leaving the default value
              for this parameter results in random seed.
@@ -64,11 +68,50 @@ class Pipeline(object):
     `prefetch_queue_depth`: length of the executor pipeline. The longer the more resistant
                     the Dali is fo uneven execution time of each batch, but it also
                     consumes more memory for the internall buffers
+    `exec_op_major` : bool, optional, default = False
+                      Whether to run each CPU operator over a whole chunk of the batch
+                      before moving to the next operator, instead of running all CPU
+                      operators on one sample before moving to the next sample.
+    `exec_cpu_streaming` : bool, optional, default = False
+                           Whether to start the CPU work of the next batch as soon as
+                           CPU threads free up, instead of waiting for the slowest sample
+                           of the current batch. The number of batches in flight is
+                           bounded by the length of the executor pipeline.
+                           Cannot be used together with `exec_op_major`.
+    `exec_longest_first` : bool, optional, default = False
+                           Whether to estimate the cost of each sample from the size
+                           of the data read and start the most expensive samples of
+                           a batch first, so that large samples do not delay the
+                           whole batch. Ignored with `exec_op_major` and
+                           `exec_cpu_streaming`.
+    `enable_statistics` : bool, optional, default = False
+                          Whether to collect the execution statistics returned
+                          by `statistics()`: run times of each operator and time
+                          waited for the output buffers and by the readers.
+    `buffer_growth_factor` : float, optional, default = 1.0
+                             How many times more memory than needed the buffers
+                             allocate when they grow, so that buffers growing a
+                             little at a time are not reallocated every time.
+    `buffer_alignment` : int, optional, default = 1
+                         Sizes of the allocations of the buffers are rounded up
+                         to a multiple of this.
+    `buffer_shrink_after` : int, optional, default = 0
+                            Number of resizes in a row to less than
+                            `buffer_shrink_threshold` of its allocation after which
+                            a buffer is reallocated to fit. Value of 0 never shrinks
+                            the buffers.
+    `buffer_shrink_threshold` : float, optional, default = 0.5
+                                Part of its allocation a buffer must use not to be
+                                shrunk.
     """
     def __init__(self, batch_size = -1, num_threads = -1, device_id = -1, seed = -1,
                  exec_pipelined=True, prefetch_queue_depth=2,
                  exec_async=True, bytes_per_sample=0,
-                 set_affinity=False, max_streams=-1):
+                 set_affinity=False, max_streams=-1, exec_op_major=False,
+                 exec_cpu_streaming=False, exec_longest_first=False,
+                 enable_statistics=False, buffer_growth_factor=1.0,
+                 buffer_alignment=1, buffer_shrink_after=0,
+                 buffer_shrink_threshold=0.5):
         self._batch_size = batch_size
         self._num_threads = num_threads
         self._device_id = device_id
@@ -83,6 +126,14 @@ class Pipeline(object):
         self._bytes_per_sample = bytes_per_sample
         self._set_affinity = set_affinity
         self._max_streams = max_streams
+        self._exec_op_major = exec_op_major
+        self._exec_cpu_streaming = exec_cpu_streaming
+        self._exec_longest_first = exec_longest_first
+        self._enable_statistics = enable_statistics
+        self._buffer_policy = (buffer_growth_factor, buffer_alignment,
+                               buffer_shrink_after, buffer_shrink_threshold)
+        if exec_op_major and exec_cpu_streaming:
+            raise ValueError("`exec_op_major` and `exec_cpu_streaming` cannot be both set")
 
     @property
     def batch_size(self):
@@ -99,6 +150,55 @@ class Pipeline(object):
         """Id of the GPU used by the pipeline."""
         return self._device_id
 
+    def statistics(self):
+        """Execution statistics of the pipeline, collected since it was
+        built or since the last call to `reset_statistics()`.
+
+        Returns a dictionary with the number of `iterations`, the
+        `free_queue_wait` and `ready_queue_wait` times and the list of
+        `ops`, each with its `name`, `device`, `run_time`,
+        `bytes_produced` and, for readers, `prefetch_wait`. Times are
+        dictionaries of the `count`, `total_us`, `p50_us`, `p90_us`,
+        `p99_us` and `max_us` of the measurements. Run times of CPU
+        operators are per sample, of other operators per batch.
+        `planned_peak_bytes` and `allocated_bytes` are the memory needed
+        at once by the intermediate outputs of CPU operators, that share
+        buffers when their lifetimes do not overlap, and the memory
+        allocated for these buffers. `max_sample_bytes` is the size of the
+        largest sample of each output of an operator, and of any output
+        for the pipeline: a `bytes_per_sample` of at least this size
+        allocates the buffers large enough from the start.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.GetStatistics()
+
+    def reset_statistics(self):
+        """Resets the execution statistics of the pipeline."""
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.ResetStatistics()
+
+    def memory_report(self):
+        """Returns the memory held by the pipeline, as a list of
+        dictionaries ordered by `tag`, one for each operator, named
+        after it, and for the buffers of the executor. `host_bytes` and
+        `gpu_bytes` are the bytes allocated now, `host_peak_bytes` and
+        `gpu_peak_bytes` the most allocated at once since the pipeline
+        was built or since the last call to `reset_memory_peaks`.
+        The buffers an operator creates, e.g. its scratch buffers or
+        the samples read ahead by a reader, count towards the operator.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.GetMemoryReport()
+
+    def reset_memory_peaks(self):
+        """Sets the peaks of the memory report to the current usage."""
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.ResetMemoryPeaks()
+
     def epoch_size(self, name = None):
         """Epoch size of a pipeline.
 
@@ -130,6 +230,7 @@ class Pipeline(object):
                                 self._bytes_per_sample,
                                 self._set_affinity,
                                 self._max_streams)
+        self._set_cpu_execution_mode()
         outputs = self.define_graph()
         if (not isinstance(outputs, tuple) and
             not isinstance(outputs, list)):
@@ -317,6 +418,7 @@ class Pipeline(object):
                                 self._bytes_per_sample,
                                 self._set_affinity,
                                 self._max_streams)
+        self._set_cpu_execution_mode()
         self._prepared = True
         self._pipe.Build()
         self._built = True
@@ -333,6 +435,20 @@ class Pipeline(object):
             raise RuntimeError("Pipeline must be built first.")
         self._pipe.SaveGraphToDotFile(filename)
 
+    def _set_cpu_execution_mode(self):
+        if self._exec_op_major:
+            self._pipe.SetCPUExecutionMode(types.CPUExecutionMode.OPERATOR_MAJOR)
+        elif self._exec_cpu_streaming:
+            self._pipe.SetCPUExecutionMode(types.CPUExecutionMode.STREAMING)
+        else:
+            self._pipe.SetCPUExecutionMode(types.CPUExecutionMode.SAMPLE_MAJOR)
+        if self._exec_longest_first:
+            self._pipe.SetCPUSchedulingPolicy(types.CPUSchedulingPolicy.LONGEST_FIRST)
+        else:
+            self._pipe.SetCPUSchedulingPolicy(types.CPUSchedulingPolicy.IN_ORDER)
+        self._pipe.EnableStatistics(self._enable_statistics)
+        self._pipe.SetBufferPolicy(*self._buffer_policy)
+
     def define_graph(self):
         """This function is defined by the user to construct the
         graph of operations for their pipeline.
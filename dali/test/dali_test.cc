@@ -17,10 +17,12 @@
 #include "dali/pipeline/data/allocator.h"
 #include "dali/pipeline/init.h"
 #include "dali/pipeline/operators/op_spec.h"
+#include "dali/test/dali_test.h"
 
 int main(int argc, char **argv) {
+  // Pinned memory needs a GPU, CPU-only runs use plain host memory
   dali::DALIInit(dali::OpSpec("CPUAllocator"),
-      dali::OpSpec("PinnedCPUAllocator"),
+      dali::OpSpec(dali::TestCPUOnly() ? "CPUAllocator" : "PinnedCPUAllocator"),
       dali::OpSpec("GPUAllocator"));
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
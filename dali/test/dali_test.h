@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <opencv2/opencv.hpp>
 
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <random>
@@ -35,6 +36,13 @@ namespace dali {
 // Note: this is setup for the binary to be executed from "build"
 const string image_folder = "/data/dali/test/test_images";  // NOLINT
 
+// Tests of cpu ops run CPU-only pipelines, on machines
+// without a GPU, when DALI_TEST_CPU_ONLY is set
+inline bool TestCPUOnly() {
+  const char *env = std::getenv("DALI_TEST_CPU_ONLY");
+  return env != nullptr && string(env) != "0";
+}
+
 struct DimPair { int h = 0, w = 0; };
 
 // Some useful test 'types'
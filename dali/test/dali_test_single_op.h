@@ -416,7 +416,7 @@ class DALISingleOpTest : public DALITest {
 
   template <typename T>
   int CheckBuffers(int lenRaster, const T *img1, const T *img2, bool checkAll,
-                   double *pMean = nullptr, const vector<Index> *shape = nullptr) const {
+                   double *pMean = nullptr, const TensorShape *shape = nullptr) const {
 #ifdef PIXEL_STAT_FILE
     static int imgNumb;
     FILE *file = strlen(PIXEL_STAT_FILE)? fopen(PIXEL_STAT_FILE".txt", imgNumb? "a" : "w") : NULL;
@@ -610,7 +610,7 @@ class DALISingleOpTest : public DALITest {
   }
 
   void ReportTestFailure(double mean, int colorIdx, int idx = -1,
-                         const vector<Index> *pShape = nullptr) const {
+                         const TensorShape *pShape = nullptr) const {
     if (TestCheckType(t_checkNoAssert))
       cout << "\nTest warning:";
     else
@@ -652,8 +652,8 @@ class DALISingleOpTest : public DALITest {
       const bool checkBestMatch = TestCheckType(t_checkBestMatch);
       // The the results are checked for each element separately
       for (int i = 0; i < t1->ntensor(); ++i) {
-        const auto shape1 = t1->tensor_shape(i);
-        const auto shape2 = t2->tensor_shape(i);
+        const auto &shape1 = t1->tensor_shape(i);
+        const auto &shape2 = t2->tensor_shape(i);
         ASSERT_EQ(shape1.size(), 3);
         ASSERT_EQ(shape2.size(), 3);
         for (auto j = shape1.size(); j--;) {
@@ -701,7 +701,8 @@ class DALISingleOpTest : public DALITest {
 
   void InitPipeline() {
     if (!pipeline_.get()) {
-      pipeline_.reset(new Pipeline(batch_size_, num_threads_, 0));
+      pipeline_.reset(new Pipeline(batch_size_, num_threads_,
+          TestCPUOnly() ? CPU_ONLY_DEVICE_ID : 0));
     }
   }
   vector<std::pair<string, TensorList<CPUBackend>*>> inputs_;
@@ -17,14 +17,19 @@
 
 #include "dali/util/file.h"
 #include "dali/util/local_file.h"
+#include "dali/util/mmaped_file.h"
 
 namespace dali {
 
-FileStream * FileStream::Open(const std::string& uri) {
+FileStream * FileStream::Open(const std::string& uri, bool use_mmap) {
+  std::string path = uri;
   if (uri.find("file://") == 0) {
-    return new LocalFileStream(uri.substr(std::string("file://").size()));
+    path = uri.substr(std::string("file://").size());
+  }
+  if (use_mmap) {
+    return new MmapedFileStream(path);
   } else {
-    return new LocalFileStream(uri);
+    return new LocalFileStream(path);
   }
 }
 }  // namespace dali
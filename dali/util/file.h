@@ -16,6 +16,7 @@
 #define DALI_UTIL_FILE_H_
 
 #include <cstdio>
+#include <memory>
 #include <string>
 
 #include "dali/api_helper.h"
@@ -25,10 +26,24 @@ namespace dali {
 
 class DLL_PUBLIC FileStream {
  public:
-  static FileStream * Open(const std::string& uri);
+  /**
+   * @brief Opens the file at `uri`. With `use_mmap`, the file is
+   * memory mapped, so that Get() can return its contents without
+   * copying them.
+   */
+  static FileStream * Open(const std::string& uri, bool use_mmap = false);
 
   virtual void Close() = 0;
   virtual size_t Read(uint8_t * buffer, size_t n_bytes) = 0;
+  /**
+   * @brief Returns the next `n_bytes` bytes of the file and moves past
+   * them, without copying them. The returned pointer keeps the data
+   * valid, even after the stream is closed. Returns nullptr, and does
+   * not move, if the stream cannot do it or fewer bytes are left.
+   */
+  virtual shared_ptr<void> Get(size_t n_bytes) {
+    return nullptr;
+  }
   virtual void Seek(int64 pos) = 0;
   virtual size_t Size() const = 0;
   virtual ~FileStream() {}
@@ -0,0 +1,92 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "dali/util/mmaped_file.h"
+#include "dali/error_handling.h"
+
+namespace dali {
+
+MmapedFileStream::MmapedFileStream(const std::string& path) :
+  FileStream(path), length_(0), pos_(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  DALI_ENFORCE(fd >= 0, "Could not open file " + path + ": " + std::strerror(errno));
+  struct stat sb;
+  if (fstat(fd, &sb) == -1) {
+    const int err = errno;
+    close(fd);
+    DALI_FAIL("Unable to stat file " + path + ": " + std::strerror(err));
+  }
+  length_ = sb.st_size;
+
+  // Empty files cannot be mapped, and have nothing to share
+  if (length_ > 0) {
+    void *p = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int err = errno;
+    close(fd);
+    DALI_ENFORCE(p != MAP_FAILED, "Could not map file " + path + ": " + std::strerror(err));
+    const size_t length = length_;
+    p_.reset(p, [length](void *ptr) { munmap(ptr, length); });
+  } else {
+    close(fd);
+  }
+}
+
+void MmapedFileStream::Close() {
+  // Unmapped once the data returned by Get() is no longer in use
+  p_.reset();
+  length_ = 0;
+  pos_ = 0;
+}
+
+void MmapedFileStream::Seek(int64 pos) {
+  DALI_ENFORCE(pos >= 0 && static_cast<size_t>(pos) <= length_,
+      "Seek operation did not succeed: position " + std::to_string(pos) +
+      " is out of the bounds of " + path_);
+  pos_ = pos;
+}
+
+size_t MmapedFileStream::Read(uint8_t * buffer, size_t n_bytes) {
+  n_bytes = std::min(n_bytes, length_ - pos_);
+  if (n_bytes > 0) {
+    std::memcpy(buffer, static_cast<uint8_t*>(p_.get()) + pos_, n_bytes);
+  }
+  pos_ += n_bytes;
+  return n_bytes;
+}
+
+shared_ptr<void> MmapedFileStream::Get(size_t n_bytes) {
+  if (p_ == nullptr || n_bytes > length_ - pos_) {
+    return nullptr;
+  }
+  // Shares the ownership of the whole mapping
+  shared_ptr<void> p(p_, static_cast<uint8_t*>(p_.get()) + pos_);
+  pos_ += n_bytes;
+  return p;
+}
+
+size_t MmapedFileStream::Size() const {
+  return length_;
+}
+
+}  // namespace dali
@@ -0,0 +1,165 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/util/tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "dali/error_handling.h"
+
+namespace dali {
+
+const int Tracer::kEventsPerThread;
+std::atomic<bool> Tracer::enabled_{false};
+
+// Returns the buffer of the thread to the tracer when the thread exits
+struct ThreadBufferHolder {
+  ~ThreadBufferHolder() {
+    if (buffer != nullptr) {
+      Tracer::Get().ReleaseThreadBuffer(buffer);
+    }
+  }
+
+  Tracer::ThreadBuffer *buffer = nullptr;
+};
+
+Tracer &Tracer::Get() {
+  // Never destroyed, threads may still record during the exit
+  static Tracer *tracer = new Tracer;
+  return *tracer;
+}
+
+int64_t Tracer::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &buffer : buffers_) {
+    buffer->first.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+  enabled_ = true;
+}
+
+void Tracer::Stop() {
+  enabled_ = false;
+}
+
+const char *Tracer::Intern(const std::string &name) {
+  std::lock_guard<std::mutex> lock(names_mutex_);
+  auto it = name_index_.find(name);
+  if (it != name_index_.end()) {
+    return it->second;
+  }
+  // Elements of a deque are not moved when it grows
+  names_.push_back(name);
+  const char *interned = names_.back().c_str();
+  name_index_[name] = interned;
+  return interned;
+}
+
+void Tracer::Record(const char *name, int64_t begin_ns, int64_t end_ns, int64_t arg) {
+  ThreadBuffer *buffer = GetThreadBuffer();
+  const int64_t head = buffer->head.load(std::memory_order_relaxed);
+  Event &event = buffer->events[head % kEventsPerThread];
+  event.name = name;
+  event.begin_ns = begin_ns;
+  event.end_ns = end_ns;
+  event.arg = arg;
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+Tracer::ThreadBuffer *Tracer::GetThreadBuffer() {
+  thread_local ThreadBufferHolder holder;
+  if (holder.buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_buffers_.empty()) {
+      holder.buffer = free_buffers_.back();
+      free_buffers_.pop_back();
+    } else {
+      buffers_.emplace_back(new ThreadBuffer(buffers_.size()));
+      holder.buffer = buffers_.back().get();
+    }
+  }
+  return holder.buffer;
+}
+
+void Tracer::ReleaseThreadBuffer(ThreadBuffer *buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_buffers_.push_back(buffer);
+}
+
+namespace {
+
+void WriteJSONString(std::ostream &os, const char *str) {
+  os << '"';
+  for (; *str; ++str) {
+    const char c = *str;
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      os << escaped;
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+}  // namespace
+
+std::string Tracer::ChromeTraceJSON() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream os;
+  os.precision(3);
+  os << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first_event = true;
+  for (auto &buffer : buffers_) {
+    const int64_t head = buffer->head.load(std::memory_order_acquire);
+    const int64_t first = std::max(buffer->first.load(std::memory_order_relaxed),
+                                   head - kEventsPerThread);
+    for (int64_t i = first; i < head; ++i) {
+      const Event &event = buffer->events[i % kEventsPerThread];
+      if (!first_event) os << ',';
+      first_event = false;
+      os << "\n{\"name\":";
+      WriteJSONString(os, event.name);
+      os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->tid
+         << ",\"ts\":" << event.begin_ns / 1000.
+         << ",\"dur\":" << (event.end_ns - event.begin_ns) / 1000.;
+      if (event.arg >= 0) {
+        os << ",\"args\":{\"idx\":" << event.arg << '}';
+      }
+      os << '}';
+    }
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
+void Tracer::DumpChromeTrace(const std::string &path) const {
+  std::ofstream file(path);
+  DALI_ENFORCE(file.good(), "Could not open the trace file " + path);
+  file << ChromeTraceJSON();
+  DALI_ENFORCE(file.good(), "Could not write the trace file " + path);
+}
+
+}  // namespace dali
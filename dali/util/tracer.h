@@ -0,0 +1,125 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_TRACER_H_
+#define DALI_UTIL_TRACER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dali/api_helper.h"
+
+namespace dali {
+
+/**
+ * @brief Records the time ranges of the TimeRanges into per-thread
+ * ring buffers and exports them as a Chrome Trace Event JSON, that can
+ * be opened in chrome://tracing or Perfetto.
+ *
+ * Tracing is disabled by default, in which case TimeRange checks a
+ * single flag. Recording an event is lock-free: every thread writes
+ * to its own ring buffer, that keeps the last kEventsPerThread events.
+ */
+class DLL_PUBLIC Tracer {
+ public:
+  static const int kEventsPerThread = 1 << 16;
+
+  DLL_PUBLIC static Tracer &Get();
+
+  DLL_PUBLIC static inline bool Enabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  DLL_PUBLIC static int64_t NowNs();
+
+  /**
+   * @brief Starts recording, dropping the events recorded so far.
+   */
+  DLL_PUBLIC void Start();
+
+  DLL_PUBLIC void Stop();
+
+  /**
+   * @brief Returns a copy of `name` that stays valid for the lifetime
+   * of the process, the same pointer for equal names. Names of ranges
+   * built at runtime are interned once and then passed to TimeRange as
+   * is, so that they are not allocated on every range.
+   */
+  DLL_PUBLIC const char *Intern(const std::string &name);
+
+  /**
+   * @brief Records a range of the calling thread. `name` must be
+   * a string literal or returned by Intern(). `arg` is exported
+   * as an argument of the event when not negative.
+   */
+  DLL_PUBLIC void Record(const char *name, int64_t begin_ns, int64_t end_ns,
+                         int64_t arg = -1);
+
+  /**
+   * @brief Returns the recorded events in the Chrome Trace Event format.
+   * Should be called after Stop(), events recorded concurrently
+   * may be missing.
+   */
+  DLL_PUBLIC std::string ChromeTraceJSON() const;
+
+  DLL_PUBLIC void DumpChromeTrace(const std::string &path) const;
+
+ private:
+  struct Event {
+    const char *name;
+    int64_t begin_ns, end_ns;
+    int64_t arg;
+  };
+
+  struct ThreadBuffer {
+    explicit ThreadBuffer(int tid) : tid(tid), events(new Event[kEventsPerThread]) {}
+
+    const int tid;
+    std::unique_ptr<Event[]> events;
+    // Number of events written so far, only the last
+    // kEventsPerThread of them are kept
+    std::atomic<int64_t> head{0};
+    // Events before `first` were recorded before the last Start()
+    std::atomic<int64_t> first{0};
+  };
+
+  Tracer() = default;
+
+  ThreadBuffer *GetThreadBuffer();
+  void ReleaseThreadBuffer(ThreadBuffer *buffer);
+
+  static std::atomic<bool> enabled_;
+
+  mutable std::mutex mutex_;
+  // Buffers are never freed, the buffers of the threads
+  // that exited are reused by the new ones
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  std::vector<ThreadBuffer*> free_buffers_;
+
+  std::mutex names_mutex_;
+  std::deque<std::string> names_;
+  std::unordered_map<std::string, const char*> name_index_;
+
+  friend struct ThreadBufferHolder;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_TRACER_H_
@@ -0,0 +1,106 @@
+// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dali/common.h"
+#include "dali/util/tracer.h"
+
+namespace dali {
+
+namespace {
+
+int CountOccurrences(const std::string &str, const std::string &pattern) {
+  int count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(TracerTest, Intern) {
+  const char *name = Tracer::Get().Intern("[TracerTest] op");
+  ASSERT_STREQ(name, "[TracerTest] op");
+  ASSERT_EQ(name, Tracer::Get().Intern(std::string("[TracerTest] ") + "op"));
+  ASSERT_NE(name, Tracer::Get().Intern("[TracerTest] other op"));
+}
+
+TEST(TracerTest, DisabledByDefault) {
+  ASSERT_FALSE(Tracer::Enabled());
+  {
+    TimeRange tr("[TracerTest] disabled");
+  }
+  Tracer::Get().Start();
+  Tracer::Get().Stop();
+  ASSERT_EQ(Tracer::Get().ChromeTraceJSON().find("[TracerTest] disabled"), std::string::npos);
+}
+
+TEST(TracerTest, ChromeTrace) {
+  const char *op_name = Tracer::Get().Intern("[TracerTest] \"quoted\" op");
+  Tracer::Get().Start();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([op_name] {
+        TimeRange tr("[TracerTest] thread");
+        for (int i = 0; i < 10; ++i) {
+          TimeRange tr(op_name, TimeRange::kBlue1, i);
+        }
+      });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  {
+    TimeRange tr(std::string("[TracerTest] ") + "dynamic");
+  }
+  Tracer::Get().Stop();
+  {
+    TimeRange tr("[TracerTest] after stop");
+  }
+
+  std::string json = Tracer::Get().ChromeTraceJSON();
+  ASSERT_EQ(json.find("{\"displayTimeUnit\""), 0u);
+  ASSERT_EQ(CountOccurrences(json, "\"[TracerTest] thread\""), 3);
+  ASSERT_EQ(CountOccurrences(json, "\"[TracerTest] \\\"quoted\\\" op\""), 30);
+  ASSERT_EQ(CountOccurrences(json, "\"args\":{\"idx\":9}"), 3);
+  ASSERT_EQ(CountOccurrences(json, "\"[TracerTest] dynamic\""), 1);
+  ASSERT_EQ(CountOccurrences(json, "after stop"), 0);
+
+  // Restarting drops the previous events
+  Tracer::Get().Start();
+  Tracer::Get().Stop();
+  ASSERT_EQ(CountOccurrences(Tracer::Get().ChromeTraceJSON(), "\"ph\""), 0);
+}
+
+TEST(TracerTest, RingBufferKeepsLastEvents) {
+  Tracer::Get().Start();
+  const int n = Tracer::kEventsPerThread + 10;
+  for (int i = 0; i < n; ++i) {
+    TimeRange tr("[TracerTest] ring", TimeRange::kBlue, i);
+  }
+  Tracer::Get().Stop();
+  std::string json = Tracer::Get().ChromeTraceJSON();
+  ASSERT_EQ(CountOccurrences(json, "\"[TracerTest] ring\""), Tracer::kEventsPerThread);
+  ASSERT_EQ(CountOccurrences(json, "\"idx\":9}"), 0);
+  ASSERT_EQ(CountOccurrences(json, "\"idx\":" + std::to_string(n - 1) + "}"), 1);
+}
+
+}  // namespace dali